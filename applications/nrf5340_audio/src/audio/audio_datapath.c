@@ -26,6 +26,7 @@
 #include "audio_system.h"
 #include "streamctrl.h"
 #include "sd_card_playback.h"
+#include "drift_resampler.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(audio_datapath, CONFIG_AUDIO_DATAPATH_LOG_LEVEL);
@@ -81,6 +82,8 @@ LOG_MODULE_REGISTER(audio_datapath, CONFIG_AUDIO_DATAPATH_LOG_LEVEL);
 #define DRIFT_ERR_THRESH_UNLOCK	   32
 /* To get smaller corrections */
 #define DRIFT_REGULATOR_DIV_FACTOR 2
+/* Drift in parts per million from the error over one measurement period */
+#define DRIFT_PPM(err_us)	   ((err_us) * (1000000 / DRIFT_MEAS_PERIOD_US))
 
 /* To allow BLE transmission and (host -> HCI -> controller) */
 #define JUST_IN_TIME_TARGET_DLY_US 3000
@@ -140,6 +143,15 @@ static struct {
 		uint32_t prod_blk_ts[FIFO_NUM_BLKS];
 		/* Statistics */
 		uint32_t total_blk_underruns;
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+		struct drift_resampler resampler;
+		/* Resampled audio, frames not making up a full block are kept between frames */
+		drift_resampler_sample_t resampled
+			[(DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_MONO_NUM_SAMPS * NUM_BLKS_IN_FRAME) +
+			  BLK_MONO_NUM_SAMPS) *
+			 2];
+		uint32_t resampled_frames;
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
 	} out;
 
 	uint32_t prev_drift_sdu_ref_us;
@@ -152,6 +164,13 @@ static struct {
 		uint32_t meas_start_time_us;
 		uint32_t center_freq;
 		bool enabled;
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+		/* Last drift measurement, applied to the resampler by the datapath thread */
+		int32_t drift_ppm;
+		atomic_t drift_ppm_new;
+		/* Presentation delay above the wanted delay */
+		int32_t level_err_us;
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
 	} drift_comp;
 
 	struct {
@@ -344,6 +363,74 @@ static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
 	}
 }
 
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+/**
+ * @brief	Measure drift for the software resampler.
+ *
+ * @note	HFCLKAUDIO is not adjusted, so the drift is measured the same way as in
+ *		DRIFT_STATE_CALIB for every period. DRIFT_STATE_OFFSET is not used, since the I2S
+ *		frame start can not be moved without adjusting the clock.
+ */
+static void audio_datapath_drift_compensation_resampler(void)
+{
+	if (CONFIG_AUDIO_DEV == HEADSET) {
+		ctrl_blk.prev_drift_sdu_ref_us = ctrl_blk.prev_pres_sdu_ref_us;
+	}
+
+	switch (ctrl_blk.drift_comp.state) {
+	case DRIFT_STATE_INIT: {
+		/* Check if audio data has been received */
+		if (ctrl_blk.prev_drift_sdu_ref_us) {
+			ctrl_blk.drift_comp.meas_start_time_us = ctrl_blk.prev_drift_sdu_ref_us;
+
+			drift_comp_state_set(DRIFT_STATE_CALIB);
+		}
+
+		break;
+	}
+	case DRIFT_STATE_CALIB:
+		/* Fall through */
+	case DRIFT_STATE_LOCKED: {
+		if (++ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
+			/* Waiting */
+			return;
+		}
+
+		ctrl_blk.drift_comp.ctr = 0;
+
+		int32_t err_us = DRIFT_MEAS_PERIOD_US - (ctrl_blk.prev_drift_sdu_ref_us -
+							 ctrl_blk.drift_comp.meas_start_time_us);
+		int32_t drift_ppm = DRIFT_PPM(err_us);
+
+		ctrl_blk.drift_comp.meas_start_time_us = ctrl_blk.prev_drift_sdu_ref_us;
+
+		if ((drift_ppm > DRIFT_RESAMPLER_RATIO_MAX_PPM) ||
+		    (drift_ppm < -DRIFT_RESAMPLER_RATIO_MAX_PPM)) {
+			LOG_DBG("Invalid drift measurement: %d ppm", drift_ppm);
+
+			if (ctrl_blk.drift_comp.state == DRIFT_STATE_CALIB) {
+				drift_comp_state_set(DRIFT_STATE_INIT);
+			}
+
+			return;
+		}
+
+		ctrl_blk.drift_comp.drift_ppm = drift_ppm;
+		atomic_set(&ctrl_blk.drift_comp.drift_ppm_new, true);
+
+		if (ctrl_blk.drift_comp.state == DRIFT_STATE_CALIB) {
+			drift_comp_state_set(DRIFT_STATE_LOCKED);
+		}
+
+		break;
+	}
+	default: {
+		break;
+	}
+	}
+}
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
+
 static void pres_comp_state_set(enum pres_comp_state new_state)
 {
 	int ret;
@@ -394,6 +481,15 @@ static void audio_datapath_presentation_compensation(uint32_t recv_frame_ts_us,
 		ctrl_blk.pres_comp.pres_delay_us - (recv_frame_ts_us - sdu_ref_us);
 	int32_t pres_adj_us = 0;
 
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+	/* The resampler corrects the remaining error, smaller than a block, over time */
+	if (ctrl_blk.pres_comp.state == PRES_STATE_LOCKED) {
+		ctrl_blk.drift_comp.level_err_us = ctrl_blk.current_pres_dly_us - wanted_pres_dly_us;
+	} else {
+		ctrl_blk.drift_comp.level_err_us = 0;
+	}
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
+
 	switch (ctrl_blk.pres_comp.state) {
 	case PRES_STATE_INIT: {
 		ctrl_blk.pres_comp.ctr = 0;
@@ -752,7 +848,11 @@ static void audio_datapath_i2s_blk_complete(uint32_t frame_start_ts_us, uint32_t
 
 	/*** Drift compensation ***/
 	if (ctrl_blk.drift_comp.enabled) {
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+		audio_datapath_drift_compensation_resampler();
+#else
 		audio_datapath_drift_compensation(frame_start_ts_us);
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
 	}
 }
 
@@ -896,6 +996,59 @@ void audio_datapath_pres_delay_us_get(uint32_t *delay_us)
 	*delay_us = ctrl_blk.pres_comp.pres_delay_us;
 }
 
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+/**
+ * @brief	Resample a decoded frame and add the full blocks to the output FIFO.
+ *
+ * @note	Resampled frames that do not make up a full block are kept until the next
+ *		decoded frame.
+ *
+ * @param	data_rx_ts_us	Timestamp of when the frame was received.
+ */
+static void resampled_blocks_add(uint32_t data_rx_ts_us)
+{
+	drift_resampler_sample_t *resampled = ctrl_blk.out.resampled;
+	uint32_t kept_frames = ctrl_blk.out.resampled_frames;
+	/* The kept frames were received before this frame */
+	uint32_t kept_us = (kept_frames * 1000000) / CONFIG_AUDIO_SAMPLE_RATE_HZ;
+	uint32_t out_blk_idx = ctrl_blk.out.prod_blk_idx;
+	uint32_t num_frames;
+	uint32_t num_blks;
+
+	if (atomic_cas(&ctrl_blk.drift_comp.drift_ppm_new, true, false)) {
+		int32_t ratio_ppm = drift_resampler_update(&ctrl_blk.out.resampler,
+							   ctrl_blk.drift_comp.drift_ppm,
+							   ctrl_blk.drift_comp.level_err_us);
+
+		LOG_DBG("Resampler ratio: %d ppm", ratio_ppm);
+	}
+
+	num_frames = kept_frames +
+		     drift_resampler_process(&ctrl_blk.out.resampler, ctrl_blk.decoded_data,
+					     BLK_MONO_NUM_SAMPS * NUM_BLKS_IN_FRAME,
+					     &resampled[kept_frames * 2],
+					     (ARRAY_SIZE(ctrl_blk.out.resampled) / 2) - kept_frames);
+	num_blks = num_frames / BLK_MONO_NUM_SAMPS;
+
+	for (uint32_t i = 0; i < num_blks; i++) {
+		memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_STEREO_NUM_SAMPS],
+		       &resampled[i * BLK_STEREO_NUM_SAMPS], BLK_STEREO_SIZE_OCTETS);
+
+		/* Record producer block start reference */
+		ctrl_blk.out.prod_blk_ts[out_blk_idx] =
+			data_rx_ts_us + (i * BLK_PERIOD_US) - kept_us;
+
+		out_blk_idx = NEXT_IDX(out_blk_idx);
+	}
+
+	ctrl_blk.out.prod_blk_idx = out_blk_idx;
+
+	ctrl_blk.out.resampled_frames = num_frames - (num_blks * BLK_MONO_NUM_SAMPS);
+	memmove(resampled, &resampled[num_blks * BLK_STEREO_NUM_SAMPS],
+		ctrl_blk.out.resampled_frames * 2 * sizeof(drift_resampler_sample_t));
+}
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
+
 void audio_datapath_stream_out(struct net_buf *audio_frame)
 {
 	if (!ctrl_blk.stream_started) {
@@ -976,13 +1129,18 @@ void audio_datapath_stream_out(struct net_buf *audio_frame)
 	/*** Add audio data to FIFO buffer ***/
 	uint32_t num_blks_in_fifo = filled_blocks_get();
 
-	if ((num_blks_in_fifo + NUM_BLKS_IN_FRAME) > FIFO_NUM_BLKS) {
+	/* The resampler may output one block more than the frame holds */
+	if ((num_blks_in_fifo + NUM_BLKS_IN_FRAME +
+	     (IS_ENABLED(CONFIG_AUDIO_DRIFT_COMP_RESAMPLER) ? 1 : 0)) > FIFO_NUM_BLKS) {
 		LOG_WRN("Output audio stream overrun - Discarding audio frame");
 
 		/* Discard frame to allow consumer to catch up */
 		return;
 	}
 
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+	resampled_blocks_add(meta->data_rx_ts_us);
+#else
 	uint32_t out_blk_idx = ctrl_blk.out.prod_blk_idx;
 
 	for (uint32_t i = 0; i < NUM_BLKS_IN_FRAME; i++) {
@@ -1003,6 +1161,7 @@ void audio_datapath_stream_out(struct net_buf *audio_frame)
 	}
 
 	ctrl_blk.out.prod_blk_idx = out_blk_idx;
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
 }
 
 int audio_datapath_start(struct k_msgq *audio_q_rx)
@@ -1020,6 +1179,12 @@ int audio_datapath_start(struct k_msgq *audio_q_rx)
 		/* Clear counters and mute initial audio */
 		memset(&ctrl_blk.out, 0, sizeof(ctrl_blk.out));
 
+#if CONFIG_AUDIO_DRIFT_COMP_RESAMPLER
+		int ret = drift_resampler_init(&ctrl_blk.out.resampler, 2);
+
+		ERR_CHK(ret);
+#endif /* CONFIG_AUDIO_DRIFT_COMP_RESAMPLER */
+
 		audio_datapath_i2s_start();
 		ctrl_blk.stream_started = true;
 
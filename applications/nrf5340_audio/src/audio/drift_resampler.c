@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "drift_resampler.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#define PPM_SCALE 1000000
+
+#define POS_ONE	     BIT64(32)
+#define FRAC_BITS    16
+#define POS_INT(pos) ((uint32_t)((pos) >> 32))
+
+/* Level error in microseconds giving a 1 ppm correction */
+#define LEVEL_ERR_US_PER_PPM 10
+
+/* Weight of a new drift measurement, as 1 / DRIFT_FILTER_DIV */
+#define DRIFT_FILTER_DIV 4
+
+#if CONFIG_AUDIO_BIT_DEPTH_16
+#define SAMPLE_MIN INT16_MIN
+#define SAMPLE_MAX INT16_MAX
+#elif CONFIG_AUDIO_BIT_DEPTH_32
+#define SAMPLE_MIN INT32_MIN
+#define SAMPLE_MAX INT32_MAX
+#endif
+
+int drift_resampler_init(struct drift_resampler *rs, uint8_t channels)
+{
+	if (channels == 0 || channels > DRIFT_RESAMPLER_CHANNELS_MAX) {
+		return -EINVAL;
+	}
+
+	memset(rs, 0, sizeof(*rs));
+	rs->channels = channels;
+
+	/* The first output frame needs one history frame before it */
+	rs->pos = POS_ONE;
+	drift_resampler_ratio_set(rs, 0);
+
+	return 0;
+}
+
+void drift_resampler_ratio_set(struct drift_resampler *rs, int32_t ratio_ppm)
+{
+	rs->ratio_ppm = CLAMP(ratio_ppm, -DRIFT_RESAMPLER_RATIO_MAX_PPM,
+			      DRIFT_RESAMPLER_RATIO_MAX_PPM);
+	rs->step = (POS_ONE * PPM_SCALE) / (PPM_SCALE + rs->ratio_ppm);
+}
+
+int32_t drift_resampler_update(struct drift_resampler *rs, int32_t drift_ppm, int32_t level_err_us)
+{
+	if (rs->drift_valid) {
+		rs->drift_ppm += (drift_ppm - rs->drift_ppm) / DRIFT_FILTER_DIV;
+	} else {
+		rs->drift_ppm = drift_ppm;
+		rs->drift_valid = true;
+	}
+
+	drift_resampler_ratio_set(rs, rs->drift_ppm - (level_err_us / LEVEL_ERR_US_PER_PPM));
+
+	return rs->ratio_ppm;
+}
+
+/* Get a sample from the stream made of the history followed by the input */
+static inline int32_t sample_get(struct drift_resampler const *rs,
+				 drift_resampler_sample_t const *input, uint32_t frame,
+				 uint8_t channel)
+{
+	if (frame < DRIFT_RESAMPLER_HISTORY_FRAMES) {
+		return rs->history[frame * rs->channels + channel];
+	}
+
+	return input[(frame - DRIFT_RESAMPLER_HISTORY_FRAMES) * rs->channels + channel];
+}
+
+/* Four-point cubic Hermite interpolation between x0 and x1, t in Q16 */
+static inline int32_t hermite(int32_t xm1, int32_t x0, int32_t x1, int32_t x2, int64_t t)
+{
+	/* Coefficients are doubled to keep them integer */
+	int64_t c1 = (int64_t)x1 - xm1;
+	int64_t c2 = 2 * (int64_t)xm1 - 5 * (int64_t)x0 + 4 * (int64_t)x1 - x2;
+	int64_t c3 = ((int64_t)x2 - xm1) + 3 * ((int64_t)x0 - x1);
+	int64_t res;
+
+	res = ((c3 * t) >> FRAC_BITS) + c2;
+	res = ((res * t) >> FRAC_BITS) + c1;
+	res = (res * t) >> FRAC_BITS;
+	res = x0 + (res >> 1);
+
+	return CLAMP(res, SAMPLE_MIN, SAMPLE_MAX);
+}
+
+size_t drift_resampler_process(struct drift_resampler *rs,
+			       drift_resampler_sample_t const *input, size_t frames_in,
+			       drift_resampler_sample_t *output, size_t frames_out_max)
+{
+	size_t frames_out = 0;
+	size_t frames_total = DRIFT_RESAMPLER_HISTORY_FRAMES + frames_in;
+	size_t frames_kept;
+	uint32_t frame;
+	int64_t t;
+
+	while (frames_out < frames_out_max) {
+		frame = POS_INT(rs->pos);
+
+		/* Two frames after the current one are needed */
+		if ((frame + 2) >= frames_total) {
+			break;
+		}
+
+		t = (rs->pos >> (32 - FRAC_BITS)) & BIT_MASK(FRAC_BITS);
+
+		for (uint8_t ch = 0; ch < rs->channels; ch++) {
+			*output++ = hermite(sample_get(rs, input, frame - 1, ch),
+					    sample_get(rs, input, frame, ch),
+					    sample_get(rs, input, frame + 1, ch),
+					    sample_get(rs, input, frame + 2, ch), t);
+		}
+
+		frames_out++;
+		rs->pos += rs->step;
+	}
+
+	/* Move the position to the new history. If the output was too small, the remaining
+	 * input frames are dropped.
+	 */
+	if (rs->pos < ((uint64_t)frames_in << 32) + POS_ONE) {
+		rs->pos = ((uint64_t)frames_in << 32) + POS_ONE;
+	}
+
+	rs->pos -= (uint64_t)frames_in << 32;
+
+	/* Keep the last frames of the stream as history */
+	frames_kept = DRIFT_RESAMPLER_HISTORY_FRAMES - MIN(frames_in, DRIFT_RESAMPLER_HISTORY_FRAMES);
+
+	memmove(rs->history,
+		&rs->history[(DRIFT_RESAMPLER_HISTORY_FRAMES - frames_kept) * rs->channels],
+		frames_kept * rs->channels * sizeof(drift_resampler_sample_t));
+	memcpy(&rs->history[frames_kept * rs->channels],
+	       &input[(frames_in - (DRIFT_RESAMPLER_HISTORY_FRAMES - frames_kept)) * rs->channels],
+	       (DRIFT_RESAMPLER_HISTORY_FRAMES - frames_kept) * rs->channels *
+		       sizeof(drift_resampler_sample_t));
+
+	return frames_out;
+}
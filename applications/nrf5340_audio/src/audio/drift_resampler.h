@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _DRIFT_RESAMPLER_H_
+#define _DRIFT_RESAMPLER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Maximum number of interleaved channels */
+#define DRIFT_RESAMPLER_CHANNELS_MAX 2
+
+/* Number of previous input frames kept for the interpolation */
+#define DRIFT_RESAMPLER_HISTORY_FRAMES 3
+
+/* Maximum ratio adjustment in parts per million */
+#define DRIFT_RESAMPLER_RATIO_MAX_PPM 1000
+
+/* Maximum number of output frames for a given number of input frames */
+#define DRIFT_RESAMPLER_FRAMES_OUT_MAX(frames_in)                                                  \
+	((frames_in) + (((frames_in) * DRIFT_RESAMPLER_RATIO_MAX_PPM) / 1000000) + 2)
+
+#if CONFIG_AUDIO_BIT_DEPTH_16
+typedef int16_t drift_resampler_sample_t;
+#elif CONFIG_AUDIO_BIT_DEPTH_32
+typedef int32_t drift_resampler_sample_t;
+#endif
+
+struct drift_resampler {
+	/* Position of the next output frame in input frames, relative to the first history frame.
+	 * Q32.32 format.
+	 */
+	uint64_t pos;
+	/* Input frames per output frame. Q32.32 format. */
+	uint64_t step;
+	/* Filtered drift measurement. */
+	int32_t drift_ppm;
+	bool drift_valid;
+	/* Current ratio adjustment, the output has ratio_ppm more frames than the input. */
+	int32_t ratio_ppm;
+	uint8_t channels;
+	drift_resampler_sample_t
+		history[DRIFT_RESAMPLER_HISTORY_FRAMES * DRIFT_RESAMPLER_CHANNELS_MAX];
+};
+
+/**
+ * @brief	Initialize the drift resampler.
+ *
+ * @note	The resampler starts with a ratio of 1 and one frame of silence.
+ *
+ * @param	rs		Pointer to the resampler.
+ * @param	channels	Number of interleaved channels.
+ *
+ * @return	0 if successful, -EINVAL if the number of channels is not supported.
+ */
+int drift_resampler_init(struct drift_resampler *rs, uint8_t channels);
+
+/**
+ * @brief	Set the ratio between output and input frames.
+ *
+ * @param	rs		Pointer to the resampler.
+ * @param	ratio_ppm	Output frames in excess of the input frames, in parts per million.
+ *				Clamped to +/- DRIFT_RESAMPLER_RATIO_MAX_PPM.
+ */
+void drift_resampler_ratio_set(struct drift_resampler *rs, int32_t ratio_ppm);
+
+/**
+ * @brief	Update the ratio from a drift measurement and the buffer level.
+ *
+ * @note	The drift measurements are low-pass filtered. The level error adds a small
+ *		proportional correction, so that the buffer level slowly returns to the target
+ *		without dropping or inserting samples.
+ *
+ * @param	rs		Pointer to the resampler.
+ * @param	drift_ppm	Measured rate of the consumer relative to the producer, in parts
+ *				per million. Positive if the consumer is faster.
+ * @param	level_err_us	Buffered audio above the target, in microseconds.
+ *
+ * @return	The new ratio in parts per million.
+ */
+int32_t drift_resampler_update(struct drift_resampler *rs, int32_t drift_ppm, int32_t level_err_us);
+
+/**
+ * @brief	Resample a block of interleaved frames.
+ *
+ * @note	The output must be able to hold DRIFT_RESAMPLER_FRAMES_OUT_MAX(frames_in) frames.
+ *		If it is smaller, input frames that do not fit are dropped.
+ *
+ * @param	rs		Pointer to the resampler.
+ * @param	input		Pointer to the input frames.
+ * @param	frames_in	Number of input frames.
+ * @param	output		Pointer to the output frames.
+ * @param	frames_out_max	Number of frames the output can hold.
+ *
+ * @return	Number of output frames written.
+ */
+size_t drift_resampler_process(struct drift_resampler *rs,
+			       drift_resampler_sample_t const *input, size_t frames_in,
+			       drift_resampler_sample_t *output, size_t frames_out_max);
+
+#endif /* _DRIFT_RESAMPLER_H_ */
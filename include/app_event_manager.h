@@ -55,6 +55,11 @@ enum app_event_type_flags {
 	 */
 	APP_EVENT_TYPE_FLAGS_INIT_LOG_ENABLE =
 		APP_EVENT_TYPE_FLAGS_USER_SETTABLE_START,
+	/** dispatches events of the type ahead of other events.
+	 *  Flag set by user. Requires @kconfig{CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE},
+	 *  ignored otherwise.
+	 */
+	APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY,
 	/** shows number of predefined flags.*/
 	APP_EVENT_TYPE_FLAGS_COUNT,
 	/** marks beginning of user-specific flags.*/
@@ -197,6 +202,40 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
  */
 #define APP_EVENT_SUBMIT(event) _event_submit(&event->header)
 
+/** @brief Initialize a batch of events.
+ *
+ * @param batch  Pointer to the list used to collect events of the batch.
+ */
+static inline void app_event_manager_batch_init(sys_slist_t *batch)
+{
+	sys_slist_init(batch);
+}
+
+/** @brief Append an event to a batch of events.
+ *
+ * The event is submitted with the whole batch when
+ * @ref app_event_manager_submit_batch is called.
+ *
+ * @param batch  Pointer to the list used to collect events of the batch.
+ * @param event  Pointer to the event object.
+ */
+#define APP_EVENT_BATCH_APPEND(batch, event) sys_slist_append((batch), &(event)->header.node)
+
+/** @brief Submit a batch of events.
+ *
+ * All events of the batch are added to the event queue under a single lock acquisition
+ * and event processing is triggered once. The order of events within the batch is
+ * preserved. The submit hooks are called for every event of the batch.
+ *
+ * @note
+ * If event submit hooks or high priority events are enabled, the batch is traversed
+ * under the lock, so interrupts are locked for a time proportional to the batch size.
+ *
+ * @param batch  Pointer to the list of events created with @ref APP_EVENT_BATCH_APPEND.
+ *               The list is empty after the function returns.
+ */
+void app_event_manager_submit_batch(sys_slist_t *batch);
+
 /**
  * @brief Register event hook after the Application Event Manager is initialized.
  *
@@ -383,7 +422,8 @@ int app_event_manager_init(void);
 /** @brief Allocate event.
  *
  * The behavior of this function depends on the actual implementation.
- * The default implementation of this function is same as k_malloc.
+ * The default implementation of this function is same as k_malloc, unless
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_MEM_SLAB} is enabled.
  * It is annotated as weak and can be overridden by user.
  *
  * @param size  Amount of memory requested (in bytes).
@@ -395,7 +435,8 @@ void *app_event_manager_alloc(size_t size);
 /** @brief Free memory occupied by the event.
  *
  * The behavior of this function depends on the actual implementation.
- * The default implementation of this function is same as k_free.
+ * The default implementation of this function is same as k_free, unless
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_MEM_SLAB} is enabled.
  * It is annotated as weak and can be overridden by user.
  *
  * @param addr  Pointer to previously allocated memory.
@@ -403,6 +444,61 @@ void *app_event_manager_alloc(size_t size);
 void app_event_manager_free(void *addr);
 
 
+/** @brief Statistics of an event memory slab size class. */
+struct app_event_manager_mem_slab_stats {
+	/** Size of a single block in bytes. */
+	size_t block_size;
+
+	/** Number of blocks in the memory slab. */
+	uint32_t block_cnt;
+
+	/** Number of blocks currently in use. */
+	uint32_t used;
+
+	/** Maximum number of blocks used at the same time. */
+	uint32_t max_used;
+
+	/** Number of allocations that did not fit in the memory slab. */
+	uint32_t alloc_fail_cnt;
+};
+
+/** @brief Get statistics of an event memory slab size class.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_MEM_SLAB} option needs to be enabled.
+ *
+ * @param idx    Index of the size class. Size classes are sorted by block size.
+ * @param stats  Pointer to the structure to be filled with statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If there is no size class with the given index.
+ */
+int app_event_manager_mem_slab_stats_get(size_t idx,
+					 struct app_event_manager_mem_slab_stats *stats);
+
+
+/** @brief Get statistics of an event listener.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_LISTENER_STATS} option needs to be enabled.
+ *
+ * @param el     Pointer to the event listener.
+ * @param stats  Pointer to the structure to be filled with statistics.
+ */
+void app_event_manager_listener_stats_get(const struct event_listener *el,
+					  struct event_listener_stats *stats);
+
+/** @brief Reset statistics of all event listeners.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_LISTENER_STATS} option needs to be enabled.
+ */
+void app_event_manager_listener_stats_reset(void);
+
+
 /** @brief Log event.
  *
  * This helper macro simplifies event logging.
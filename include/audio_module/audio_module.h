@@ -314,8 +314,10 @@ struct audio_module_handle {
 	/* Number of destination modules. */
 	uint8_t dest_count;
 
-	/* Semaphore to count messages between modules and on a module's TX FIFO. */
-	struct k_sem sem;
+	/* Number of references to each audio data buffer taken from the data slab, indexed by
+	 * the block number. A buffer is shared by all receivers and freed with the last reference.
+	 */
+	atomic_t data_ref_cnt[CONFIG_AUDIO_MODULE_DATA_BUFFERS_MAX];
 
 	/* Mutex to make the above destinations list thread safe. */
 	struct k_mutex dest_mutex;
@@ -476,6 +478,35 @@ int audio_module_data_tx(struct audio_module_handle *handle,
 int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *audio_data,
 			 k_timeout_t timeout);
 
+/**
+ * @brief Retrieve an audio data item from an audio module without copying the audio data.
+ *
+ * @note The returned audio data is shared read-only with all other receivers of the sending
+ *       module. It remains valid, and the module's TX FIFO item remains taken, until
+ *       audio_module_data_rx_release() is called.
+ *
+ * @param handle      [in/out]  The handle to the module instance.
+ * @param audio_data  [out]     Pointer to be set to the shared audio data from the module.
+ * @param timeout     [in]      Non-negative waiting period to wait for operation to complete
+ *                              (in milliseconds). Use K_NO_WAIT to return without waiting,
+ *                              or K_FOREVER to wait as long as necessary.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_data_rx_shared(struct audio_module_handle *handle,
+				struct audio_data const **audio_data, k_timeout_t timeout);
+
+/**
+ * @brief Release an audio data item retrieved with audio_module_data_rx_shared().
+ *
+ * @param handle      [in/out]  The handle to the module instance.
+ * @param audio_data  [in]      Pointer to the shared audio data to release.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_data_rx_release(struct audio_module_handle *handle,
+				 struct audio_data const *const audio_data);
+
 /**
  * @brief Send an audio data to an audio module and retrieve an audio data from an audio module.
  *
@@ -8,6 +8,7 @@
 #define CS_DE_H__
 
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/cs.h>
 #include <zephyr/net_buf.h>
 
 /** @file
@@ -16,6 +17,9 @@
  *  @brief API for the Channel Sounding Distance Estimation toolkit.
  */
 
+/** Number of channels that can be used for Channel Sounding steps, from channel 2 to 76. */
+#define CS_DE_NUM_CHANNELS 75
+
 /**
  * @brief Container of IQ values for local and remote measured tones
  *
@@ -24,13 +28,13 @@
  */
 typedef struct {
 	/** In-phase measurements of tones on this device */
-	float i_local[75];
+	float i_local[CS_DE_NUM_CHANNELS];
 	/** Quadrature-phase measurement of tones on this device */
-	float q_local[75];
+	float q_local[CS_DE_NUM_CHANNELS];
 	/** In-phase measurements of tones from remote device */
-	float i_remote[75];
+	float i_remote[CS_DE_NUM_CHANNELS];
 	/** Quadrature-phase measurements of tones from remote device */
-	float q_remote[75];
+	float q_remote[CS_DE_NUM_CHANNELS];
 } cs_de_iq_tones_t;
 
 typedef enum {
@@ -91,9 +95,32 @@ typedef struct {
 	uint8_t rtt_count;
 } cs_de_report_t;
 
+/**
+ * @brief Context for populating a report step by step.
+ *
+ * The IQ values are accumulated as the steps arrive, so the report is ready for
+ * @ref cs_de_stream_calc as soon as the last step of the procedure has been added.
+ * Use one context per peer to range several peers at the same time.
+ */
+typedef struct {
+	/** Report being populated. */
+	cs_de_report_t *p_report;
+
+	/** Number of IQ values accumulated per antenna path and channel. */
+	uint16_t n_iqs[CONFIG_BT_RAS_MAX_ANTENNA_PATHS][CS_DE_NUM_CHANNELS];
+
+	/** Tone quality per antenna path and channel. */
+	cs_de_tone_quality_t tone_quality[CONFIG_BT_RAS_MAX_ANTENNA_PATHS][CS_DE_NUM_CHANNELS];
+
+	/** Scratch memory for the distance calculation. */
+	float iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+} cs_de_stream_t;
+
 /**
  * @brief Partially populate the report.
  * This populates the report but does not set the distance estimates and the quality.
+ * Uses a context shared by all callers, which are serialized. Use the stream API to range
+ * several peers at the same time.
  * @param[in] local_steps Buffer to the local step data to parse.
  * @param[in] peer_steps   Buffer to the peer ranging data to parse.
  * @param[in] role Role of the local controller.
@@ -102,7 +129,56 @@ typedef struct {
 void cs_de_populate_report(struct net_buf_simple *local_steps, struct net_buf_simple *peer_steps,
 			   enum bt_conn_le_cs_role role, cs_de_report_t *p_report);
 
-/* Takes partially populated report and calculates distance estimates and quality. */
+/**
+ * @brief Start populating a report step by step.
+ * @param[out] p_stream Stream context.
+ * @param[in] role Role of the local controller.
+ * @param[in] n_ap Number of antenna paths. Updated by @ref cs_de_stream_ranging_data_add
+ *                 from the ranging header.
+ * @param[out] p_report Report to populate. Must be valid until @ref cs_de_stream_end.
+ */
+void cs_de_stream_begin(cs_de_stream_t *p_stream, enum bt_conn_le_cs_role role, uint8_t n_ap,
+			cs_de_report_t *p_report);
+
+/**
+ * @brief Add one pair of local and peer steps to the report.
+ * @param[in,out] p_stream Stream context.
+ * @param[in] local_step Step measured by the local controller.
+ * @param[in] peer_step Step measured by the peer, for the same channel and mode.
+ */
+void cs_de_stream_step_add(cs_de_stream_t *p_stream, struct bt_le_cs_subevent_step *local_step,
+			   struct bt_le_cs_subevent_step *peer_step);
+
+/**
+ * @brief Add the steps of ranging data to the report.
+ * Can be called for each ranging data received within the same procedure.
+ * @param[in,out] p_stream Stream context.
+ * @param[in] local_steps Buffer to the local step data to parse.
+ * @param[in] peer_steps Buffer to the peer ranging data to parse.
+ */
+void cs_de_stream_ranging_data_add(cs_de_stream_t *p_stream, struct net_buf_simple *local_steps,
+				   struct net_buf_simple *peer_steps);
+
+/**
+ * @brief Finish populating the report.
+ * Sets the tone quality of the report. The report can then be passed to
+ * @ref cs_de_stream_calc.
+ * @param[in,out] p_stream Stream context.
+ */
+void cs_de_stream_end(cs_de_stream_t *p_stream);
+
+/**
+ * @brief Calculate the distance estimates and quality of the report of a stream.
+ * Uses the scratch memory of the stream, so the reports of different peers can be calculated
+ * at the same time.
+ * @param[in,out] p_stream Stream context, after @ref cs_de_stream_end.
+ * @return Quality of the distance estimates.
+ */
+cs_de_quality_t cs_de_stream_calc(cs_de_stream_t *p_stream);
+
+/* Takes partially populated report and calculates distance estimates and quality.
+ * Uses scratch memory shared by all callers, which are serialized.
+ */
 cs_de_quality_t cs_de_calc(cs_de_report_t *p_report);
 
 /**
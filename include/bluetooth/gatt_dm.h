@@ -317,6 +317,20 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context);
  */
 int bt_gatt_dm_data_release(struct bt_gatt_dm *dm);
 
+#if defined(CONFIG_BT_GATT_DM_CACHE) || defined(__DOXYGEN__)
+/** @brief Delete the cached services of a peer.
+ *
+ * The cache of a peer is deleted automatically when its bond is
+ * deleted.
+ *
+ * @param[in] addr Address of the peer.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int bt_gatt_dm_cache_delete(const bt_addr_le_t *addr);
+#endif
+
 /** @brief Print service discovery data.
  *
  * This function prints GATT attributes that belong to the discovered service.
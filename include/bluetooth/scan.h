@@ -105,7 +105,7 @@ struct bt_scan_filter_info {
 	bool enabled;
 
 	/** Filter count. */
-	uint8_t cnt;
+	uint16_t cnt;
 };
 
 /**@brief Filter status structure.
@@ -508,6 +508,24 @@ int bt_scan_filter_status_get(struct bt_filter_status *status);
 int bt_scan_filter_add(enum bt_scan_filter_type type,
 		       const void *data);
 
+/**@brief Function for removing a filter from the scanning.
+ *
+ * @details This function removes a filter previously added with
+ *          @ref bt_scan_filter_add. Only address and UUID filters
+ *          can be removed individually. Filters can be removed
+ *          while scanning.
+ *
+ * @param[in] type Filter type.
+ * @param[in] data Pointer to the filter data to remove.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the filter is not set.
+ * @retval -ENOTSUP If filters of this type cannot be removed individually.
+ * @retval -EINVAL If the arguments are invalid.
+ */
+int bt_scan_filter_remove(enum bt_scan_filter_type type,
+			  const void *data);
+
 /**@brief Function for removing all set filters.
  *
  * @details The function removes all previously set filters.
@@ -379,6 +379,8 @@ int bt_hogp_rep_write(struct bt_hogp *hogp,
  * @param data   Data to be sent.
  * @param length Data size.
  * @param func   Function to be called when operation is completed.
+ *               If NULL, the command is only queued and more than one
+ *               command can be pending for the report at a time.
  *
  * @retval 0 If the operation was successful.
  *           Otherwise, a (negative) error code is returned.
@@ -674,6 +676,22 @@ enum bt_hids_report_type bt_hogp_rep_type(const struct bt_hogp_rep_info *rep);
  */
 size_t bt_hogp_rep_size(const struct bt_hogp_rep_info *rep);
 
+#if defined(CONFIG_BT_HOGP_REP_TIMESTAMP) || defined(__DOXYGEN__)
+/**
+ * @brief Get report arrival timestamp.
+ *
+ * The timestamp is taken when the last notification or read response of the
+ * report is received, before the callback function is called. Compare it
+ * with @c k_cycle_get_32 to measure the latency of forwarding the report.
+ *
+ * @param rep Report object.
+ *
+ * @return Hardware cycle count at the arrival of the report value,
+ *         or 0 if no value has been received.
+ */
+uint32_t bt_hogp_rep_timestamp(const struct bt_hogp_rep_info *rep);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
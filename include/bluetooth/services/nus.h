@@ -79,6 +79,17 @@ struct bt_nus_cb {
 	 */
 	void (*send_enabled)(enum bt_nus_send_status status);
 
+#if defined(CONFIG_BT_NUS_TX_STREAM) || defined(__DOXYGEN__)
+	/** @brief Stream space callback.
+	 *
+	 * Space has been freed in the TX stream buffer of a connection
+	 * because its data has been queued as notifications.
+	 *
+	 * @param[in] conn  Pointer to connection object.
+	 * @param[in] space Free space in the TX stream buffer, in bytes.
+	 */
+	void (*stream_space)(struct bt_conn *conn, size_t space);
+#endif
 };
 
 /**@brief Initialize the service.
@@ -126,6 +137,37 @@ static inline uint32_t bt_nus_get_mtu(struct bt_conn *conn)
 	return bt_gatt_get_mtu(conn) - 3;
 }
 
+#if defined(CONFIG_BT_NUS_TX_STREAM) || defined(__DOXYGEN__)
+/**@brief Write data to the TX stream of a connection.
+ *
+ * @details The data is copied to the TX stream buffer of the connection
+ *          and sent in notifications that are filled up to the ATT MTU.
+ *          Up to @kconfig{CONFIG_BT_NUS_TX_STREAM_CREDITS} notifications
+ *          are queued in the Bluetooth stack at a time. If the buffer does
+ *          not have space for all the data, only the part that fits is
+ *          written. Wait for the @ref bt_nus_cb.stream_space callback
+ *          before writing the rest.
+ *
+ *          This function can be called from an interrupt context.
+ *
+ * @param[in] conn Pointer to connection object.
+ * @param[in] data Pointer to a data buffer.
+ * @param[in] len  Length of the data in the buffer.
+ *
+ * @return Number of bytes written, which can be less than @p len.
+ *         Otherwise, a negative value is returned.
+ */
+int bt_nus_stream_write(struct bt_conn *conn, const uint8_t *data, size_t len);
+
+/**@brief Get the free space in the TX stream buffer of a connection.
+ *
+ * @param[in] conn Pointer to connection object.
+ *
+ * @return Number of bytes that can be written with @ref bt_nus_stream_write.
+ */
+size_t bt_nus_stream_space_get(struct bt_conn *conn);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
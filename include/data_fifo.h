@@ -31,6 +31,29 @@ struct data_fifo_msgq {
 	size_t size;
 };
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+/* State of a data_fifo in the single-producer, single-consumer mode.
+ * The blocks of the slab buffer are used as a ring. The counters wrap at twice the number
+ * of elements and each of them is written only by the producer or only by the consumer.
+ */
+struct data_fifo_spsc {
+	/* Number of blocks taken by the producer. */
+	atomic_t alloced;
+	/* Number of blocks put into the FIFO by the producer. */
+	atomic_t locked;
+	/* Number of blocks taken from the FIFO by the consumer. */
+	atomic_t read;
+	/* Number of blocks freed by the consumer. */
+	atomic_t freed;
+	/* Bitmask of the sides waiting for the other side. */
+	atomic_t waiting;
+	/* Given by the producer when a block is put into the FIFO. */
+	struct k_sem filled_sem;
+	/* Given by the consumer when a block is freed. */
+	struct k_sem vacant_sem;
+};
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 struct data_fifo {
 	char *msgq_buffer;
 	char *slab_buffer;
@@ -39,6 +62,10 @@ struct data_fifo {
 	uint32_t elements_max;
 	size_t block_size_max;
 	bool initialized;
+#ifdef CONFIG_DATA_FIFO_SPSC
+	bool spsc;
+	struct data_fifo_spsc spsc_state;
+#endif /* CONFIG_DATA_FIFO_SPSC */
 };
 
 #define DATA_FIFO_DEFINE(name, elements_max_in, block_size_max_in)                                 \
@@ -52,6 +79,33 @@ struct data_fifo {
 				 .elements_max = elements_max_in,                                  \
 				 .initialized = false}
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+/**
+ * @brief Define a data_fifo in the single-producer, single-consumer mode.
+ *
+ * The data_fifo is used through the same API as a data_fifo defined with DATA_FIFO_DEFINE,
+ * but without locks. The following restrictions apply:
+ * - Only one context may call data_fifo_pointer_first_vacant_get() and data_fifo_block_lock(),
+ *   and only one context may call data_fifo_pointer_last_filled_get() and
+ *   data_fifo_block_free().
+ * - Blocks must be locked in the order they were taken and freed in the order they were read.
+ * - data_fifo_empty() and data_fifo_uninit() must not be called while the data_fifo is in use.
+ *
+ * With K_NO_WAIT, putting and getting blocks is wait-free and can be done from an ISR.
+ */
+#define DATA_FIFO_SPSC_DEFINE(name, elements_max_in, block_size_max_in)                            \
+	char __aligned(WB_UP(                                                                      \
+		1)) _msgq_buffer_##name[(elements_max_in) * sizeof(struct data_fifo_msgq)] = {0};  \
+	char __aligned(WB_UP(1)) _slab_buffer_##name[(elements_max_in) * (block_size_max_in)] = {  \
+		0};                                                                                \
+	struct data_fifo name = {.msgq_buffer = _msgq_buffer_##name,                               \
+				 .slab_buffer = _slab_buffer_##name,                               \
+				 .block_size_max = block_size_max_in,                              \
+				 .elements_max = elements_max_in,                                  \
+				 .initialized = false,                                             \
+				 .spsc = true}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 /**
  * @brief Get pointer to the first vacant block in slab.
  *
@@ -46,6 +46,10 @@ struct at_monitor_entry {
 		uint8_t paused : 1; /* Monitor is paused. */
 		uint8_t direct : 1; /* Dispatch in ISR. */
 	} flags;
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	/** Next monitor in the same dispatch list, set by the library. */
+	struct at_monitor_entry *next;
+#endif
 };
 
 /** Wildcard. Match any notifications. */
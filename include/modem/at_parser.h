@@ -36,6 +36,20 @@ enum at_parser_cmd_type {
 	AT_PARSER_CMD_TYPE_TEST
 };
 
+#if defined(CONFIG_AT_PARSER_TOKEN_INDEX)
+/**
+ * @brief Position of a value in the current AT command line.
+ */
+struct at_parser_token_pos {
+	/* Offset of the value from the start of the AT command line. */
+	uint16_t offset;
+	/* Length of the value. */
+	uint16_t len;
+	/* Type of the value. */
+	uint8_t type;
+};
+#endif
+
 /**
  * @brief AT parser
  *
@@ -53,6 +67,16 @@ struct at_parser {
 	bool is_next_empty;
 	/* Sentinel value for determining initialization state. */
 	uint32_t init_sentinel;
+#if defined(CONFIG_AT_PARSER_TOKEN_INDEX)
+	/* Positions of the values of the current AT command line. */
+	struct at_parser_token_pos tokens[CONFIG_AT_PARSER_TOKEN_INDEX_SIZE];
+	/* Number of values in the index. */
+	uint8_t token_count;
+	/* Indicates that the current AT command line has been indexed. */
+	bool is_indexed;
+	/* Error that ended the indexing of the current AT command line. */
+	int index_err;
+#endif
 };
 
 /**
@@ -64,6 +64,13 @@ enum location_req_mode {
 	LOCATION_REQ_MODE_FALLBACK = 0,
 	/** All requested methods are used sequentially. */
 	LOCATION_REQ_MODE_ALL,
+	/**
+	 * All requested methods are started at the same time, and the first location that meets
+	 * @ref location_config.accuracy_target is returned. The other methods are then cancelled.
+	 *
+	 * This mode requires @kconfig{CONFIG_LOCATION_REQUEST_MODE_RACE}.
+	 */
+	LOCATION_REQ_MODE_RACE,
 };
 
 /** Event IDs. */
@@ -525,6 +532,8 @@ struct location_config {
 	 * these methods are handled together, if the following conditions are met:
 	 *   - Methods are one after the other in location request method list
 	 *   - @ref mode is @ref LOCATION_REQ_MODE_FALLBACK
+	 *
+	 * If @ref mode is @ref LOCATION_REQ_MODE_RACE, Wi-Fi and cellular are always combined.
 	 */
 	struct location_method_config methods[CONFIG_LOCATION_METHODS_LIST_SIZE];
 
@@ -563,6 +572,18 @@ struct location_config {
 	 * location_config_defaults_set() function is called.
 	 */
 	enum location_req_mode mode;
+
+	/**
+	 * @brief Accuracy target (in meters) for @ref LOCATION_REQ_MODE_RACE.
+	 *
+	 * @details The first location with an accuracy equal to or better than the target
+	 * completes the location request. If no method meets the target, the most accurate
+	 * location is returned when all methods are done. Zero accepts the first location.
+	 *
+	 * Default value is 0. It is applied when location_config_defaults_set() function
+	 * is called.
+	 */
+	uint32_t accuracy_target;
 };
 
 /**
@@ -139,7 +139,35 @@ struct downloader_cfg {
 	char *buf;
 	/** Downloader buffer size. */
 	size_t buf_size;
+#if defined(CONFIG_DOWNLOADER_CHECKPOINT)
+	/**
+	 * Settings key to save the download checkpoint under, for example "dl/fota".
+	 * Set to NULL to disable checkpoints for this downloader instance.
+	 */
+	const char *checkpoint_key;
+#endif
+};
+
+#if defined(CONFIG_DOWNLOADER_CHECKPOINT)
+/**
+ * @brief Download checkpoint.
+ *
+ * Progress of a download, saved with the settings subsystem so that the download
+ * can be resumed after a reset.
+ */
+struct downloader_checkpoint {
+	/** CRC32 of the URL being downloaded. */
+	uint32_t url_crc;
+	/** Size of the file, in bytes. */
+	uint32_t file_size;
+	/** Number of bytes downloaded and accepted by the application. */
+	uint32_t progress;
+	/** Running CRC32 (IEEE) of the downloaded bytes. */
+	uint32_t crc;
+	/** Entity tag of the file, null-terminated. Empty if the server did not send one. */
+	char etag[CONFIG_DOWNLOADER_CHECKPOINT_ETAG_SIZE];
 };
+#endif
 
 /**
  * @brief Downloader host configuration options.
@@ -247,6 +275,14 @@ struct downloader {
 	const struct dl_transport *transport;
 	/** Transport parameters. */
 	uint8_t transport_internal[CONFIG_DOWNLOADER_TRANSPORT_PARAMS_SIZE];
+#if defined(CONFIG_DOWNLOADER_CHECKPOINT)
+	/** Checkpoint of the ongoing download. */
+	struct downloader_checkpoint checkpoint;
+	/** Progress when the checkpoint was last saved. */
+	size_t checkpoint_saved;
+	/** Whether the ongoing download is checkpointed. */
+	bool checkpoint_active;
+#endif
 
 	/** Ensure that thread is ready for download. */
 	struct k_sem event_sem;
@@ -365,6 +401,38 @@ int downloader_file_size_get(struct downloader *dl, size_t *size);
  */
 int downloader_downloaded_size_get(struct downloader *dl, size_t *size);
 
+#if defined(CONFIG_DOWNLOADER_CHECKPOINT)
+/**
+ * @brief Retrieve the checkpoint of an interrupted download.
+ *
+ * To resume the download, pass @c checkpoint->progress as the @c from parameter of
+ * @ref downloader_get. The bytes before that offset are not downloaded again, and
+ * @c checkpoint->crc is the CRC32 of them, which the application can use to verify the
+ * data it has stored.
+ *
+ * @param[in]  dl		Downloader instance, with a checkpoint key.
+ * @param[in]  url		URL of the file.
+ * @param[out] checkpoint	Download checkpoint.
+ *
+ * @retval 0 A checkpoint for the URL was found.
+ * @retval -ENOENT There is no checkpoint for the URL.
+ * @retval -EINVAL Invalid parameters, or no checkpoint key in the configuration.
+ */
+int downloader_checkpoint_get(struct downloader *dl, const char *url,
+			      struct downloader_checkpoint *checkpoint);
+
+/**
+ * @brief Delete the saved download checkpoint.
+ *
+ * The checkpoint is deleted automatically when the download completes.
+ *
+ * @param[in] dl Downloader instance, with a checkpoint key.
+ *
+ * @return Zero on success, a negative error code otherwise.
+ */
+int downloader_checkpoint_clear(struct downloader *dl);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
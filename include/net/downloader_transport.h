@@ -33,6 +33,23 @@
  */
 int dl_transport_evt_data(struct downloader *dl, void *data, size_t len);
 
+/**
+ * @brief Transport entity tag event callback.
+ *
+ * This function is called by the transport when the server identifies the version of the
+ * file being downloaded, for example with the HTTP ETag header.
+ * Transports without a notion of file version do not call it.
+ *
+ * @param dl Downloader instance.
+ * @param etag Entity tag, not null-terminated.
+ * @param len Length of the entity tag.
+ *
+ * @retval Zero if the download can continue.
+ * @retval -ESTALE if the file has changed since the download checkpoint was saved.
+ *         The checkpoint is deleted and the download should be aborted.
+ */
+int dl_transport_evt_etag(struct downloader *dl, const char *etag, size_t len);
+
 /**
  * Downloader transport API
  */
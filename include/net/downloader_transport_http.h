@@ -24,6 +24,10 @@
 struct downloader_transport_http_cfg {
 	/** Socket receive timeout in milliseconds */
 	uint32_t sock_recv_timeo_ms;
+	/** Maximum number of range requests sent before their responses are received.
+	 *  Zero to use @kconfig{CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH}.
+	 */
+	uint8_t pipeline_depth;
 };
 
 /**
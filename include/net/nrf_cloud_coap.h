@@ -238,6 +238,27 @@ int nrf_cloud_coap_message_send(const char *app_id, const char *message, bool js
  */
 int nrf_cloud_coap_json_message_send(const char *message, bool bulk, bool confirmable);
 
+#if defined(CONFIG_NRF_CLOUD_SENSOR_BATCH) || defined(__DOXYGEN__)
+/**
+ * @brief Send a batch of sensor samples to nRF Cloud.
+ *
+ *  The batch is sent to the bulk resource as one CoAP message, with the content
+ *  format matching the encoding of the batch. It is reset when sent successfully.
+ *
+ * @param[in,out] batch      Batch built with nrf_cloud_sensor_batch_add().
+ * @param[in]     confirmable Select whether to use a CON or NON CoAP transfer.
+ *
+ * @retval -EACCES Device does not have a valid nRF Cloud CoAP connection.
+ * @retval -ENODATA The batch is empty.
+ * @return 0 If successful, nonzero if failed.
+ *           Negative values are device-side errors defined in errno.h.
+ *           Positive values are cloud-side errors (CoAP result codes)
+ *           defined in zephyr/net/coap.h.
+ */
+int nrf_cloud_coap_sensor_batch_send(struct nrf_cloud_sensor_batch *const batch,
+				     bool confirmable);
+#endif
+
 /**
  * @brief Send the device location in the @ref nrf_cloud_gnss_data PVT field to nRF Cloud.
  *
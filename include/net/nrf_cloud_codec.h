@@ -809,6 +809,93 @@ int nrf_cloud_error_msg_decode(const char * const buf,
 int nrf_cloud_obj_shadow_delta_response_encode(struct nrf_cloud_obj *const delta_state_obj,
 					       bool accept);
 
+#if defined(CONFIG_NRF_CLOUD_SENSOR_BATCH) || defined(__DOXYGEN__)
+/** @brief Encoding of a sensor batch. */
+enum nrf_cloud_batch_fmt {
+	/** JSON array of device messages, for the bulk MQTT topic or CoAP resource. */
+	NRF_CLOUD_BATCH_FMT_JSON,
+	/** CBOR array of device messages, each encoded like a single CoAP device message.
+	 *  Requires CONFIG_NRF_CLOUD_COAP.
+	 */
+	NRF_CLOUD_BATCH_FMT_CBOR,
+};
+
+/** @brief Sensor samples packed into a caller-provided buffer, to be sent in one message. */
+struct nrf_cloud_sensor_batch {
+	/** Encoding of the batch. */
+	enum nrf_cloud_batch_fmt fmt;
+	/** Buffer holding the encoded samples. */
+	uint8_t *buf;
+	/** Size of the buffer. */
+	size_t size;
+	/** End of the encoded samples in the buffer. */
+	size_t len;
+	/** Number of samples in the batch. */
+	size_t count;
+};
+
+/**
+ * @brief Initialize an empty sensor batch.
+ *
+ * @param[out] batch Batch to initialize.
+ * @param[in] fmt Encoding of the batch.
+ * @param[in] buf Buffer for the encoded batch. Must be kept in scope while the batch is used.
+ * @param[in] size Size of the buffer.
+ *
+ * @retval -EINVAL Invalid parameter, or buffer too small for an empty batch.
+ * @retval -ENOTSUP The encoding is not supported in this configuration.
+ * @retval 0 Success.
+ */
+int nrf_cloud_sensor_batch_init(struct nrf_cloud_sensor_batch *const batch,
+				enum nrf_cloud_batch_fmt fmt, uint8_t *buf, size_t size);
+
+/**
+ * @brief Add a sensor sample to a batch.
+ *
+ * @details The sample is encoded into the buffer of the batch right away.
+ *          When the buffer is full, the batch is left unchanged, and it should be sent
+ *          and reset before adding the sample again.
+ *
+ * @param[in,out] batch Batch.
+ * @param[in] app_id The app ID identifying the type of data, for example "TEMP".
+ * @param[in] value Sensor value.
+ * @param[in] ts_ms Timestamp of the sample, in milliseconds since the Unix epoch.
+ *                  A timestamp is required since the samples are sent later.
+ *
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOMEM The sample does not fit into the batch.
+ * @retval 0 Success; sample added.
+ */
+int nrf_cloud_sensor_batch_add(struct nrf_cloud_sensor_batch *const batch,
+			       const char *const app_id, double value, int64_t ts_ms);
+
+/**
+ * @brief Get the encoded batch.
+ *
+ * @details The output points into the buffer of the batch, no memory is allocated.
+ *          A JSON batch is null-terminated. Samples can still be added afterwards.
+ *          To send a JSON batch using MQTT, publish it to the @ref NRF_CLOUD_TOPIC_BULK topic
+ *          with @ref nrf_cloud_send. To send a batch using CoAP, use
+ *          nrf_cloud_coap_sensor_batch_send().
+ *
+ * @param[in,out] batch Batch.
+ * @param[out] output Encoded batch.
+ *
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENODATA The batch is empty.
+ * @retval 0 Success.
+ */
+int nrf_cloud_sensor_batch_encode(struct nrf_cloud_sensor_batch *const batch,
+				  struct nrf_cloud_data *const output);
+
+/**
+ * @brief Remove all samples from a batch.
+ *
+ * @param[in,out] batch Batch.
+ */
+void nrf_cloud_sensor_batch_reset(struct nrf_cloud_sensor_batch *const batch);
+#endif /* CONFIG_NRF_CLOUD_SENSOR_BATCH */
+
 /** @} */
 
 #ifdef __cplusplus
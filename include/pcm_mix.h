@@ -32,10 +32,10 @@ enum pcm_mix_mode {
 /**
  * @brief Mixes two buffers of PCM data.
  *
- * @note Uses simple addition with hard clip protection.
+ * @note Uses saturating addition.
  * Input can be mono or stereo as long as the inputs match.
  * By selecting the mix mode, mono can also be mixed into a stereo buffer.
- * Hard coded for the signed 16-bit PCM.
+ * Hard coded for the signed 16-bit PCM, see pcm_mix_bit_depth() for other bit depths.
  *
  * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
  * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
@@ -52,6 +52,29 @@ enum pcm_mix_mode {
 int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
 	    enum pcm_mix_mode mix_mode);
 
+/**
+ * @brief Mixes two buffers of PCM data with the given bit depth.
+ *
+ * @note Uses saturating addition. On cores with the DSP extension, 16-bit samples
+ * are mixed using the dual 16-bit saturating add instructions.
+ * 24-bit samples are packed in three bytes, little-endian.
+ *
+ * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
+ * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
+ * @param pcm_b         [in]     Pointer to the PCM data buffer B.
+ * @param size_b        [in]     Size of the PCM data buffer B (in bytes).
+ * @param mix_mode      [in]     Mixing mode according to pcm_mix_mode.
+ * @param pcm_bit_depth [in]     Bit depth of PCM samples (16, 24, or 32).
+ *
+ * @retval 0            Success. Result stored in pcm_a.
+ * @retval -EINVAL      pcm_a is NULL, size_a = 0, or invalid bit depth.
+ * @retval -EPERM       Either size_b < size_a (for stereo to stereo, mono to mono)
+ *			or size_a/2 < size_b (for mono to stereo mix).
+ * @retval -ESRCH       Invalid mixing mode.
+ */
+int pcm_mix_bit_depth(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		      enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth);
+
 /**
  * @}
  */
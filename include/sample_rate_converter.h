@@ -40,7 +40,9 @@
 /** Filter types supported by the sample rate converter */
 enum sample_rate_converter_filter {
 	SAMPLE_RATE_FILTER_TEST = 1,
-	SAMPLE_RATE_FILTER_SIMPLE
+	SAMPLE_RATE_FILTER_SIMPLE,
+	/* Polyphase filter supporting arbitrary conversion ratios. */
+	SAMPLE_RATE_FILTER_POLYPHASE
 };
 
 /**
@@ -51,8 +53,7 @@ enum sample_rate_converter_filter {
 
 /**
  * To maintain filter requirements the output buffer must in some cases store six samples between
- * each block processed. The output buffer must be able to store a full block in addition to these
- * overflow samples.
+ * each block processed. The remaining output samples are written directly to the output.
  */
 #define SAMPLE_RATE_CONVERTER_OUTPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES 6
 
@@ -60,16 +61,12 @@ enum sample_rate_converter_filter {
 #define SAMPLE_RATE_CONVERTER_INPUT_BUF_SIZE                                                       \
 	(SAMPLE_RATE_CONVERTER_INPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES * sizeof(uint16_t))
 #define SAMPLE_RATE_CONVERTER_RINGBUF_SIZE                                                         \
-	((CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX +                                            \
-	  SAMPLE_RATE_CONVERTER_OUTPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES) *                           \
-	 sizeof(uint16_t))
+	(SAMPLE_RATE_CONVERTER_OUTPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES * sizeof(uint16_t))
 #elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
 #define SAMPLE_RATE_CONVERTER_INPUT_BUF_SIZE                                                       \
 	(SAMPLE_RATE_CONVERTER_INPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES * sizeof(uint32_t))
 #define SAMPLE_RATE_CONVERTER_RINGBUF_SIZE                                                         \
-	((CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX +                                            \
-	  SAMPLE_RATE_CONVERTER_OUTPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES) *                           \
-	 sizeof(uint32_t))
+	(SAMPLE_RATE_CONVERTER_OUTPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES * sizeof(uint32_t))
 #else
 #define SAMPLE_RATE_CONVERTER_INPUT_BUF_SIZE 0
 #define SAMPLE_RATE_CONVERTER_RINGBUF_SIZE   0
@@ -81,6 +78,47 @@ struct buf_ctx {
 	size_t bytes_in_buf;
 };
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+/** Number of coefficients for the polyphase filter. One extra phase is stored to interpolate
+ * between the last phase and the first phase of the next input sample.
+ */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_NUM                                                 \
+	((CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES + 1) *                                     \
+	 CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS)
+
+/** Number of input samples the polyphase filter keeps from the previous block. The new input
+ * is filtered in place.
+ */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE                                               \
+	(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS - 1)
+
+/** Context for the polyphase filter */
+struct sample_rate_converter_polyphase {
+	/* Input samples to advance per output sample. The fractional part is in units of
+	 * 1 / sample_rate_output.
+	 */
+	uint32_t step_int;
+	uint32_t step_frac;
+
+	/* Position of the next output sample relative to the first new input sample, in the
+	 * same units as the step.
+	 */
+	uint32_t pos_int;
+	uint32_t pos_frac;
+
+	uint32_t sample_rate_output;
+
+	/* Filter coefficients ordered by phase, each phase stored in reverse order. */
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	q15_t coeffs[SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_NUM];
+	q15_t history[SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE];
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	q31_t coeffs[SAMPLE_RATE_CONVERTER_POLYPHASE_COEFFS_NUM];
+	q31_t history[SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE];
+#endif
+};
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
 /** Context for the sample rate conversion */
 struct sample_rate_converter_ctx {
 	/* Input and output sample rate to be used for the conversion. */
@@ -88,7 +126,7 @@ struct sample_rate_converter_ctx {
 	uint32_t sample_rate_output;
 
 	/* The ratio for the current conversion. When the conversion is upsampling the ratio is
-	 * positive and negative when downsampling.
+	 * positive and negative when downsampling. The ratio is 0 for the polyphase filter.
 	 */
 	int conversion_ratio;
 
@@ -121,6 +159,11 @@ struct sample_rate_converter_ctx {
 #elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
 	q31_t state_buf_31[SAMPLE_RATE_CONVERTER_STATE_BUFFER_SIZE];
 #endif
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+	/* Context for the polyphase filter. */
+	struct sample_rate_converter_polyphase polyphase;
+#endif
 };
 
 /**
@@ -149,6 +192,10 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx);
  *		based on the conversion ratio, the module will buffer both input and output bytes
  *		when needed to meet this criteria.
  *
+ *		With the SAMPLE_RATE_FILTER_POLYPHASE filter, any pair of sample rates can be
+ *		used, for example 44.1 kHz and 48 kHz. The number of output samples then depends
+ *		on the position in the stream, and is reported in output_written.
+ *
  * @param[in,out]	ctx			Pointer to the sample rate conversion context.
  * @param[in]		filter			Filter type to be used for the conversion.
  * @param[in]		input			Pointer to samples to process.
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
+#include <ctype.h>
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/kernel.h>
@@ -41,6 +42,164 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
+/* Iterator over the monitors that match a notification, in the order they are defined. */
+struct monitor_iter {
+	const char *notif;
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	/* AT command name of the notification. */
+	const char *name;
+	size_t name_len;
+	/* Next monitor in the hash bucket of the command name. */
+	struct at_monitor_entry *indexed;
+	/* Next monitor that is not indexed. */
+	struct at_monitor_entry *unindexed;
+#else
+	size_t idx;
+#endif
+};
+
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+#define BUCKET_COUNT CONFIG_AT_MONITOR_FILTER_INDEX_BUCKETS
+
+/* Monitors by hash of the AT command name in their filter. */
+static struct at_monitor_entry *buckets[BUCKET_COUNT];
+/* Monitors for any notification, and monitors whose filter does not begin with a prefixed
+ * name. These keep matching the filter anywhere in the notification.
+ */
+static struct at_monitor_entry *unindexed;
+
+/* Get the AT command name at the beginning of a string, without its '+' or '%' prefix. */
+static size_t cmd_name_get(const char *str, const char **name)
+{
+	size_t len = 0;
+
+	if (*str == '+' || *str == '%') {
+		str++;
+	}
+
+	while (isalnum((unsigned char)str[len]) || str[len] == '_') {
+		len++;
+	}
+
+	*name = str;
+
+	return len;
+}
+
+/* Get the AT command name a filter is indexed by, if the filter begins with a prefixed name.
+ * Unprefixed filters like "ERROR" also match inside other notifications, like "+CME ERROR".
+ */
+static size_t filter_name_get(const char *filter, const char **name)
+{
+	if (filter == ANY || (*filter != '+' && *filter != '%')) {
+		return 0;
+	}
+
+	return cmd_name_get(filter, name);
+}
+
+/* FNV-1a */
+static struct at_monitor_entry **bucket_get(const char *name, size_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= (uint8_t)name[i];
+		hash *= 16777619U;
+	}
+
+	return &buckets[hash % BUCKET_COUNT];
+}
+
+static void monitor_index_build(void)
+{
+	size_t count;
+	size_t len;
+	const char *name;
+	struct at_monitor_entry *e;
+	struct at_monitor_entry **list;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+
+	/* Walk the monitors backwards, so that each list is in definition order. */
+	for (size_t i = count; i > 0; i--) {
+		STRUCT_SECTION_GET(at_monitor_entry, i - 1, &e);
+
+		len = filter_name_get(e->filter, &name);
+		list = len ? bucket_get(name, len) : &unindexed;
+
+		e->next = *list;
+		*list = e;
+	}
+}
+
+static void monitor_iter_init(struct monitor_iter *it, const char *notif)
+{
+	it->notif = notif;
+	it->name_len = cmd_name_get(notif, &it->name);
+	it->indexed = it->name_len ? *bucket_get(it->name, it->name_len) : NULL;
+	it->unindexed = unindexed;
+}
+
+static bool has_name_match(const struct at_monitor_entry *mon, const struct monitor_iter *it)
+{
+	const char *name;
+	size_t len;
+
+	len = filter_name_get(mon->filter, &name);
+
+	/* Buckets are shared by names with the same hash. */
+	return len == it->name_len && !memcmp(name, it->name, len) && has_match(mon, it->notif);
+}
+
+static struct at_monitor_entry *monitor_iter_next(struct monitor_iter *it)
+{
+	struct at_monitor_entry *e;
+
+	while (it->indexed || it->unindexed) {
+		/* Merge both lists, monitors are dispatched in the order they are defined. */
+		if (!it->unindexed || (it->indexed && it->indexed < it->unindexed)) {
+			e = it->indexed;
+			it->indexed = e->next;
+			if (has_name_match(e, it)) {
+				return e;
+			}
+		} else {
+			e = it->unindexed;
+			it->unindexed = e->next;
+			if (has_match(e, it->notif)) {
+				return e;
+			}
+		}
+	}
+
+	return NULL;
+}
+#else
+static void monitor_iter_init(struct monitor_iter *it, const char *notif)
+{
+	it->notif = notif;
+	it->idx = 0;
+}
+
+static struct at_monitor_entry *monitor_iter_next(struct monitor_iter *it)
+{
+	size_t count;
+	struct at_monitor_entry *e;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+
+	while (it->idx < count) {
+		STRUCT_SECTION_GET(at_monitor_entry, it->idx++, &e);
+		if (has_match(e, it->notif)) {
+			return e;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_AT_MONITOR_FILTER_INDEX */
+
 /* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
  * Keep this function public so that it can be called by tests.
  * This function is called from an ISR.
@@ -49,13 +208,16 @@ void at_monitor_dispatch(const char *notif)
 {
 	bool monitored;
 	struct at_notif_fifo *at_notif;
+	struct at_monitor_entry *e;
+	struct monitor_iter it;
 	size_t sz_needed;
 
 	__ASSERT_NO_MSG(notif != NULL);
 
 	monitored = false;
-	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-		if (!is_paused(e) && has_match(e, notif)) {
+	monitor_iter_init(&it, notif);
+	while ((e = monitor_iter_next(&it))) {
+		if (!is_paused(e)) {
 			if (is_direct(e)) {
 				LOG_DBG("Dispatching to %p (ISR)", e->handler);
 				e->handler(notif);
@@ -89,12 +251,15 @@ void at_monitor_dispatch(const char *notif)
 static void at_monitor_task(struct k_work *work)
 {
 	struct at_notif_fifo *at_notif;
+	struct at_monitor_entry *e;
+	struct monitor_iter it;
 
 	while ((at_notif = k_fifo_get(&at_monitor_fifo, K_NO_WAIT))) {
 		/* Match notification with all monitors */
 		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
-		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
+		monitor_iter_init(&it, at_notif->data);
+		while ((e = monitor_iter_next(&it))) {
+			if (!is_paused(e) && !is_direct(e)) {
 				LOG_DBG("Dispatching to %p", e->handler);
 				e->handler(at_notif->data);
 			}
@@ -107,6 +272,10 @@ static int at_monitor_sys_init(void)
 {
 	int err;
 
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	monitor_index_build();
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
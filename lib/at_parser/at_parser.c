@@ -231,11 +231,89 @@ finalize:
 	return 0;
 }
 
+#if defined(CONFIG_AT_PARSER_TOKEN_INDEX)
+/* Internal error code, the AT command line has more values than the index can hold. */
+#define INDEX_FULL -ENOBUFS
+
+static void at_parser_index_reset(struct at_parser *parser)
+{
+	parser->token_count = 0;
+	parser->is_indexed = false;
+	parser->index_err = 0;
+}
+
+/* Tokenize the current AT command line once, and record the position of each token. */
+static void at_parser_index_build(struct at_parser *parser)
+{
+	int err;
+	size_t offset;
+	struct at_token token = {0};
+	struct at_parser_token_pos *pos;
+
+	parser->cursor = parser->at;
+	parser->count = 0;
+	parser->is_next_empty = false;
+	parser->token_count = 0;
+
+	while (true) {
+		err = at_parser_tok(parser, &token);
+		if (err) {
+			break;
+		}
+
+		offset = token.start - parser->at;
+		if (parser->token_count == ARRAY_SIZE(parser->tokens) ||
+		    offset > UINT16_MAX || token.len > UINT16_MAX) {
+			err = INDEX_FULL;
+			break;
+		}
+
+		pos = &parser->tokens[parser->token_count++];
+		pos->offset = offset;
+		pos->len = token.len;
+		pos->type = token.type;
+	}
+
+	parser->index_err = err;
+	parser->is_indexed = true;
+}
+
+/* Get the token at the given index from the index.
+ * Returns -ENOENT if the token is beyond the end of the index and must be parsed.
+ */
+static int at_parser_index_get(struct at_parser *parser, size_t index, struct at_token *token)
+{
+	const struct at_parser_token_pos *pos;
+
+	if (!parser->is_indexed) {
+		at_parser_index_build(parser);
+	}
+
+	if (index >= parser->token_count) {
+		return parser->index_err == INDEX_FULL ? -ENOENT : parser->index_err;
+	}
+
+	pos = &parser->tokens[index];
+	token->start = parser->at + pos->offset;
+	token->len = pos->len;
+	token->type = pos->type;
+
+	return 0;
+}
+#endif /* CONFIG_AT_PARSER_TOKEN_INDEX */
+
 /* Seek the AT parser cursor to the given index. */
 static int at_parser_seek(struct at_parser *parser, size_t index, struct at_token *token)
 {
 	int err;
 
+#if defined(CONFIG_AT_PARSER_TOKEN_INDEX)
+	err = at_parser_index_get(parser, index, token);
+	if (err != -ENOENT) {
+		return err;
+	}
+#endif
+
 	if (!is_index_ahead(parser, index)) {
 		/* Rewind parser. */
 		parser->cursor = parser->at;
@@ -291,6 +369,10 @@ int at_parser_cmd_next(struct at_parser *parser)
 	 */
 	parser->at = parser->cursor;
 
+#if defined(CONFIG_AT_PARSER_TOKEN_INDEX)
+	at_parser_index_reset(parser);
+#endif
+
 	return 0;
 }
 
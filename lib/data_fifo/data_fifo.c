@@ -41,6 +41,210 @@ static int msgq_slab_legal_used_elements(struct data_fifo *data_fifo, uint32_t *
 	return 0;
 }
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+#define SPSC_PRODUCER_WAITING 0
+#define SPSC_CONSUMER_WAITING 1
+
+/* The counters wrap at twice the number of elements. This keeps a full ring apart from an
+ * empty one, and unlike free-running counters it works for any number of elements.
+ */
+static uint32_t spsc_cnt_next(struct data_fifo *data_fifo, uint32_t cnt)
+{
+	cnt++;
+
+	return (cnt == 2 * data_fifo->elements_max) ? 0 : cnt;
+}
+
+static uint32_t spsc_cnt_diff(struct data_fifo *data_fifo, uint32_t cnt, uint32_t cnt_prev)
+{
+	if (cnt >= cnt_prev) {
+		return cnt - cnt_prev;
+	}
+
+	return cnt + 2 * data_fifo->elements_max - cnt_prev;
+}
+
+static uint32_t spsc_idx(struct data_fifo *data_fifo, uint32_t cnt)
+{
+	return (cnt < data_fifo->elements_max) ? cnt : (cnt - data_fifo->elements_max);
+}
+
+static void *spsc_block_get(struct data_fifo *data_fifo, uint32_t cnt)
+{
+	return &data_fifo->slab_buffer[spsc_idx(data_fifo, cnt) * data_fifo->block_size_max];
+}
+
+static struct data_fifo_msgq *spsc_msg_get(struct data_fifo *data_fifo, uint32_t cnt)
+{
+	return &((struct data_fifo_msgq *)data_fifo->msgq_buffer)[spsc_idx(data_fifo, cnt)];
+}
+
+static void spsc_cnt_inc(struct data_fifo *data_fifo, atomic_t *cnt)
+{
+	/* Each counter has a single writer, so read-modify-write does not race. */
+	atomic_set(cnt, spsc_cnt_next(data_fifo, atomic_get(cnt)));
+}
+
+/** @brief Wait until the condition checked by ready() is met.
+ *
+ * The waiting side sets its waiting bit and re-checks the condition before blocking,
+ * so the other side only has to give the semaphore if the bit is set. The timeout is
+ * for the whole wait, not for each wake-up.
+ */
+static int spsc_wait(struct data_fifo *data_fifo, bool (*ready)(struct data_fifo *data_fifo),
+		     int waiting_bit, struct k_sem *sem, k_timeout_t timeout, int err_no_wait)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_timeout_t remaining;
+	int ret;
+
+	while (!ready(data_fifo)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return err_no_wait;
+		}
+
+		remaining = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		atomic_set_bit(&spsc->waiting, waiting_bit);
+
+		if (ready(data_fifo)) {
+			atomic_clear_bit(&spsc->waiting, waiting_bit);
+			break;
+		}
+
+		ret = k_sem_take(sem, remaining);
+		atomic_clear_bit(&spsc->waiting, waiting_bit);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void spsc_wake(struct data_fifo *data_fifo, int waiting_bit, struct k_sem *sem)
+{
+	if (atomic_test_bit(&data_fifo->spsc_state.waiting, waiting_bit)) {
+		k_sem_give(sem);
+	}
+}
+
+static bool spsc_vacant_ready(struct data_fifo *data_fifo)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+
+	return spsc_cnt_diff(data_fifo, atomic_get(&spsc->alloced), atomic_get(&spsc->freed)) <
+	       data_fifo->elements_max;
+}
+
+static bool spsc_filled_ready(struct data_fifo *data_fifo)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+
+	return atomic_get(&spsc->read) != atomic_get(&spsc->locked);
+}
+
+static int spsc_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
+					 k_timeout_t timeout)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+	int ret;
+
+	ret = spsc_wait(data_fifo, spsc_vacant_ready, SPSC_PRODUCER_WAITING, &spsc->vacant_sem,
+			timeout, -ENOMEM);
+	if (ret) {
+		return ret;
+	}
+
+	*data = spsc_block_get(data_fifo, atomic_get(&spsc->alloced));
+	spsc_cnt_inc(data_fifo, &spsc->alloced);
+
+	return 0;
+}
+
+static int spsc_block_lock(struct data_fifo *data_fifo, void *data, size_t size)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+	uint32_t locked = atomic_get(&spsc->locked);
+
+	if (locked == (uint32_t)atomic_get(&spsc->alloced) ||
+	    data != spsc_block_get(data_fifo, locked)) {
+		LOG_ERR("Block %p is not the oldest taken block", data);
+		return -ESPIPE;
+	}
+
+	spsc_msg_get(data_fifo, locked)->size = size;
+
+	/* Publish the block to the consumer only after its size is written. */
+	spsc_cnt_inc(data_fifo, &spsc->locked);
+	spsc_wake(data_fifo, SPSC_CONSUMER_WAITING, &spsc->filled_sem);
+
+	return 0;
+}
+
+static int spsc_pointer_last_filled_get(struct data_fifo *data_fifo, void **data, size_t *size,
+					k_timeout_t timeout)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+	uint32_t read;
+	int ret;
+
+	ret = spsc_wait(data_fifo, spsc_filled_ready, SPSC_CONSUMER_WAITING, &spsc->filled_sem,
+			timeout, -ENOMSG);
+	if (ret) {
+		return ret;
+	}
+
+	read = atomic_get(&spsc->read);
+	*data = spsc_block_get(data_fifo, read);
+	*size = spsc_msg_get(data_fifo, read)->size;
+	spsc_cnt_inc(data_fifo, &spsc->read);
+
+	return 0;
+}
+
+static void spsc_block_free(struct data_fifo *data_fifo, void *data)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+	uint32_t freed = atomic_get(&spsc->freed);
+
+	__ASSERT(freed != (uint32_t)atomic_get(&spsc->read) &&
+		 data == spsc_block_get(data_fifo, freed),
+		 "Block %p is not the oldest read block", data);
+	ARG_UNUSED(data);
+
+	spsc_cnt_inc(data_fifo, &spsc->freed);
+	spsc_wake(data_fifo, SPSC_PRODUCER_WAITING, &spsc->vacant_sem);
+}
+
+static void spsc_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num,
+			      uint32_t *locked_num)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+
+	*alloced_num =
+		spsc_cnt_diff(data_fifo, atomic_get(&spsc->alloced), atomic_get(&spsc->freed));
+	*locked_num = spsc_cnt_diff(data_fifo, atomic_get(&spsc->locked), atomic_get(&spsc->read));
+}
+
+static void spsc_init(struct data_fifo *data_fifo)
+{
+	struct data_fifo_spsc *spsc = &data_fifo->spsc_state;
+
+	atomic_set(&spsc->alloced, 0);
+	atomic_set(&spsc->locked, 0);
+	atomic_set(&spsc->read, 0);
+	atomic_set(&spsc->freed, 0);
+	atomic_set(&spsc->waiting, 0);
+	k_sem_init(&spsc->filled_sem, 0, 1);
+	k_sem_init(&spsc->vacant_sem, 0, 1);
+}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 				       k_timeout_t timeout)
 {
@@ -48,6 +252,12 @@ int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
 	__ASSERT_NO_MSG(data_fifo->initialized);
 	int ret;
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		return spsc_pointer_first_vacant_get(data_fifo, data, timeout);
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	ret = k_mem_slab_alloc(&data_fifo->mem_slab, data, timeout);
 	return ret;
 }
@@ -66,6 +276,12 @@ int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		return spsc_block_lock(data_fifo, *data, size);
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	struct data_fifo_msgq msgq_tmp;
 
 	msgq_tmp.block_ptr = *data;
@@ -91,6 +307,12 @@ int data_fifo_pointer_last_filled_get(struct data_fifo *data_fifo, void **data,
 	__ASSERT_NO_MSG(data_fifo->initialized);
 	int ret;
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		return spsc_pointer_last_filled_get(data_fifo, data, size, timeout);
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	struct data_fifo_msgq msgq_tmp;
 
 	ret = k_msgq_get(&data_fifo->msgq, &msgq_tmp, timeout);
@@ -108,6 +330,13 @@ void data_fifo_block_free(struct data_fifo *data_fifo, void *data)
 	__ASSERT_NO_MSG(data_fifo != NULL);
 	__ASSERT_NO_MSG(data_fifo->initialized);
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		spsc_block_free(data_fifo, data);
+		return;
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	k_mem_slab_free(&data_fifo->mem_slab, data);
 }
 
@@ -120,6 +349,14 @@ int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num, u
 	uint32_t msgq_num_used = UINT32_MAX;
 	uint32_t slab_blocks_num_used = UINT32_MAX;
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		/* No cross-check needed, the counters cannot get out of sync. */
+		spsc_num_used_get(data_fifo, alloced_num, locked_num);
+		return 0;
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	ret = msgq_slab_legal_used_elements(data_fifo, &msgq_num_used, &slab_blocks_num_used);
 	if (ret) {
 		return ret;
@@ -138,6 +375,13 @@ int data_fifo_empty(struct data_fifo *data_fifo)
 	void *old_data;
 	size_t size;
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		spsc_init(data_fifo);
+		return 0;
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	ret = data_fifo_num_used_get(data_fifo, &fifo_alloced_num, &fifo_locked_num);
 	if (ret) {
 		LOG_ERR("Failed to get num used in FIFO");
@@ -192,6 +436,14 @@ int data_fifo_init(struct data_fifo *data_fifo)
 	__ASSERT_NO_MSG((data_fifo->block_size_max % WB_UP(1)) == 0);
 	int ret;
 
+#ifdef CONFIG_DATA_FIFO_SPSC
+	if (data_fifo->spsc) {
+		spsc_init(data_fifo);
+		data_fifo->initialized = true;
+		return 0;
+	}
+#endif /* CONFIG_DATA_FIFO_SPSC */
+
 	k_msgq_init(&data_fifo->msgq, data_fifo->msgq_buffer, sizeof(struct data_fifo_msgq),
 		    data_fifo->elements_max);
 
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/math_extras.h>
 #include <modem/location.h>
 
 #include "location_core.h"
@@ -40,6 +41,22 @@ K_THREAD_STACK_DEFINE(location_core_stack, LOCATION_CORE_STACK_SIZE);
 /** Work queue for location library. Location methods can run their tasks in it. */
 static struct k_work_q location_core_work_q;
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+K_THREAD_STACK_DEFINE(location_core_race_stack, CONFIG_LOCATION_RACE_WORKQUEUE_STACK_SIZE);
+
+/**
+ * Work queue for the cloud location method in race mode. GNSS may block the library work queue
+ * for a long time while it waits for LTE idle mode, so the cloud location method must not share it.
+ */
+static struct k_work_q location_core_race_work_q;
+
+/** Lock protecting the race state of the location request. */
+static struct k_spinlock location_core_race_lock;
+#endif
+
+/** Location method which started the method timeout timer. */
+static enum location_method location_core_timer_method;
+
 /** Handler for periodic location requests. */
 static void location_core_periodic_work_fn(struct k_work *work);
 
@@ -64,6 +81,9 @@ static void location_core_event_cb_fn(struct k_work *work);
 /** Work item for location event callback. */
 K_WORK_DEFINE(location_event_cb_work, location_core_event_cb_fn);
 
+/** Schedule the location event callback. */
+static void location_core_event_submit(void);
+
 /** Semaphore protecting the use of location requests. */
 K_SEM_DEFINE(location_core_sem, 1, 1);
 
@@ -240,6 +260,16 @@ int location_core_init(void)
 		LOCATION_CORE_PRIORITY,
 		&cfg);
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	cfg.name = "location_race_workq";
+	k_work_queue_start(
+		&location_core_race_work_q,
+		location_core_race_stack,
+		K_THREAD_STACK_SIZEOF(location_core_race_stack),
+		LOCATION_CORE_PRIORITY,
+		&cfg);
+#endif
+
 	return 0;
 }
 
@@ -255,6 +285,12 @@ int location_core_validate_params(const struct location_config *config)
 		return -EINVAL;
 	}
 
+	if (config->mode == LOCATION_REQ_MODE_RACE &&
+	    !IS_ENABLED(CONFIG_LOCATION_REQUEST_MODE_RACE)) {
+		LOG_ERR("LOCATION_REQ_MODE_RACE requires CONFIG_LOCATION_REQUEST_MODE_RACE");
+		return -EINVAL;
+	}
+
 	for (int i = 0; i < config->methods_count; i++) {
 		if (config->methods[i].method == LOCATION_METHOD_WIFI_CELLULAR) {
 			LOG_ERR("LOCATION_METHOD_WIFI_CELLULAR cannot be given in location config");
@@ -282,6 +318,9 @@ void location_core_config_log(const struct location_config *config)
 	LOG_DBG("  Interval: %d", config->interval);
 	LOG_DBG("  Timeout: %dms", config->timeout);
 	LOG_DBG("  Mode: %d", config->mode);
+	if (config->mode == LOCATION_REQ_MODE_RACE) {
+		LOG_DBG("  Accuracy target: %dm", config->accuracy_target);
+	}
 	LOG_DBG("  List of methods:");
 
 	for (uint8_t i = 0; i < config->methods_count; i++) {
@@ -325,6 +364,144 @@ static void location_core_current_config_set(const struct location_config *confi
 	memcpy(&loc_req_info.config, config, sizeof(loc_req_info.config));
 }
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+static bool location_core_race_mode(void)
+{
+	return loc_req_info.config.mode == LOCATION_REQ_MODE_RACE;
+}
+
+/* Cancel the methods with the given indices, using the cancel or the timeout function. */
+static void location_core_race_methods_stop(uint32_t methods, bool timeout)
+{
+	const struct location_method_api *method_api;
+
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (!(methods & BIT(i))) {
+			continue;
+		}
+
+		method_api = location_method_api_get(loc_req_info.methods[i]);
+		LOG_DBG("Cancelling '%s' method", (char *)method_api->method_string);
+
+		if (timeout) {
+			(void)method_api->timeout();
+		} else {
+			(void)method_api->cancel();
+		}
+	}
+}
+
+/* Finish the location request with the best result of the race. */
+static void location_core_race_finish(void)
+{
+	loc_req_info.current_method = loc_req_info.race_result.method;
+	loc_req_info.current_event_data = loc_req_info.race_result;
+
+	location_core_event_submit();
+}
+
+static void location_core_race_result(
+	enum location_method method,
+	enum location_event_id id,
+	const struct location_data *location)
+{
+	struct location_event_data *result = &loc_req_info.race_result;
+	k_spinlock_key_t key;
+	uint32_t cancel = 0;
+	bool finished;
+	int index;
+
+	for (index = 0; index < loc_req_info.methods_count; index++) {
+		if (loc_req_info.methods[index] == method) {
+			break;
+		}
+	}
+
+	key = k_spin_lock(&location_core_race_lock);
+
+	if (index == loc_req_info.methods_count || !(loc_req_info.race_running & BIT(index))) {
+		/* Method has already finished or it was cancelled */
+		k_spin_unlock(&location_core_race_lock, key);
+		LOG_DBG("Ignoring event %d from '%s' method", id,
+			(char *)location_method_api_get(method)->method_string);
+		return;
+	}
+
+	loc_req_info.race_running &= ~BIT(index);
+
+	if (id == LOCATION_EVT_LOCATION) {
+		if (result->id != LOCATION_EVT_LOCATION ||
+		    location->accuracy < result->location.accuracy) {
+			result->id = LOCATION_EVT_LOCATION;
+			result->method = method;
+			result->location = *location;
+		}
+
+		if (loc_req_info.config.accuracy_target == 0 ||
+		    location->accuracy <= loc_req_info.config.accuracy_target) {
+			/* Accuracy target met, the other methods are no longer needed */
+			cancel = loc_req_info.race_running;
+			loc_req_info.race_running = 0;
+		}
+	} else if (result->id != LOCATION_EVT_LOCATION) {
+		result->id = id;
+		result->method = method;
+	}
+
+	finished = (loc_req_info.race_running == 0);
+
+	k_spin_unlock(&location_core_race_lock, key);
+
+	LOG_INF("Race: '%s' method %s", (char *)location_method_api_get(method)->method_string,
+		id == LOCATION_EVT_LOCATION ? "acquired location" : "failed");
+
+	location_core_race_methods_stop(cancel, false);
+
+	if (finished) {
+		location_core_race_finish();
+	}
+}
+
+static int location_core_race_start(void)
+{
+	enum location_method requested_method;
+	int err;
+
+	memset(&loc_req_info.race_result, 0, sizeof(loc_req_info.race_result));
+	loc_req_info.race_running = BIT_MASK(loc_req_info.methods_count);
+
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		requested_method = loc_req_info.methods[i];
+		LOG_DBG("Requesting location with '%s' method",
+			(char *)location_method_api_get(requested_method)->method_string);
+
+		/* Methods take their configuration from the current method on start */
+		location_core_current_event_data_init(requested_method);
+
+		err = location_method_api_get(requested_method)->location_get(&loc_req_info);
+		if (err != 0) {
+			LOG_ERR("Failed to start '%s' method, error: %d",
+				(char *)location_method_api_get(requested_method)->method_string,
+				err);
+			location_core_race_methods_stop(BIT_MASK(i), false);
+			loc_req_info.race_running = 0;
+			return err;
+		}
+
+		if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
+			struct location_event_data request_started = {
+				.id = LOCATION_EVT_STARTED,
+				.method = requested_method
+			};
+
+			location_utils_event_dispatch(&request_started);
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_LOCATION_REQUEST_MODE_RACE */
+
 static int location_core_location_get_pos(void)
 {
 	int err;
@@ -334,25 +511,39 @@ static int location_core_location_get_pos(void)
 	/* Location request starts from the first method */
 	loc_req_info.timeout_uptime = (loc_req_info.config.timeout != SYS_FOREVER_MS) ?
 		k_uptime_get() + loc_req_info.config.timeout : SYS_FOREVER_MS;
-	loc_req_info.execute_fallback = true;
 	loc_req_info.current_method_index = 0;
-	requested_method = loc_req_info.methods[loc_req_info.current_method_index];
-	LOG_DBG("Requesting location with '%s' method",
-		(char *)location_method_api_get(requested_method)->method_string);
-	location_core_current_event_data_init(requested_method);
 
-	err = location_method_api_get(requested_method)->location_get(&loc_req_info);
-	if (err != 0) {
-		return err;
-	}
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		/* All methods run at the same time, so there is nothing to fall back to */
+		loc_req_info.execute_fallback = false;
+
+		err = location_core_race_start();
+		if (err != 0) {
+			return err;
+		}
+	} else
+#endif
+	{
+		loc_req_info.execute_fallback = true;
+		requested_method = loc_req_info.methods[loc_req_info.current_method_index];
+		LOG_DBG("Requesting location with '%s' method",
+			(char *)location_method_api_get(requested_method)->method_string);
+		location_core_current_event_data_init(requested_method);
+
+		err = location_method_api_get(requested_method)->location_get(&loc_req_info);
+		if (err != 0) {
+			return err;
+		}
 
-	if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
-		struct location_event_data request_started = {
-			.id = LOCATION_EVT_STARTED,
-			.method = requested_method
-		};
+		if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
+			struct location_event_data request_started = {
+				.id = LOCATION_EVT_STARTED,
+				.method = requested_method
+			};
 
-		location_utils_event_dispatch(&request_started);
+			location_utils_event_dispatch(&request_started);
+		}
 	}
 
 	if (loc_req_info.config.timeout != SYS_FOREVER_MS &&
@@ -392,7 +583,10 @@ static void location_request_info_create(const struct location_config *config)
 	}
 
 	/* Wi-Fi and cellular are not combined if LOCATION_REQ_MODE_ALL is used */
-	if (loc_req_info.config.mode == LOCATION_REQ_MODE_FALLBACK) {
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_RACE) {
+		/* Wi-Fi and cellular share a single cloud request, so they are always combined */
+		combine_wifi_cell = (loc_req_info.cellular != NULL && loc_req_info.wifi != NULL);
+	} else if (loc_req_info.config.mode == LOCATION_REQ_MODE_FALLBACK) {
 		/* Wi-Fi and cellular are combined if they are one after the other in method list */
 		if (abs(method_wifi_index - method_cellular_index) == 1) {
 			__ASSERT_NO_MSG(loc_req_info.cellular != NULL);
@@ -461,18 +655,30 @@ int location_core_location_get(const struct location_config *config)
 	return location_core_location_get_pos();
 }
 
-void location_core_event_cb_error(void)
+void location_core_event_cb_error(enum location_method method)
 {
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		location_core_race_result(method, LOCATION_EVT_ERROR, NULL);
+		return;
+	}
+#endif
 	loc_req_info.current_event_data.id = LOCATION_EVT_ERROR;
 
-	location_core_event_cb(NULL);
+	location_core_event_submit();
 }
 
-void location_core_event_cb_timeout(void)
+void location_core_event_cb_timeout(enum location_method method)
 {
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		location_core_race_result(method, LOCATION_EVT_TIMEOUT, NULL);
+		return;
+	}
+#endif
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 
-	location_core_event_cb(NULL);
+	location_core_event_submit();
 }
 
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
@@ -547,6 +753,24 @@ void location_core_cloud_location_ext_result_set(
 		result == LOCATION_EXT_RESULT_SUCCESS ? "success" :
 		result == LOCATION_EXT_RESULT_UNKNOWN ? "unknown" : "error");
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		/* The cloud location method is the only method other than GNSS in the race */
+		for (int i = 0; i < loc_req_info.methods_count; i++) {
+			if (loc_req_info.methods[i] != LOCATION_METHOD_GNSS) {
+				location_core_race_result(
+					loc_req_info.methods[i],
+					result == LOCATION_EXT_RESULT_SUCCESS ? LOCATION_EVT_LOCATION :
+					result == LOCATION_EXT_RESULT_UNKNOWN ?
+						LOCATION_EVT_RESULT_UNKNOWN : LOCATION_EVT_ERROR,
+					location);
+				break;
+			}
+		}
+		return;
+	}
+#endif
+
 	switch (result) {
 	case LOCATION_EXT_RESULT_SUCCESS:
 		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
@@ -727,13 +951,22 @@ static void location_core_event_cb_fn(struct k_work *work)
 	}
 }
 
-void location_core_event_cb(const struct location_data *location)
+void location_core_event_cb(enum location_method method, const struct location_data *location)
 {
-	if (location) {
-		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
-		loc_req_info.current_event_data.location = *location;
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		location_core_race_result(method, LOCATION_EVT_LOCATION, location);
+		return;
 	}
+#endif
+	loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
+	loc_req_info.current_event_data.location = *location;
+
+	location_core_event_submit();
+}
 
+static void location_core_event_submit(void)
+{
 	if (k_work_busy_get(&location_event_cb_work) == 0) {
 		/* If work item is idle, schedule it */
 		k_work_submit_to_queue(
@@ -750,6 +983,16 @@ struct k_work_q *location_core_work_queue_get(void)
 	return &location_core_work_q;
 }
 
+struct k_work_q *location_core_cloud_work_queue_get(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		return &location_core_race_work_q;
+	}
+#endif
+	return &location_core_work_q;
+}
+
 static void location_core_periodic_work_fn(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -758,15 +1001,14 @@ static void location_core_periodic_work_fn(struct k_work *work)
 
 static void location_core_method_timeout_work_fn(struct k_work *work)
 {
-	enum location_method current_method =
-		loc_req_info.methods[loc_req_info.current_method_index];
+	enum location_method timer_method = location_core_timer_method;
 
 	ARG_UNUSED(work);
 
 	LOG_INF("Method specific timeout expired");
 
-	location_method_api_get(current_method)->timeout();
-	location_core_event_cb_timeout();
+	location_method_api_get(timer_method)->timeout();
+	location_core_event_cb_timeout(timer_method);
 }
 
 static void location_core_timeout_work_fn(struct k_work *work)
@@ -778,20 +1020,45 @@ static void location_core_timeout_work_fn(struct k_work *work)
 
 	LOG_INF("Timeout for entire location request expired");
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		k_spinlock_key_t key = k_spin_lock(&location_core_race_lock);
+		uint32_t running = loc_req_info.race_running;
+
+		loc_req_info.race_running = 0;
+		if (running != 0 && loc_req_info.race_result.id != LOCATION_EVT_LOCATION) {
+			/* Report the timeout for the first method that was still running */
+			loc_req_info.race_result.id = LOCATION_EVT_TIMEOUT;
+			loc_req_info.race_result.method =
+				loc_req_info.methods[u32_count_trailing_zeros(running)];
+		}
+		k_spin_unlock(&location_core_race_lock, key);
+
+		if (running != 0) {
+			/* Return the best location so far, if any */
+			location_core_race_methods_stop(running, true);
+			location_core_race_finish();
+		}
+		return;
+	}
+#endif
+
 	location_method_api_get(current_method)->timeout();
 	/* config->timeout needs to expire without fallbacks */
 
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 	loc_req_info.execute_fallback = false;
 
-	location_core_event_cb(NULL);
+	location_core_event_submit();
 }
 
-void location_core_timer_start(int32_t timeout)
+void location_core_timer_start(enum location_method method, int32_t timeout)
 {
 	if (timeout != SYS_FOREVER_MS && timeout > 0) {
 		LOG_DBG("Starting timer with timeout=%d", timeout);
 
+		location_core_timer_method = method;
+
 		/* Using different work queue that the actual methods are using.
 		 * In this case using system work queue while methods use location_core_work_q.
 		 * If timeout is handled in the same work queue as the methods use for
@@ -813,6 +1080,23 @@ int location_core_cancel(void)
 	k_work_cancel_delayable(&location_periodic_work);
 	k_work_cancel(&location_event_cb_work);
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	if (location_core_race_mode()) {
+		k_spinlock_key_t key = k_spin_lock(&location_core_race_lock);
+		uint32_t running = loc_req_info.race_running;
+
+		loc_req_info.race_running = 0;
+		k_spin_unlock(&location_core_race_lock, key);
+
+		location_core_race_methods_stop(running, false);
+		location_core_current_config_clear();
+
+		k_sem_give(&location_core_sem);
+
+		return 0;
+	}
+#endif
+
 	/* Check if location has been requested using one of the methods */
 	if (current_method != 0) {
 		LOG_DBG("Cancelling location method for '%s' method",
@@ -43,6 +43,14 @@ struct location_request_info {
 	 * This is used in cloud location method to calculate timeout for the cloud operation.
 	 */
 	int64_t timeout_uptime;
+
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	/** Bitmask of the indices to 'methods' that are still running in race mode. */
+	uint32_t race_running;
+
+	/** Best result of the methods that are done in race mode. */
+	struct location_event_data race_result;
+#endif
 };
 
 struct location_method_api {
@@ -63,9 +71,9 @@ int location_core_validate_params(const struct location_config *config);
 int location_core_location_get(const struct location_config *config);
 int location_core_cancel(void);
 
-void location_core_event_cb(const struct location_data *location);
-void location_core_event_cb_error(void);
-void location_core_event_cb_timeout(void);
+void location_core_event_cb(enum location_method method, const struct location_data *location);
+void location_core_event_cb_error(enum location_method method);
+void location_core_event_cb_timeout(enum location_method method);
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
 void location_core_event_cb_agnss_request(const struct nrf_modem_gnss_agnss_data_frame *request);
 #endif
@@ -81,7 +89,8 @@ void location_core_cloud_location_ext_result_set(
 #endif
 
 void location_core_config_log(const struct location_config *config);
-void location_core_timer_start(int32_t timeout);
+void location_core_timer_start(enum location_method method, int32_t timeout);
 struct k_work_q *location_core_work_queue_get(void);
+struct k_work_q *location_core_cloud_work_queue_get(void);
 
 #endif /* LOCATION_CORE_H */
@@ -38,6 +38,7 @@ struct method_cloud_location_start_work_args {
 	const struct location_wifi_config *wifi_config;
 	const struct location_cellular_config *cell_config;
 	int64_t locreq_timeout_uptime;
+	enum location_method method;
 };
 
 static struct method_cloud_location_start_work_args method_cloud_location_start_work;
@@ -61,6 +62,13 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 	struct lte_lc_cells_info *scan_cellular_info = NULL;
 	int err = 0;
 
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+	/* Keep the cellular scan results until the cloud request has been sent, as GNSS may
+	 * run a scan of its own for an A-GNSS request.
+	 */
+	scan_cellular_lock();
+#endif
+
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
 	k_sem_reset(&wifi_scan_ready);
 
@@ -104,6 +112,9 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 	};
 
 	location_core_event_cb_cloud_location_request(&request);
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+	scan_cellular_unlock();
+#endif
 	return;
 #else
 	struct location_data location;
@@ -146,16 +157,19 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 		location_result.latitude = location.latitude;
 		location_result.longitude = location.longitude;
 		location_result.accuracy = location.accuracy;
-		location_core_event_cb(&location_result);
+		location_core_event_cb(work_data->method, &location_result);
 	}
 
 #endif /* defined(CONFIG_LOCATION_SERVICE_EXTERNAL) */
 
 end:
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR)
+	scan_cellular_unlock();
+#endif
 	if (err == -ETIMEDOUT) {
-		location_core_event_cb_timeout();
+		location_core_event_cb_timeout(work_data->method);
 	} else if (err) {
-		location_core_event_cb_error();
+		location_core_event_cb_error(work_data->method);
 	}
 	running = false;
 }
@@ -199,8 +213,9 @@ int method_cloud_location_get(const struct location_request_info *request)
 	}
 
 	method_cloud_location_start_work.locreq_timeout_uptime = request->timeout_uptime;
+	method_cloud_location_start_work.method = request->current_method;
 	k_work_submit_to_queue(
-		location_core_work_queue_get(),
+		location_core_cloud_work_queue_get(),
 		&method_cloud_location_start_work.work_item);
 
 	running = true;
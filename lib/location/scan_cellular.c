@@ -50,6 +50,9 @@ K_WORK_DELAYABLE_DEFINE(scan_cellular_timeout_work, scan_cellular_timeout_work_f
 /** Semaphore for waiting for RRC idle mode. */
 static K_SEM_DEFINE(entered_rrc_idle, 1, 1);
 
+/* Serializes the scans and the use of their results between location methods. */
+static K_MUTEX_DEFINE(scan_cellular_mutex);
+
 /**
  * Handler for backup timeout, which ensures we won't be waiting for LTE_LC_EVT_NEIGHBOR_CELL_MEAS
  * event forever after lte_lc_neighbor_cell_measurement_cancel() in case it would never be sent.
@@ -295,6 +298,16 @@ int scan_cellular_cancel(void)
 	return 0;
 }
 
+void scan_cellular_lock(void)
+{
+	k_mutex_lock(&scan_cellular_mutex, K_FOREVER);
+}
+
+void scan_cellular_unlock(void)
+{
+	k_mutex_unlock(&scan_cellular_mutex);
+}
+
 int scan_cellular_init(void)
 {
 	lte_lc_register_handler(scan_cellular_lte_ind_handler);
@@ -51,6 +51,7 @@ static struct nrf_sock_ctx {
 	int nrf_fd; /* nRF socket descriptior. */
 	struct k_mutex *lock; /* Mutex associated with the socket. */
 	struct k_poll_signal poll; /* poll() signal. */
+	bool dgram; /* Message-based socket, datagram or raw. */
 } offload_ctx[NRF_MODEM_MAX_SOCKET_COUNT];
 
 static K_MUTEX_DEFINE(ctx_lock);
@@ -87,6 +88,7 @@ static void release_ctx(struct nrf_sock_ctx *ctx)
 
 	ctx->nrf_fd = -1;
 	ctx->lock = NULL;
+	ctx->dgram = false;
 
 	k_mutex_unlock(&ctx_lock);
 }
@@ -666,52 +668,113 @@ static ssize_t nrf9x_socket_offload_sendto(void *obj, const void *buf,
 	return retval;
 }
 
+/* Intermediate buffers for `sendmsg`, claimed without locking so that
+ * sockets sending concurrently do not wait for each other.
+ */
+static uint8_t sendmsg_buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_COUNT]
+			  [CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+static ATOMIC_DEFINE(sendmsg_buf_used, CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_COUNT);
+
+static uint8_t *sendmsg_buf_claim(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(sendmsg_buf); i++) {
+		if (!atomic_test_and_set_bit(sendmsg_buf_used, i)) {
+			return sendmsg_buf[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void sendmsg_buf_release(uint8_t *buf)
+{
+	atomic_clear_bit(sendmsg_buf_used, (buf - sendmsg_buf[0]) / sizeof(sendmsg_buf[0]));
+}
+
+static void sendmsg_gather(uint8_t *buf, const struct msghdr *msg)
+{
+	size_t len = 0;
+
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		memcpy(buf + len, msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+		len += msg->msg_iov[i].iov_len;
+	}
+}
+
+static ssize_t sendmsg_send(void *obj, const uint8_t *buf, size_t len, int flags,
+			    const struct msghdr *msg)
+{
+	ssize_t ret;
+	size_t offset = 0;
+
+	/* Send at least once, a datagram may be empty */
+	do {
+		ret = nrf9x_socket_offload_sendto(obj, buf + offset, len - offset, flags,
+						  msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+		offset += ret;
+	} while (offset < len);
+
+	return offset;
+}
+
 static ssize_t nrf9x_socket_offload_sendmsg(void *obj, const struct msghdr *msg,
 					    int flags)
 {
-	ssize_t len = 0;
+	struct nrf_sock_ctx *ctx = OBJ_TO_CTX(obj);
+	const struct iovec *iov = NULL;
+	size_t iov_count = 0;
+	size_t len = 0;
 	ssize_t ret;
 	ssize_t offset;
+	uint8_t *buf;
 	int i;
-	static K_MUTEX_DEFINE(sendmsg_lock);
-	static uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
 
 	if (msg == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Try to reduce number of `sendto` calls - copy data if they fit into
-	 * a single buffer
-	 */
-
 	for (i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+		iov = &msg->msg_iov[i];
+		iov_count++;
 		len += msg->msg_iov[i].iov_len;
 	}
 
-	if (len <= sizeof(buf)) {
-		/* Protect `buf` access with a mutex. */
-		k_mutex_lock(&sendmsg_lock, K_FOREVER);
-		len = 0;
+	/* Data in a single buffer is passed to the modem library as is */
+	if (iov_count <= 1) {
+		return sendmsg_send(obj, iov ? iov->iov_base : NULL, len, flags, msg);
+	}
 
-		for (i = 0; i < msg->msg_iovlen; i++) {
-			memcpy(buf + len, msg->msg_iov[i].iov_base,
-			       msg->msg_iov[i].iov_len);
-			len += msg->msg_iov[i].iov_len;
+	/* Try to reduce number of `sendto` calls - copy data if they fit into
+	 * an intermediate buffer
+	 */
+	if (len <= CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE) {
+		buf = sendmsg_buf_claim();
+		if (buf) {
+			sendmsg_gather(buf, msg);
+			ret = sendmsg_send(obj, buf, len, flags, msg);
+			sendmsg_buf_release(buf);
+			return ret;
 		}
+	}
 
-		offset = 0;
-		ret = 0;
-		while ((offset < len) && (ret >= 0)) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(buf + offset), (len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret > 0) {
-				offset += ret;
-			}
+	/* A datagram must be sent in a single `sendto` call */
+	if (ctx->dgram) {
+		buf = k_malloc(len);
+		if (!buf) {
+			errno = ENOMEM;
+			return -1;
 		}
 
-		k_mutex_unlock(&sendmsg_lock);
+		sendmsg_gather(buf, msg);
+		ret = sendmsg_send(obj, buf, len, flags, msg);
+		k_free(buf);
 		return ret;
 	}
 
@@ -1103,6 +1166,8 @@ static int nrf9x_socket_create(int family, int type, int proto)
 		return -1;
 	}
 
+	ctx->dgram = (type == SOCK_DGRAM || type == SOCK_RAW);
+
 	zvfs_finalize_fd(fd, ctx,
 		      (const struct fd_op_vtable *)&nrf9x_socket_fd_op_vtable);
 
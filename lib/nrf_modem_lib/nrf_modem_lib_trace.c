@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -15,6 +16,12 @@
 #include <nrf_modem_os.h>
 #include <nrf_modem_trace.h>
 #include <nrf_errno.h>
+#if CONFIG_NRF_MODEM_LIB_TRACE_QUEUE
+#include <zephyr/sys/spsc_pbuf.h>
+#endif
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS
+#include "trace_compress.h"
+#endif
 
 LOG_MODULE_REGISTER(nrf_modem_lib_trace, CONFIG_NRF_MODEM_LIB_LOG_LEVEL);
 
@@ -30,6 +37,15 @@ static bool has_space = true;
 	COND_CODE_1(CONFIG_NRF_MODEM_LIB_TRACE_THREAD_PRIO_OVERRIDE,                               \
 		    (CONFIG_NRF_MODEM_LIB_TRACE_THREAD_PRIO), (K_LOWEST_APPLICATION_THREAD_PRIO))
 
+/* With the trace queue, the thread receiving traces from the modem only copies them to the
+ * queue, and runs at a higher priority than the thread writing them to the backend, so that
+ * the trace region is released to the modem as soon as possible. It is kept preemptive, so
+ * both threads share priority 0 when the writer already runs at the highest preemptive one.
+ */
+#define TRACE_RX_THREAD_PRIORITY                                                                   \
+	((IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_QUEUE) && (TRACE_THREAD_PRIORITY > 0)) ?           \
+		 (TRACE_THREAD_PRIORITY - 1) : TRACE_THREAD_PRIORITY)
+
 static int trace_init(void);
 static int trace_deinit(void);
 
@@ -279,6 +295,243 @@ static int trace_fragment_write(struct nrf_modem_trace_data *frag)
 	return 0;
 }
 
+/* Write trace data to the backend, waiting for it to have space if needed.
+ * Returns zero, or a negative error code if tracing cannot continue.
+ */
+static int trace_data_write(struct nrf_modem_trace_data *frag)
+{
+	int err;
+
+retry:
+	err = trace_fragment_write(frag);
+	switch (err) {
+	case 0:
+		return 0;
+	case -ENOSPC:
+		nrf_modem_lib_trace_callback(NRF_MODEM_LIB_TRACE_EVT_FULL);
+		if (!trace_backend.clear) {
+			return err;
+		}
+
+		has_space = false;
+		k_sem_give(&trace_done_sem);
+		k_sem_take(&trace_clear_sem, K_FOREVER);
+		/* Try the same fragment again */
+		goto retry;
+
+	case -ENOSR:
+		if (k_sem_take(&modem_trace_level_sem, K_NO_WAIT) != 0) {
+			/** If modem trace level is off, we wait for modem
+			 *  trace level semaphore, indicating modem traces
+			 *  are enabled. This is always available unless
+			 *  nrf_modem_lib_trace_level_set() is called with
+			 *  level 0 (off).
+			 */
+			k_sem_give(&trace_done_sem);
+			k_sem_take(&modem_trace_level_sem, K_FOREVER);
+			k_sem_take(&trace_done_sem, K_FOREVER);
+		}
+
+		k_sem_give(&modem_trace_level_sem);
+
+		/* Try the same fragment again */
+		goto retry;
+
+	default:
+		/* Irrecoverable error */
+		return err;
+	}
+}
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_QUEUE
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS
+#define TRACE_QUEUE_PACKET_MAX CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS_BLOCK_SIZE
+#else
+#define TRACE_QUEUE_PACKET_MAX 2048
+#endif
+
+enum trace_queue_flags {
+	TRACE_QUEUE_FLUSH,
+};
+
+static uint8_t trace_queue_mem[CONFIG_NRF_MODEM_LIB_TRACE_QUEUE_SIZE] __aligned(4);
+static struct spsc_pbuf *trace_queue;
+static atomic_t trace_queue_pending;
+static atomic_t trace_queue_err;
+static atomic_t trace_queue_flags;
+
+K_SEM_DEFINE(trace_queue_data_sem, 0, 1);
+K_SEM_DEFINE(trace_queue_space_sem, 0, 1);
+
+/* With the queue, traces are released to the modem when they are queued. */
+static int trace_queue_processed(size_t len)
+{
+	ARG_UNUSED(len);
+
+	return 0;
+}
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS
+static uint8_t compress_in[CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS_BLOCK_SIZE];
+static size_t compress_in_len;
+static uint8_t compress_out[TRACE_COMPRESS_BOUND(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS_BLOCK_SIZE)];
+
+static int trace_compress_flush(void)
+{
+	struct nrf_modem_trace_data frag = {
+		.data = compress_out,
+	};
+
+	if (!compress_in_len) {
+		return 0;
+	}
+
+	frag.len = trace_compress(compress_in, compress_in_len, compress_out);
+	compress_in_len = 0;
+
+	return trace_data_write(&frag);
+}
+
+static int trace_queue_write(const uint8_t *data, size_t len)
+{
+	size_t n;
+	int err;
+
+	/* Compress full blocks, for a better compression ratio than per fragment */
+	while (len) {
+		n = MIN(len, sizeof(compress_in) - compress_in_len);
+		memcpy(&compress_in[compress_in_len], data, n);
+		compress_in_len += n;
+		data += n;
+		len -= n;
+
+		if (compress_in_len == sizeof(compress_in)) {
+			err = trace_compress_flush();
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	return 0;
+}
+#else
+static int trace_compress_flush(void)
+{
+	return 0;
+}
+
+static int trace_queue_write(const uint8_t *data, size_t len)
+{
+	struct nrf_modem_trace_data frag = {
+		.data = data,
+		.len = len,
+	};
+
+	/* Write straight from the queue */
+	return trace_data_write(&frag);
+}
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_COMPRESS */
+
+static int trace_queue_put(const struct nrf_modem_trace_data *frag)
+{
+	const uint8_t *data = frag->data;
+	size_t len = frag->len;
+	char *buf;
+	int alloc;
+	int err;
+
+	while (len) {
+		err = atomic_get(&trace_queue_err);
+		if (err) {
+			return err;
+		}
+
+		alloc = spsc_pbuf_alloc(trace_queue, MIN(len, TRACE_QUEUE_PACKET_MAX), &buf);
+		if (alloc <= 0) {
+			/* Queue is full, wait for the backend to catch up */
+			k_sem_take(&trace_queue_space_sem, K_FOREVER);
+			continue;
+		}
+
+		memcpy(buf, data, alloc);
+		atomic_add(&trace_queue_pending, alloc);
+		spsc_pbuf_commit(trace_queue, alloc);
+		k_sem_give(&trace_queue_data_sem);
+
+		/* The data is out of the trace region, give it back to the modem */
+		nrf_modem_trace_processed(alloc);
+
+		data += alloc;
+		len -= alloc;
+	}
+
+	return 0;
+}
+
+/* Wait for all queued traces to be written to the backend. */
+static void trace_queue_drain(void)
+{
+	atomic_set_bit(&trace_queue_flags, TRACE_QUEUE_FLUSH);
+	k_sem_give(&trace_queue_data_sem);
+
+	while (atomic_get(&trace_queue_pending) ||
+	       atomic_test_bit(&trace_queue_flags, TRACE_QUEUE_FLUSH)) {
+		k_sem_take(&trace_queue_space_sem, K_FOREVER);
+	}
+}
+
+static void trace_queue_thread_handler(void)
+{
+	char *buf;
+	uint16_t len;
+	int err;
+
+	while (true) {
+		k_sem_take(&trace_queue_data_sem, K_FOREVER);
+
+		if (trace_backend.suspend) {
+			k_work_cancel_delayable(&backend_suspend_work);
+		}
+
+		if (backend_suspended) {
+			backend_resume();
+		}
+
+		while ((len = spsc_pbuf_claim(trace_queue, &buf)) > 0) {
+			/* After an irrecoverable error, discard traces until tracing is reset */
+			if (!atomic_get(&trace_queue_err)) {
+				err = trace_queue_write((uint8_t *)buf, len);
+				if (err) {
+					atomic_set(&trace_queue_err, err);
+				}
+			}
+
+			spsc_pbuf_free(trace_queue, len);
+			atomic_sub(&trace_queue_pending, len);
+			k_sem_give(&trace_queue_space_sem);
+		}
+
+		if (atomic_test_bit(&trace_queue_flags, TRACE_QUEUE_FLUSH)) {
+			err = trace_compress_flush();
+			if (err && !atomic_get(&trace_queue_err)) {
+				atomic_set(&trace_queue_err, err);
+			}
+
+			atomic_clear_bit(&trace_queue_flags, TRACE_QUEUE_FLUSH);
+			k_sem_give(&trace_queue_space_sem);
+		}
+
+		if (trace_backend.suspend) {
+			k_work_schedule(&backend_suspend_work, BACKEND_SUSPEND_DELAY);
+		}
+	}
+}
+
+K_THREAD_DEFINE(trace_queue_thread, CONFIG_NRF_MODEM_LIB_TRACE_STACK_SIZE,
+		trace_queue_thread_handler, NULL, NULL, NULL, TRACE_THREAD_PRIORITY, 0, 0);
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_QUEUE */
+
 void trace_thread_handler(void)
 {
 	int err;
@@ -289,12 +542,13 @@ trace_reset:
 	k_sem_take(&trace_sem, K_FOREVER);
 
 	while (true) {
-		if (trace_backend.suspend) {
+		/* With the queue, the backend is suspended by the thread writing to it */
+		if (trace_backend.suspend && !IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_QUEUE)) {
 			k_work_schedule(&backend_suspend_work, BACKEND_SUSPEND_DELAY);
 		}
 
 		err = nrf_modem_trace_get(&frags, &n_frags, NRF_MODEM_OS_FOREVER);
-		if (trace_backend.suspend) {
+		if (trace_backend.suspend && !IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_QUEUE)) {
 			k_work_cancel_delayable(&backend_suspend_work);
 		}
 		switch (err) {
@@ -319,54 +573,31 @@ trace_reset:
 			goto deinit;
 		}
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_QUEUE
+		for (int i = 0; i < n_frags; i++) {
+			err = trace_queue_put(&frags[i]);
+			if (err) {
+				goto deinit;
+			}
+		}
+#else
 		if (backend_suspended) {
 			backend_resume();
 		}
 
 		for (int i = 0; i < n_frags; i++) {
-retry:
-			err = trace_fragment_write(&frags[i]);
-			switch (err) {
-			case 0:
-				break;
-			case -ENOSPC:
-				nrf_modem_lib_trace_callback(NRF_MODEM_LIB_TRACE_EVT_FULL);
-				if (!trace_backend.clear) {
-					goto deinit;
-				}
-
-				has_space = false;
-				k_sem_give(&trace_done_sem);
-				k_sem_take(&trace_clear_sem, K_FOREVER);
-				/* Try the same fragment again */
-				goto retry;
-
-			case -ENOSR:
-				if (k_sem_take(&modem_trace_level_sem, K_NO_WAIT) != 0) {
-					/** If modem trace level is off, we wait for modem
-					 *  trace level semaphore, indicating modem traces
-					 *  are enabled. This is always available unless
-					 *  nrf_modem_lib_trace_level_set() is called with
-					 *  level 0 (off).
-					 */
-					k_sem_give(&trace_done_sem);
-					k_sem_take(&modem_trace_level_sem, K_FOREVER);
-					k_sem_take(&trace_done_sem, K_FOREVER);
-				}
-
-				k_sem_give(&modem_trace_level_sem);
-
-				/* Try the same fragment again */
-				goto retry;
-
-			default:
-				/* Irrecoverable error */
+			err = trace_data_write(&frags[i]);
+			if (err) {
 				goto deinit;
 			}
 		}
+#endif
 	}
 
 deinit:
+#if CONFIG_NRF_MODEM_LIB_TRACE_QUEUE
+	trace_queue_drain();
+#endif
 	err = trace_deinit();
 	if (err) {
 		LOG_ERR("trace_deinit failed with err: %d", err);
@@ -386,7 +617,17 @@ static int trace_init(void)
 
 	k_sem_take(&trace_done_sem, K_FOREVER);
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_QUEUE
+	/* The queue is empty after a deinit, it only needs to be set up once */
+	if (!trace_queue) {
+		trace_queue = spsc_pbuf_init(trace_queue_mem, sizeof(trace_queue_mem), 0);
+	}
+	atomic_clear(&trace_queue_err);
+
+	err = trace_backend.init(trace_queue_processed);
+#else
 	err = trace_backend.init(nrf_modem_trace_processed);
+#endif
 	if (err) {
 		LOG_ERR("trace_backend: init failed with err: %d", err);
 		return err;
@@ -539,4 +780,4 @@ int nrf_modem_lib_trace_clear(void)
 }
 
 K_THREAD_DEFINE(trace_thread, CONFIG_NRF_MODEM_LIB_TRACE_STACK_SIZE, trace_thread_handler,
-	       NULL, NULL, NULL, TRACE_THREAD_PRIORITY, 0, 0);
+	       NULL, NULL, NULL, TRACE_RX_THREAD_PRIORITY, 0, 0);
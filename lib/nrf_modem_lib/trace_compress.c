@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "trace_compress.h"
+
+/* LZ4 block format constraints */
+#define MIN_MATCH	4
+#define LAST_LITERALS	5
+#define MF_LIMIT	12
+#define TOKEN_MAX	15
+
+#define HASH_BITS	10
+
+/* LZ4 frame format, with a single block per frame */
+#define FRAME_MAGIC	0x184D2204
+/* Version 1, independent blocks, no checksums and no content size */
+#define FRAME_FLG	0x60
+/* 64 KB maximum block size */
+#define FRAME_BD	0x40
+/* Second byte of the xxHash32 of FLG and BD, constant for this descriptor */
+#define FRAME_HC	0x82
+#define FRAME_HDR_SIZE	7
+
+#define BLOCK_UNCOMPRESSED BIT(31)
+
+/* Positions of the last occurrence of each hashed 4-byte sequence.
+ * Only accessed by the thread that writes traces to the backend.
+ */
+static uint16_t hash_table[BIT(HASH_BITS)];
+
+static uint32_t read32(const uint8_t *p)
+{
+	uint32_t val;
+
+	memcpy(&val, p, sizeof(val));
+	return val;
+}
+
+static uint32_t hash(uint32_t seq)
+{
+	return (seq * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static uint8_t *length_put(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+static uint8_t *sequence_put(uint8_t *op, const uint8_t *literals, size_t lit_len,
+			     uint16_t offset, size_t match_len)
+{
+	uint8_t *token = op++;
+
+	*token = MIN(lit_len, TOKEN_MAX) << 4;
+	if (lit_len >= TOKEN_MAX) {
+		op = length_put(op, lit_len - TOKEN_MAX);
+	}
+	memcpy(op, literals, lit_len);
+	op += lit_len;
+
+	if (!offset) {
+		/* Last sequence, literals only */
+		return op;
+	}
+
+	sys_put_le16(offset, op);
+	op += sizeof(offset);
+
+	match_len -= MIN_MATCH;
+	*token |= MIN(match_len, TOKEN_MAX);
+	if (match_len >= TOKEN_MAX) {
+		op = length_put(op, match_len - TOKEN_MAX);
+	}
+
+	return op;
+}
+
+static size_t lz4_block_compress(const uint8_t *src, size_t len, uint8_t *dst)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *end = src + len;
+	const uint8_t *match_limit = end - LAST_LITERALS;
+	const uint8_t *ref;
+	const uint8_t *mp;
+	uint8_t *op = dst;
+	uint32_t seq;
+	uint32_t h;
+
+	if (len <= MF_LIMIT) {
+		goto last_literals;
+	}
+
+	memset(hash_table, 0, sizeof(hash_table));
+
+	/* The first position can only be a match source */
+	ip++;
+
+	/* Matches must start at least MF_LIMIT bytes before the end of the block */
+	while (ip <= end - MF_LIMIT) {
+		seq = read32(ip);
+		h = hash(seq);
+		ref = src + hash_table[h];
+		hash_table[h] = ip - src;
+
+		if (read32(ref) != seq) {
+			ip++;
+			continue;
+		}
+
+		/* Extend the match forwards, keeping the last literals out of it */
+		mp = ip + MIN_MATCH;
+		while ((mp < match_limit) && (*mp == ref[mp - ip])) {
+			mp++;
+		}
+
+		/* and backwards, into the pending literals */
+		while ((ip > anchor) && (ref > src) && (ip[-1] == ref[-1])) {
+			ip--;
+			ref--;
+		}
+
+		op = sequence_put(op, anchor, ip - anchor, ip - ref, mp - ip);
+
+		ip = mp;
+		anchor = ip;
+	}
+
+last_literals:
+	return sequence_put(op, anchor, end - anchor, 0, 0) - dst;
+}
+
+size_t trace_compress(const uint8_t *src, size_t len, uint8_t *dst)
+{
+	uint8_t *op = dst;
+	uint8_t *block;
+	size_t block_len;
+
+	__ASSERT_NO_MSG(len <= TRACE_COMPRESS_BLOCK_MAX);
+
+	sys_put_le32(FRAME_MAGIC, op);
+	op[4] = FRAME_FLG;
+	op[5] = FRAME_BD;
+	op[6] = FRAME_HC;
+	op += FRAME_HDR_SIZE;
+
+	block = op + sizeof(uint32_t);
+	block_len = lz4_block_compress(src, len, block);
+	if (block_len >= len) {
+		memcpy(block, src, len);
+		block_len = len;
+		sys_put_le32(BLOCK_UNCOMPRESSED | block_len, op);
+	} else {
+		sys_put_le32(block_len, op);
+	}
+	op = block + block_len;
+
+	/* End mark */
+	sys_put_le32(0, op);
+	op += sizeof(uint32_t);
+
+	return op - dst;
+}
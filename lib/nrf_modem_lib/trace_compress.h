@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_COMPRESS_H__
+#define TRACE_COMPRESS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the LZ4 frame header, block size and end mark around each block. */
+#define TRACE_COMPRESS_FRAME_OVERHEAD 15
+
+/** Largest block of trace data that can be compressed at once. */
+#define TRACE_COMPRESS_BLOCK_MAX 0xFFFF
+
+/** Worst-case size of a compressed block of @p len bytes, framing included. */
+#define TRACE_COMPRESS_BOUND(len) (TRACE_COMPRESS_FRAME_OVERHEAD + (len) + ((len) / 255) + 16)
+
+/**
+ * @brief Compress a block of trace data.
+ *
+ * The output is a complete LZ4 frame holding a single block, so that the stored trace,
+ * a sequence of such frames, can be decompressed with the standard lz4 tool.
+ * When compression does not reduce the size, the block is stored uncompressed.
+ *
+ * @param src Trace data.
+ * @param len Length of the trace data, at most @ref TRACE_COMPRESS_BLOCK_MAX.
+ * @param dst Output buffer, at least @ref TRACE_COMPRESS_BOUND bytes.
+ *
+ * @return Number of bytes written to @p dst.
+ */
+size_t trace_compress(const uint8_t *src, size_t len, uint8_t *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_COMPRESS_H__ */
@@ -7,129 +7,213 @@
 #include <pcm_mix.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#if defined(__ARM_FEATURE_DSP)
+#include <cmsis_core.h>
+#endif /* defined(__ARM_FEATURE_DSP) */
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
-/* Clip signal if amplitude is outside legal range */
-static void hard_limiter(int32_t *const pcm)
+#define INT24_MAX ((1 << 23) - 1)
+#define INT24_MIN (-(1 << 23))
+
+/* Describes where the samples of buffer B are added into buffer A.
+ * Sample i of B is added to the samples a_step * i + a_offset + r of A,
+ * for r in [0, b_repeat).
+ */
+struct mix_layout {
+	uint8_t a_step;
+	uint8_t a_offset;
+	uint8_t b_repeat;
+};
+
+static const struct mix_layout layouts[] = {
+	[B_STEREO_INTO_A_STEREO] = {.a_step = 1, .a_offset = 0, .b_repeat = 1},
+	[B_MONO_INTO_A_MONO] = {.a_step = 1, .a_offset = 0, .b_repeat = 1},
+	[B_MONO_INTO_A_STEREO_LR] = {.a_step = 2, .a_offset = 0, .b_repeat = 2},
+	[B_MONO_INTO_A_STEREO_L] = {.a_step = 2, .a_offset = 0, .b_repeat = 1},
+	[B_MONO_INTO_A_STEREO_R] = {.a_step = 2, .a_offset = 1, .b_repeat = 1},
+};
+
+static inline int32_t sample_24_get(uint8_t const *const pcm)
 {
-	if (*pcm < INT16_MIN) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MIN;
-	} else if (*pcm > INT16_MAX) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MAX;
-	}
+	/* Assemble in the upper 24 bits, then sign extend */
+	return (int32_t)(((uint32_t)pcm[0] << 8) | ((uint32_t)pcm[1] << 16) |
+			 ((uint32_t)pcm[2] << 24)) >>
+	       8;
 }
 
-/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
-static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
-			      size_t size_b)
+static inline void sample_24_set(uint8_t *const pcm, int32_t val)
 {
-	int32_t res;
+	pcm[0] = (uint8_t)val;
+	pcm[1] = (uint8_t)(val >> 8);
+	pcm[2] = (uint8_t)(val >> 16);
+}
+
+static inline int16_t sat_add_16(int16_t a, int16_t b)
+{
+	int32_t res = (int32_t)a + b;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
+	return (int16_t)CLAMP(res, INT16_MIN, INT16_MAX);
+}
 
-		hard_limiter(&res);
+static inline int32_t sat_add_32(int32_t a, int32_t b)
+{
+#if defined(__ARM_FEATURE_DSP)
+	return __QADD(a, b);
+#else
+	int64_t res = (int64_t)a + b;
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
-	}
+	return (int32_t)CLAMP(res, INT32_MIN, INT32_MAX);
+#endif /* defined(__ARM_FEATURE_DSP) */
 }
 
-/* Mix mono into both channels of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
-					    void const *const pcm_b, size_t size_b)
+#if defined(__ARM_FEATURE_DSP)
+/* Mix 16-bit samples using the dual 16-bit saturating add.
+ * The buffers are only guaranteed to be 2-byte aligned, hence the unaligned accesses.
+ */
+static void pcm_mix_16(int16_t *const pcm_a, int16_t const *const pcm_b, size_t b_num,
+		       struct mix_layout const *const layout)
 {
-	int32_t res;
+	uint32_t *a_word;
+	uint32_t b_word;
+	size_t i = 0;
+
+	if (layout->a_step == 1) {
+		/* Equal layouts, two samples per instruction */
+		for (; (i + 1) < b_num; i += 2) {
+			a_word = (uint32_t *)&pcm_a[i];
+			b_word = UNALIGNED_GET((uint32_t *)&pcm_b[i]);
+			UNALIGNED_PUT(__QADD16(UNALIGNED_GET(a_word), b_word), a_word);
+		}
 
-	/* Use size_b as this is the length of the mono sample.
-	 * This must be *2 to traverse the stereo sample and /2 since
-	 * the sample is two bytes in size.
+		if (i < b_num) {
+			pcm_a[i] = sat_add_16(pcm_a[i], pcm_b[i]);
+		}
+
+		return;
+	}
+
+	/* Mono into stereo, one stereo frame per instruction. The halfword of
+	 * the channel that is not mixed into is zero, so it is left unchanged.
 	 */
-	for (uint32_t i = 0; i < size_b; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i / 2];
+	for (; i < b_num; i++) {
+		b_word = (uint16_t)pcm_b[i];
 
-		hard_limiter(&res);
+		if (layout->b_repeat == 2) {
+			b_word |= b_word << 16;
+		} else if (layout->a_offset == 1) {
+			b_word <<= 16;
+		}
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+		a_word = (uint32_t *)&pcm_a[i * 2];
+		UNALIGNED_PUT(__QADD16(UNALIGNED_GET(a_word), b_word), a_word);
 	}
 }
+#else
+static void pcm_mix_16(int16_t *const pcm_a, int16_t const *const pcm_b, size_t b_num,
+		       struct mix_layout const *const layout)
+{
+	int16_t *a = &pcm_a[layout->a_offset];
 
-/* Mix mono into left channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+	for (size_t i = 0; i < b_num; i++) {
+		for (uint8_t r = 0; r < layout->b_repeat; r++) {
+			a[r] = sat_add_16(a[r], pcm_b[i]);
+		}
+
+		a += layout->a_step;
+	}
+}
+#endif /* defined(__ARM_FEATURE_DSP) */
+
+/* Mix packed 24-bit samples */
+static void pcm_mix_24(uint8_t *const pcm_a, uint8_t const *const pcm_b, size_t b_num,
+		       struct mix_layout const *const layout)
 {
+	uint8_t *a = &pcm_a[layout->a_offset * 3];
+	int32_t b;
 	int32_t res;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
+	for (size_t i = 0; i < b_num; i++) {
+		b = sample_24_get(&pcm_b[i * 3]);
 
-		hard_limiter(&res);
+		for (uint8_t r = 0; r < layout->b_repeat; r++) {
+			res = sample_24_get(&a[r * 3]) + b;
+			sample_24_set(&a[r * 3], CLAMP(res, INT24_MIN, INT24_MAX));
+		}
 
-		((int16_t *)pcm_a)[i * 2] = (int16_t)res;
+		a += layout->a_step * 3;
 	}
 }
 
-/* Mix mono into right channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+static void pcm_mix_32(int32_t *const pcm_a, int32_t const *const pcm_b, size_t b_num,
+		       struct mix_layout const *const layout)
 {
-	int32_t res;
+	int32_t *a = &pcm_a[layout->a_offset];
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
-
-		hard_limiter(&res);
+	for (size_t i = 0; i < b_num; i++) {
+		for (uint8_t r = 0; r < layout->b_repeat; r++) {
+			a[r] = sat_add_32(a[r], pcm_b[i]);
+		}
 
-		((int16_t *)pcm_a)[i * 2 + 1] = (int16_t)res;
+		a += layout->a_step;
 	}
 }
 
-int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
-	    enum pcm_mix_mode mix_mode)
+int pcm_mix_bit_depth(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+		      enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth)
 {
+	struct mix_layout const *layout;
+	size_t bytes_per_sample = pcm_bit_depth / 8;
+	size_t b_num;
+
 	if (pcm_a == NULL || size_a == 0) {
 		return -EINVAL;
 	}
 
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
 	if (pcm_b == NULL || size_b == 0) {
 		/* Nothing to mix, returning */
 		return 0;
 	}
 
-	switch (mix_mode) {
-	case B_STEREO_INTO_A_STEREO:
-		/* Fall through */
-	case B_MONO_INTO_A_MONO:
-		if (size_b > size_a) {
-			return -EPERM;
-		}
-		pcm_mix_identical(pcm_a, size_a, pcm_b, size_b);
-		break;
-	case B_MONO_INTO_A_STEREO_LR:
-		if (size_b > (size_a / 2)) {
-			return -EPERM;
-		}
-		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, size_a, pcm_b, size_b);
+	if (mix_mode >= ARRAY_SIZE(layouts)) {
+		return -ESRCH;
+	}
+
+	layout = &layouts[mix_mode];
+
+	if (size_b > (size_a / layout->a_step)) {
+		LOG_ERR("size a %zu size b %zu", size_a, size_b);
+		return -EPERM;
+	}
+
+	b_num = size_b / bytes_per_sample;
+
+	switch (pcm_bit_depth) {
+	case 16:
+		pcm_mix_16(pcm_a, pcm_b, b_num, layout);
 		break;
-	case B_MONO_INTO_A_STEREO_L:
-		pcm_mix_b_mono_into_a_stereo_l(pcm_a, size_a, pcm_b, size_b);
-		if (size_b > (size_a / 2)) {
-			LOG_ERR("size a %d size b %d", size_a, size_b);
-			return -EPERM;
-		}
+	case 24:
+		pcm_mix_24(pcm_a, pcm_b, b_num, layout);
 		break;
-	case B_MONO_INTO_A_STEREO_R:
-		pcm_mix_b_mono_into_a_stereo_r(pcm_a, size_a, pcm_b, size_b);
-		if (size_b > (size_a / 2)) {
-			return -EPERM;
-		}
+	case 32:
+		pcm_mix_32(pcm_a, pcm_b, b_num, layout);
 		break;
-	default:
-		return -ESRCH;
-	};
+	}
 
 	return 0;
 }
+
+int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+	    enum pcm_mix_mode mix_mode)
+{
+	return pcm_mix_bit_depth(pcm_a, size_a, pcm_b, size_b, mix_mode, 16);
+}
@@ -6,33 +6,18 @@
 
 #include "sample_rate_converter.h"
 #include "sample_rate_converter_filter.h"
+#include "sample_rate_converter_polyphase.h"
 
 #include <errno.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(sample_rate_converter, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
 
-/**
- * The input buffer must be able to store two samples in addition to the block size to meet
- * filter requirements.
- */
-#define INTERNAL_INPUT_BUF_NUMBER_SAMPLES                                                          \
-	(CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX +                                             \
-	 SAMPLE_RATE_CONVERTER_INPUT_BUFFER_NUMBER_OVERFLOW_SAMPLES)
-
-#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
-#define SAMPLE_RATE_CONVERTER_INTERNAL_INPUT_BUF_SIZE                                              \
-	(INTERNAL_INPUT_BUF_NUMBER_SAMPLES * sizeof(uint16_t))
-#define SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE                                             \
-	(CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX * sizeof(uint16_t))
-#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
-#define SAMPLE_RATE_CONVERTER_INTERNAL_INPUT_BUF_SIZE                                              \
-	(INTERNAL_INPUT_BUF_NUMBER_SAMPLES * sizeof(uint32_t))
-#define SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE                                             \
-	(CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX * sizeof(uint32_t))
-#endif
+/* Conversion ratio that needs the input and output to be buffered between process calls */
+#define BUFFERED_CONVERSION_RATIO 3
 
 static int validate_sample_rates(uint32_t sample_rate_input, uint32_t sample_rate_output)
 {
@@ -75,6 +60,48 @@ static inline int calculate_conversion_ratio(uint32_t sample_rate_input,
 	}
 }
 
+/**
+ * @brief Reconfigures the sample rate converter context for the polyphase filter.
+ *
+ * @param[in,out]	ctx			Pointer to the sample rate conversion context.
+ * @param[in]		sample_rate_input	Sample rate of the input samples.
+ * @param[in]		sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL Invalid sample rates, or the polyphase filter is not enabled.
+ */
+static int polyphase_reconfigure(struct sample_rate_converter_ctx *ctx, uint32_t sample_rate_input,
+				 uint32_t sample_rate_output)
+{
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+	int ret;
+
+	if (sample_rate_input == sample_rate_output) {
+		LOG_ERR("Input and out sample rates are the same");
+		return -EINVAL;
+	}
+
+	ret = sample_rate_converter_polyphase_init(&ctx->polyphase, sample_rate_input,
+						   sample_rate_output);
+	if (ret) {
+		return ret;
+	}
+
+	ctx->sample_rate_input = sample_rate_input;
+	ctx->sample_rate_output = sample_rate_output;
+	ctx->conversion_ratio = 0;
+	ctx->filter_type = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	LOG_DBG("Polyphase sample rate converter initialized. Input sample rate: %d, Output "
+		"sample rate: %d",
+		sample_rate_input, sample_rate_output);
+	return 0;
+#else
+	LOG_ERR("Polyphase filter is not enabled");
+	return -EINVAL;
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+}
+
 /**
  * @brief Reconfigures the sample rate converter context.
  *
@@ -102,6 +129,10 @@ static int sample_rate_converter_reconfigure(struct sample_rate_converter_ctx *c
 
 	__ASSERT(ctx != NULL, "Context cannot be NULL");
 
+	if (filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+		return polyphase_reconfigure(ctx, sample_rate_input, sample_rate_output);
+	}
+
 	ret = validate_sample_rates(sample_rate_input, sample_rate_output);
 	if (ret) {
 		LOG_ERR("Invalid sample rate given (%d)", ret);
@@ -126,7 +157,7 @@ static int sample_rate_converter_reconfigure(struct sample_rate_converter_ctx *c
 		return -EINVAL;
 	}
 
-	if (ctx->conversion_ratio == 3) {
+	if (ctx->conversion_ratio == BUFFERED_CONVERSION_RATIO) {
 		LOG_DBG("Conversion needs buffering, start with the input buffer filled");
 		if (IS_ENABLED(CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16)) {
 			ctx->input_buf.bytes_in_buf =
@@ -199,6 +230,178 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx)
 	return 0;
 }
 
+/**
+ * @brief Runs the CMSIS DSP filter for the current conversion.
+ *
+ * @param[in,out]	ctx		Pointer to the sample rate conversion context.
+ * @param[in]		input		Pointer to samples to process.
+ * @param[out]		output		Pointer to where output samples are written.
+ * @param[in]		samples		Number of input samples to process.
+ */
+static void filter_process(struct sample_rate_converter_ctx *ctx, void const *input, void *output,
+			   size_t samples)
+{
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	if (ctx->conversion_ratio > 0) {
+		arm_fir_interpolate_q15(&ctx->fir_interpolate_q15, (q15_t *)input, (q15_t *)output,
+					samples);
+	} else {
+		arm_fir_decimate_q15(&ctx->fir_decimate_q15, (q15_t *)input, (q15_t *)output,
+				     samples);
+	}
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	if (ctx->conversion_ratio > 0) {
+		arm_fir_interpolate_q31(&ctx->fir_interpolate_q31, (q31_t *)input, (q31_t *)output,
+					samples);
+	} else {
+		arm_fir_decimate_q31(&ctx->fir_decimate_q31, (q31_t *)input, (q31_t *)output,
+				     samples);
+	}
+#endif
+}
+
+/**
+ * @brief Filters samples from the stream made of the input buffer followed by the incoming
+ *	  samples.
+ *
+ * @details The filter state keeps the history between calls, so filtering the two parts
+ *	    separately gives the same result as filtering them as one block. This avoids merging
+ *	    them into a temporary buffer.
+ *
+ * @param[in,out]	ctx			Pointer to the sample rate conversion context.
+ * @param[in]		input			Pointer to the incoming samples.
+ * @param[in]		offset			Position in the stream of the first sample to process.
+ * @param[in]		samples			Number of samples to process.
+ * @param[out]		output			Pointer to where output samples are written.
+ * @param[in]		bytes_per_sample	Number of bytes per sample.
+ */
+static void buffered_filter_process(struct sample_rate_converter_ctx *ctx, uint8_t const *input,
+				    size_t offset, size_t samples, uint8_t *output,
+				    size_t bytes_per_sample)
+{
+	size_t buf_samples = ctx->input_buf.bytes_in_buf / bytes_per_sample;
+	size_t buf_samples_to_process;
+
+	if (offset < buf_samples) {
+		buf_samples_to_process = MIN(samples, buf_samples - offset);
+
+		filter_process(ctx, &ctx->input_buf.buf[offset * bytes_per_sample], output,
+			       buf_samples_to_process);
+
+		output += buf_samples_to_process * ctx->conversion_ratio * bytes_per_sample;
+		samples -= buf_samples_to_process;
+		offset = buf_samples;
+	}
+
+	if (samples) {
+		filter_process(ctx, &input[(offset - buf_samples) * bytes_per_sample], output,
+			       samples);
+	}
+}
+
+/**
+ * @brief Converts samples for a conversion that needs buffering.
+ *
+ * @details Output samples kept from the previous call are output first. The new output samples
+ *	    are filtered directly into the output, and only the ones that do not fit are stored
+ *	    in the output ring buffer. The incoming samples that are not processed are stored in
+ *	    the input buffer.
+ *
+ * @param[in,out]	ctx			Pointer to the sample rate conversion context.
+ * @param[in]		input			Pointer to samples to process.
+ * @param[in]		samples_in		Number of input samples.
+ * @param[out]		output			Array that output will be written.
+ * @param[in]		bytes_per_sample	Number of bytes per sample.
+ *
+ * @retval 0 On success.
+ * @retval -EFAULT Not enough samples to output, or not enough space to store samples.
+ */
+static int buffered_process(struct sample_rate_converter_ctx *ctx, uint8_t const *input,
+			    size_t samples_in, uint8_t *output, size_t bytes_per_sample)
+{
+	size_t buf_samples = ctx->input_buf.bytes_in_buf / bytes_per_sample;
+	size_t bytes_per_input_sample = ctx->conversion_ratio * bytes_per_sample;
+	size_t bytes_to_read = samples_in * bytes_per_input_sample;
+	size_t samples_to_process;
+	size_t samples_to_keep;
+	size_t samples_direct;
+	size_t bytes;
+
+	/* Output of one input sample */
+	uint8_t block[BUFFERED_CONVERSION_RATIO * sizeof(uint32_t)];
+
+	if (((samples_in + buf_samples) % ctx->conversion_ratio) == 0) {
+		size_t extra_samples = ctx->conversion_ratio - (samples_in % ctx->conversion_ratio);
+
+		LOG_DBG("Using %d extra samples from input buffer", extra_samples);
+		samples_to_process = samples_in + extra_samples;
+	} else {
+		size_t extra_samples = (samples_in % ctx->conversion_ratio);
+
+		LOG_DBG("Storing %d samples in input buffer for next iteration", extra_samples);
+		samples_to_process = samples_in - extra_samples;
+	}
+
+	samples_to_process = MIN(samples_to_process, buf_samples + samples_in);
+	samples_to_keep = buf_samples + samples_in - samples_to_process;
+
+	if ((samples_to_keep * bytes_per_sample) > sizeof(ctx->input_buf.buf)) {
+		LOG_ERR("Input buffer storage exhausted");
+		return -EFAULT;
+	}
+
+	if ((ring_buf_size_get(&ctx->output_ringbuf) +
+	     (samples_to_process * bytes_per_input_sample)) < bytes_to_read) {
+		LOG_ERR("Ring buffer storage empty");
+		return -EFAULT;
+	}
+
+	bytes = ring_buf_get(&ctx->output_ringbuf, output, bytes_to_read);
+	output += bytes;
+	bytes_to_read -= bytes;
+
+	samples_direct = MIN(samples_to_process, bytes_to_read / bytes_per_input_sample);
+	buffered_filter_process(ctx, input, 0, samples_direct, output, bytes_per_sample);
+	output += samples_direct * bytes_per_input_sample;
+	bytes_to_read -= samples_direct * bytes_per_input_sample;
+
+	LOG_DBG("Writing %d samples to output buffer", samples_to_process - samples_direct);
+	for (size_t i = samples_direct; i < samples_to_process; i++) {
+		buffered_filter_process(ctx, input, i, 1, block, bytes_per_sample);
+
+		bytes = MIN(bytes_to_read, bytes_per_input_sample);
+		memcpy(output, block, bytes);
+		output += bytes;
+		bytes_to_read -= bytes;
+
+		if (ring_buf_put(&ctx->output_ringbuf, &block[bytes],
+				 bytes_per_input_sample - bytes) != (bytes_per_input_sample - bytes)) {
+			LOG_ERR("Ring buffer storage exhausted");
+			return -EFAULT;
+		}
+	}
+
+	/* Keep the end of the stream for the next call */
+	if (samples_to_keep > samples_in) {
+		size_t buf_samples_to_keep = samples_to_keep - samples_in;
+
+		memmove(ctx->input_buf.buf,
+			&ctx->input_buf.buf[(buf_samples - buf_samples_to_keep) * bytes_per_sample],
+			buf_samples_to_keep * bytes_per_sample);
+		memcpy(&ctx->input_buf.buf[buf_samples_to_keep * bytes_per_sample], input,
+		       samples_in * bytes_per_sample);
+	} else {
+		memcpy(ctx->input_buf.buf,
+		       &input[(samples_in - samples_to_keep) * bytes_per_sample],
+		       samples_to_keep * bytes_per_sample);
+	}
+
+	ctx->input_buf.bytes_in_buf = samples_to_keep * bytes_per_sample;
+	LOG_DBG("%d samples stored in input buffer", samples_to_keep);
+
+	return 0;
+}
+
 int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 				  enum sample_rate_converter_filter filter, void const *const input,
 				  size_t input_size, uint32_t sample_rate_input, void *const output,
@@ -206,12 +409,6 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 				  uint32_t sample_rate_output)
 {
 	int ret;
-	const uint8_t *read_ptr;
-	uint8_t *write_ptr;
-	size_t samples_to_process;
-
-	uint8_t internal_input_buf[SAMPLE_RATE_CONVERTER_INTERNAL_INPUT_BUF_SIZE];
-	uint8_t internal_output_buf[SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE];
 
 #if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
 	size_t bytes_per_sample = sizeof(uint16_t);
@@ -247,6 +444,14 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 		}
 	}
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+	if (ctx->filter_type == SAMPLE_RATE_FILTER_POLYPHASE) {
+		return sample_rate_converter_polyphase_process(&ctx->polyphase, input, samples_in,
+							       output, output_size,
+							       output_written);
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
 	if ((ctx->conversion_ratio < 0) && (samples_in < abs(ctx->conversion_ratio))) {
 		LOG_ERR("Number of samples in can not be less than the conversion ratio (%d) when "
 			"downsampling",
@@ -266,130 +471,11 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 		return -EINVAL;
 	}
 
-	if (*output_written > SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE) {
-		LOG_ERR("Conversion process will produce more bytes than the internal output "
-			"buffer can hold");
-		return -EINVAL;
-	}
-
-	if (ctx->conversion_ratio == 3) {
-		read_ptr = internal_input_buf;
-		write_ptr = internal_output_buf;
-
-		if (((samples_in + (ctx->input_buf.bytes_in_buf * bytes_per_sample)) %
-		     ctx->conversion_ratio) == 0) {
-			size_t extra_samples =
-				ctx->conversion_ratio - (samples_in % ctx->conversion_ratio);
-
-			LOG_DBG("Using %d extra samples from input buffer", extra_samples);
-			samples_to_process = samples_in + extra_samples;
-		} else {
-			size_t extra_samples = (samples_in % ctx->conversion_ratio);
-
-			LOG_DBG("Storing %d samples in input buffer for next iteration",
-				extra_samples);
-			samples_to_process = samples_in - extra_samples;
-		}
-
-		/* Merge bytes in input buffer and incoming bytes into the internal buffer
-		 * for processing
-		 */
-		memcpy(internal_input_buf, ctx->input_buf.buf, ctx->input_buf.bytes_in_buf);
-		memcpy(internal_input_buf + ctx->input_buf.bytes_in_buf, input, input_size);
-	} else {
-		write_ptr = output;
-		read_ptr = input;
-		samples_to_process = samples_in;
-	}
-
-#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
-	if (ctx->conversion_ratio > 0) {
-		arm_fir_interpolate_q15(&ctx->fir_interpolate_q15, (q15_t *)read_ptr,
-					(q15_t *)write_ptr, samples_to_process);
-	} else {
-		arm_fir_decimate_q15(&ctx->fir_decimate_q15, (q15_t *)read_ptr, (q15_t *)write_ptr,
-				     samples_to_process);
+	if (ctx->conversion_ratio == BUFFERED_CONVERSION_RATIO) {
+		return buffered_process(ctx, input, samples_in, output, bytes_per_sample);
 	}
-#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
-	if (ctx->conversion_ratio > 0) {
-		arm_fir_interpolate_q31(&ctx->fir_interpolate_q31, (q31_t *)read_ptr,
-					(q31_t *)write_ptr, samples_to_process);
-	} else {
-		arm_fir_decimate_q31(&ctx->fir_decimate_q31, (q31_t *)read_ptr, (q31_t *)write_ptr,
-				     samples_to_process);
-	}
-#endif
 
-	if (ctx->conversion_ratio != 3) {
-		/* Nothing needs to be done in output buffer */
-		return 0;
-	}
-
-	if (samples_to_process < samples_in) {
-		size_t number_overflow_samples = samples_in - samples_to_process;
-
-		ctx->input_buf.bytes_in_buf += number_overflow_samples * bytes_per_sample;
-		memcpy(ctx->input_buf.buf, read_ptr + (samples_to_process * bytes_per_sample),
-		       ctx->input_buf.bytes_in_buf);
-		LOG_DBG("%d overflow samples stored in buffer", number_overflow_samples);
-	} else if ((ctx->input_buf.bytes_in_buf) &&
-		   (((samples_in + (ctx->input_buf.bytes_in_buf * bytes_per_sample)) %
-		     ctx->conversion_ratio) == 0)) {
-		uint8_t overflow_samples_used =
-			ctx->conversion_ratio - (samples_in % ctx->conversion_ratio);
-
-		ctx->input_buf.bytes_in_buf -= overflow_samples_used * bytes_per_sample;
-		LOG_DBG("%d overflow samples has been used", overflow_samples_used);
-	}
-
-	int bytes_to_write = samples_to_process * ctx->conversion_ratio * bytes_per_sample;
-	uint8_t *ringbuf_write_ptr = (uint8_t *)internal_output_buf;
-
-	LOG_DBG("Writing %d bytes to output buffer", bytes_to_write);
-	while (bytes_to_write) {
-		uint8_t *data;
-		size_t ringbuf_write_size =
-			ring_buf_put_claim(&ctx->output_ringbuf, &data, bytes_to_write);
-		if (ringbuf_write_size == 0) {
-			LOG_ERR("Ring buffer storage exhausted");
-			return -EFAULT;
-		}
-
-		memcpy(data, ringbuf_write_ptr, ringbuf_write_size);
-
-		ret = ring_buf_put_finish(&ctx->output_ringbuf, ringbuf_write_size);
-		if (ret) {
-			LOG_ERR("Ringbuf err: %d", ret);
-			return -EFAULT;
-		}
-
-		ringbuf_write_ptr += ringbuf_write_size;
-		bytes_to_write -= ringbuf_write_size;
-	}
-	int bytes_to_read = input_size * ctx->conversion_ratio;
-	uint8_t *ringbuf_output_ptr = (uint8_t *)output;
-
-	LOG_DBG("Reading %d bytes from output_buffer", bytes_to_read);
-	while (bytes_to_read) {
-		uint8_t *data;
-		size_t ringbuf_read_size =
-			ring_buf_get_claim(&ctx->output_ringbuf, &data, bytes_to_read);
-
-		if (ringbuf_read_size == 0) {
-			LOG_ERR("Ring buffer storage empty");
-			return -EFAULT;
-		}
-
-		memcpy(ringbuf_output_ptr, data, ringbuf_read_size);
-		ringbuf_output_ptr += ringbuf_read_size;
-		bytes_to_read -= ringbuf_read_size;
-
-		ret = ring_buf_get_finish(&ctx->output_ringbuf, ringbuf_read_size);
-		if (ret) {
-			LOG_ERR("Ring buf read err: %d", ret);
-			return -EFAULT;
-		}
-	}
+	filter_process(ctx, input, output, samples_in);
 
 	return 0;
 }
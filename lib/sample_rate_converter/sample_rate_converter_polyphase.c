@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "sample_rate_converter.h"
+#include "sample_rate_converter_polyphase.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <dsp/basic_math_functions.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sample_rate_converter_polyphase, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
+
+#define PHASES	    CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES
+#define TAPS	    CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+#define HISTORY_LEN SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE
+
+/* Sample rates above this would overflow the phase calculation. */
+#define SAMPLE_RATE_MAX 384000
+
+/* Cut-off relative to the lower Nyquist frequency, leaving room for the transition band. */
+#define CUTOFF_SCALE 0.9f
+
+/* Number of fractional bits used for the weight between two phases. */
+#define PHASE_WEIGHT_BITS 15
+
+#define PI_F 3.14159265358979f
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef q15_t sample_t;
+#define SAMPLE_MIN INT16_MIN
+#define SAMPLE_MAX INT16_MAX
+/* arm_dot_prod_q15 gives a result in 34.30 format. */
+#define DOT_PROD_SHIFT 15
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef q31_t sample_t;
+#define SAMPLE_MIN INT32_MIN
+#define SAMPLE_MAX INT32_MAX
+/* arm_dot_prod_q31 gives a result in 16.48 format. */
+#define DOT_PROD_SHIFT 17
+#endif
+
+static inline q63_t dot_prod(sample_t const *const x, sample_t const *const coeffs, uint32_t len)
+{
+	q63_t res;
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	arm_dot_prod_q15(x, coeffs, len, &res);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	arm_dot_prod_q31(x, coeffs, len, &res);
+#endif
+
+	return res;
+}
+
+/* Filter the TAPS samples starting at pos, where the history is followed by the input. A window
+ * starting in the history is split into two dot products, so the input is never copied.
+ */
+static int64_t filter(struct sample_rate_converter_polyphase const *poly,
+		      sample_t const *const input, uint32_t pos, sample_t const *const coeffs)
+{
+	uint32_t len;
+	q63_t res;
+
+	if (pos >= HISTORY_LEN) {
+		res = dot_prod(&input[pos - HISTORY_LEN], coeffs, TAPS);
+	} else {
+		len = HISTORY_LEN - pos;
+		res = dot_prod(&poly->history[pos], coeffs, len) +
+		      dot_prod(input, coeffs + len, TAPS - len);
+	}
+
+	return res >> DOT_PROD_SHIFT;
+}
+
+static inline float sinc(float x)
+{
+	if (x == 0.0f) {
+		return 1.0f;
+	}
+
+	return sinf(PI_F * x) / (PI_F * x);
+}
+
+/* Windowed-sinc prototype filter, PHASES * TAPS long, sampled at PHASES times the input
+ * sample rate. The Blackman window is zero at both ends, so the extra phase only needs the
+ * TAPS most recent input samples.
+ */
+static void coeffs_compute(struct sample_rate_converter_polyphase *poly, uint32_t sample_rate_input,
+			   uint32_t sample_rate_output)
+{
+	const float len = PHASES * TAPS;
+	float cutoff = 0.5f * CUTOFF_SCALE;
+	float h[TAPS];
+	float sum;
+	float u;
+
+	if (sample_rate_output < sample_rate_input) {
+		cutoff = cutoff * sample_rate_output / sample_rate_input;
+	}
+
+	for (uint32_t p = 0; p <= PHASES; p++) {
+		sum = 0.0f;
+
+		for (uint32_t j = 0; j < TAPS; j++) {
+			u = (float)(j * PHASES + p);
+			h[j] = 2.0f * cutoff * sinc(2.0f * cutoff * (u - len / 2.0f) / PHASES) *
+			       (0.42f - 0.5f * cosf(2.0f * PI_F * u / len) +
+				0.08f * cosf(4.0f * PI_F * u / len));
+			sum += h[j];
+		}
+
+		/* Normalize each phase to unity gain, and store it reversed so that the dot
+		 * product can run forward over the input history.
+		 */
+		for (uint32_t j = 0; j < TAPS; j++) {
+			float coeff = h[j] / sum * ((float)SAMPLE_MAX + 1.0f);
+
+			poly->coeffs[p * TAPS + (TAPS - 1 - j)] =
+				(sample_t)CLAMP(lrintf(coeff), SAMPLE_MIN, SAMPLE_MAX);
+		}
+	}
+}
+
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *poly,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output)
+{
+	if ((sample_rate_input == 0) || (sample_rate_input > SAMPLE_RATE_MAX) ||
+	    (sample_rate_output == 0) || (sample_rate_output > SAMPLE_RATE_MAX)) {
+		LOG_ERR("Sample rates not supported by polyphase filter: %d, %d",
+			sample_rate_input, sample_rate_output);
+		return -EINVAL;
+	}
+
+	poly->step_int = sample_rate_input / sample_rate_output;
+	poly->step_frac = sample_rate_input % sample_rate_output;
+	poly->pos_int = 0;
+	poly->pos_frac = 0;
+	poly->sample_rate_output = sample_rate_output;
+
+	memset(poly->history, 0, sizeof(poly->history));
+
+	coeffs_compute(poly, sample_rate_input, sample_rate_output);
+
+	return 0;
+}
+
+/* Number of output samples for samples_in new input samples */
+static size_t output_samples_get(struct sample_rate_converter_polyphase const *poly,
+				 size_t samples_in)
+{
+	uint64_t step = (uint64_t)poly->step_int * poly->sample_rate_output + poly->step_frac;
+	uint64_t pos = (uint64_t)poly->pos_int * poly->sample_rate_output + poly->pos_frac;
+	uint64_t end = (uint64_t)samples_in * poly->sample_rate_output;
+
+	if (pos >= end) {
+		return 0;
+	}
+
+	return DIV_ROUND_UP(end - pos, step);
+}
+
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *poly,
+					    void const *const input, size_t samples_in,
+					    void *const output, size_t output_size,
+					    size_t *output_written)
+{
+	sample_t *out = output;
+	sample_t const *in = input;
+	sample_t const *coeffs;
+	size_t samples_out;
+	uint64_t phase;
+	uint32_t weight;
+	int64_t res;
+	int64_t res_next;
+
+	samples_out = output_samples_get(poly, samples_in);
+	if ((samples_out * sizeof(sample_t)) > output_size) {
+		LOG_ERR("Conversion process will produce more bytes than the output buffer can "
+			"hold");
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < samples_out; i++) {
+		/* Find the two closest phases, and the weight between them */
+		phase = (uint64_t)poly->pos_frac * PHASES;
+		coeffs = &poly->coeffs[(phase / poly->sample_rate_output) * TAPS];
+		weight = ((phase % poly->sample_rate_output) << PHASE_WEIGHT_BITS) /
+			 poly->sample_rate_output;
+
+		res = filter(poly, in, poly->pos_int, coeffs);
+		res_next = filter(poly, in, poly->pos_int, coeffs + TAPS);
+		res += ((res_next - res) * weight) >> PHASE_WEIGHT_BITS;
+
+		out[i] = (sample_t)CLAMP(res, SAMPLE_MIN, SAMPLE_MAX);
+
+		poly->pos_int += poly->step_int;
+		poly->pos_frac += poly->step_frac;
+		if (poly->pos_frac >= poly->sample_rate_output) {
+			poly->pos_frac -= poly->sample_rate_output;
+			poly->pos_int++;
+		}
+	}
+
+	__ASSERT_NO_MSG(poly->pos_int >= samples_in);
+	poly->pos_int -= samples_in;
+
+	/* Keep the last HISTORY_LEN samples for the next block */
+	if (samples_in >= HISTORY_LEN) {
+		memcpy(poly->history, &in[samples_in - HISTORY_LEN],
+		       HISTORY_LEN * sizeof(sample_t));
+	} else {
+		memmove(poly->history, &poly->history[samples_in],
+			(HISTORY_LEN - samples_in) * sizeof(sample_t));
+		memcpy(&poly->history[HISTORY_LEN - samples_in], in, samples_in * sizeof(sample_t));
+	}
+
+	*output_written = samples_out * sizeof(sample_t);
+
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+#define _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+
+#include "sample_rate_converter.h"
+
+/**
+ * @brief Initialize the polyphase filter for the given sample rates.
+ *
+ * @details Computes the filter coefficients, with the cut-off at the lower of the two Nyquist
+ *	    frequencies, and clears the filter history.
+ *
+ * @param[out]	poly			Pointer to the polyphase filter context.
+ * @param[in]	sample_rate_input	Sample rate of the input samples.
+ * @param[in]	sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Sample rates not supported.
+ */
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *poly,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output);
+
+/**
+ * @brief Convert a block of samples with the polyphase filter.
+ *
+ * @param[in,out]	poly		Pointer to the polyphase filter context.
+ * @param[in]		input		Pointer to samples to process.
+ * @param[in]		samples_in	Number of input samples.
+ * @param[out]		output		Array that output will be written.
+ * @param[in]		output_size	Size of the output array in bytes.
+ * @param[out]		output_written	Number of bytes written to output.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Output array is too small.
+ */
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *poly,
+					    void const *const input, size_t samples_in,
+					    void *const output, size_t output_size,
+					    size_t *output_written);
+
+#endif /* _SAMPLE_RATE_CONVERTER_POLYPHASE_H_ */
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stddef.h>
 #include <stdio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
@@ -21,8 +22,18 @@ struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
 static K_WORK_DEFINE(event_processor, event_processor_fn);
 static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+static sys_slist_t eventq_high = SYS_SLIST_STATIC_INIT(&eventq_high);
 static struct k_spinlock lock;
 
+#ifdef CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_DEDICATED_THREAD
+static void high_prio_event_processor_fn(struct k_work *work);
+
+static K_WORK_DEFINE(high_prio_event_processor, high_prio_event_processor_fn);
+static K_THREAD_STACK_DEFINE(high_prio_work_q_stack,
+			     CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_THREAD_STACK_SIZE);
+static struct k_work_q high_prio_work_q;
+#endif
+
 static bool log_is_event_displayed(const struct event_type *et)
 {
 	size_t idx = et - _event_type_list_start;
@@ -114,9 +125,162 @@ static void log_event_init(void)
 	}
 }
 
+#ifdef CONFIG_APP_EVENT_MANAGER_MEM_SLAB
+/* Events may contain members of any type, including 64-bit ones. */
+#define EVENT_MEM_SLAB_ALIGN __alignof__(max_align_t)
+#define EVENT_MEM_SLAB_BLOCK_SIZE(size) ROUND_UP(size, EVENT_MEM_SLAB_ALIGN)
+#define EVENT_MEM_SLAB_SMALL_SIZE \
+	EVENT_MEM_SLAB_BLOCK_SIZE(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_SMALL_SIZE)
+#define EVENT_MEM_SLAB_MEDIUM_SIZE \
+	EVENT_MEM_SLAB_BLOCK_SIZE(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_MEDIUM_SIZE)
+#define EVENT_MEM_SLAB_LARGE_SIZE \
+	EVENT_MEM_SLAB_BLOCK_SIZE(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_LARGE_SIZE)
+
+BUILD_ASSERT((CONFIG_APP_EVENT_MANAGER_MEM_SLAB_SMALL_SIZE <
+	      CONFIG_APP_EVENT_MANAGER_MEM_SLAB_MEDIUM_SIZE) &&
+	     (CONFIG_APP_EVENT_MANAGER_MEM_SLAB_MEDIUM_SIZE <
+	      CONFIG_APP_EVENT_MANAGER_MEM_SLAB_LARGE_SIZE),
+	     "Event memory slab size classes must be sorted by block size");
+
+K_MEM_SLAB_DEFINE_STATIC(event_mem_slab_small, EVENT_MEM_SLAB_SMALL_SIZE,
+			 CONFIG_APP_EVENT_MANAGER_MEM_SLAB_SMALL_COUNT, EVENT_MEM_SLAB_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(event_mem_slab_medium, EVENT_MEM_SLAB_MEDIUM_SIZE,
+			 CONFIG_APP_EVENT_MANAGER_MEM_SLAB_MEDIUM_COUNT, EVENT_MEM_SLAB_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(event_mem_slab_large, EVENT_MEM_SLAB_LARGE_SIZE,
+			 CONFIG_APP_EVENT_MANAGER_MEM_SLAB_LARGE_COUNT, EVENT_MEM_SLAB_ALIGN);
+
+struct event_mem_slab {
+	struct k_mem_slab *slab;
+	size_t block_size;
+	uint32_t block_cnt;
+	atomic_t alloc_fail_cnt;
+};
+
+/* Size classes sorted by block size. */
+static struct event_mem_slab event_mem_slabs[] = {
+	{
+		.slab = &event_mem_slab_small,
+		.block_size = EVENT_MEM_SLAB_SMALL_SIZE,
+		.block_cnt = CONFIG_APP_EVENT_MANAGER_MEM_SLAB_SMALL_COUNT,
+	},
+	{
+		.slab = &event_mem_slab_medium,
+		.block_size = EVENT_MEM_SLAB_MEDIUM_SIZE,
+		.block_cnt = CONFIG_APP_EVENT_MANAGER_MEM_SLAB_MEDIUM_COUNT,
+	},
+	{
+		.slab = &event_mem_slab_large,
+		.block_size = EVENT_MEM_SLAB_LARGE_SIZE,
+		.block_cnt = CONFIG_APP_EVENT_MANAGER_MEM_SLAB_LARGE_COUNT,
+	},
+};
+
+static struct event_mem_slab *event_mem_slab_find(size_t size)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(event_mem_slabs); i++) {
+		if (size <= event_mem_slabs[i].block_size) {
+			return &event_mem_slabs[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool event_mem_slab_owns(const struct event_mem_slab *ems, const void *addr)
+{
+	const uint8_t *start = (const uint8_t *)ems->slab->buffer;
+
+	return ((const uint8_t *)addr >= start) &&
+	       ((const uint8_t *)addr < start + ems->block_size * ems->block_cnt);
+}
+
+static void *event_mem_alloc(size_t size)
+{
+	struct event_mem_slab *ems = event_mem_slab_find(size);
+	void *block;
+
+	if (likely(ems) && likely(!k_mem_slab_alloc(ems->slab, &block, K_NO_WAIT))) {
+		return block;
+	}
+
+	if (ems) {
+		atomic_inc(&ems->alloc_fail_cnt);
+	}
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_HEAP_FALLBACK)) {
+		return k_malloc(size);
+	}
+
+	return NULL;
+}
+
+static void event_mem_free(void *addr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(event_mem_slabs); i++) {
+		if (event_mem_slab_owns(&event_mem_slabs[i], addr)) {
+			k_mem_slab_free(event_mem_slabs[i].slab, addr);
+			return;
+		}
+	}
+
+	__ASSERT(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_HEAP_FALLBACK),
+		 "Freed event does not belong to any memory slab");
+	k_free(addr);
+}
+
+static void event_mem_slab_check(void)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROVIDE_EVENT_SIZE)
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		/* Size of events with dynamic data is known only on allocation. */
+		if (app_event_get_type_flag(et, APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)) {
+			continue;
+		}
+
+		if (!event_mem_slab_find(et->struct_size)) {
+			LOG_WRN("Event %s (%u bytes) does not fit in any memory slab",
+				et->name, et->struct_size);
+		}
+	}
+#endif
+}
+
+int app_event_manager_mem_slab_stats_get(size_t idx,
+					 struct app_event_manager_mem_slab_stats *stats)
+{
+	if (idx >= ARRAY_SIZE(event_mem_slabs)) {
+		return -ENOENT;
+	}
+
+	const struct event_mem_slab *ems = &event_mem_slabs[idx];
+
+	stats->block_size = ems->block_size;
+	stats->block_cnt = ems->block_cnt;
+	stats->used = k_mem_slab_num_used_get(ems->slab);
+	stats->max_used = k_mem_slab_max_used_get(ems->slab);
+	stats->alloc_fail_cnt = atomic_get(&ems->alloc_fail_cnt);
+
+	return 0;
+}
+#else
+static void *event_mem_alloc(size_t size)
+{
+	return k_malloc(size);
+}
+
+static void event_mem_free(void *addr)
+{
+	k_free(addr);
+}
+
+static void event_mem_slab_check(void)
+{
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_MEM_SLAB */
+
 void * __weak app_event_manager_alloc(size_t size)
 {
-	void *event = k_malloc(size);
+	void *event = event_mem_alloc(size);
 
 	if (unlikely(!event)) {
 		LOG_ERR("Application Event Manager OOM error\n");
@@ -134,74 +298,217 @@ void * __weak app_event_manager_alloc(size_t size)
 
 void __weak app_event_manager_free(void *addr)
 {
-	k_free(addr);
+	event_mem_free(addr);
 }
 
-static void event_processor_fn(struct k_work *work)
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+/* Listeners are notified from both the workqueue and the priority queue thread. */
+static struct k_spinlock listener_stats_lock;
+
+void app_event_manager_listener_stats_get(const struct event_listener *el,
+					  struct event_listener_stats *stats)
 {
-	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	*stats = *el->stats;
+
+	k_spin_unlock(&listener_stats_lock, key);
+}
+
+void app_event_manager_listener_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		memset(el->stats, 0, sizeof(*el->stats));
+	}
+
+	k_spin_unlock(&listener_stats_lock, key);
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LISTENER_STATS */
+
+static bool listener_notify(const struct event_listener *el, const struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	struct event_listener_stats *stats = el->stats;
+	uint32_t start = k_cycle_get_32();
+	bool consumed = el->notification(aeh);
+	uint32_t cycles = k_cycle_get_32() - start;
+	k_spinlock_key_t key = k_spin_lock(&listener_stats_lock);
+
+	stats->cycles += cycles;
+	stats->calls++;
+	if (consumed) {
+		stats->consumed++;
+	}
+
+	k_spin_unlock(&listener_stats_lock, key);
+
+	return consumed;
+#else
+	return el->notification(aeh);
+#endif
+}
+
+static void event_process(struct app_event_header *aeh)
+{
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	const struct event_type *et = aeh->type_id;
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	log_event(aeh);
+
+	bool consumed = false;
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
+
+		__ASSERT_NO_MSG(es != NULL);
+
+		const struct event_listener *el = es->listener;
+
+		__ASSERT_NO_MSG(el != NULL);
+		__ASSERT_NO_MSG(el->notification != NULL);
+
+		log_event_progress(et, el);
 
+		consumed = listener_notify(el, aeh);
+
+		if (consumed) {
+			log_event_consumed(et);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	app_event_manager_free(aeh);
+}
+
+static bool eventq_take(sys_slist_t *events, sys_slist_t *queue)
+{
 	/* Make current event list local. */
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (sys_slist_is_empty(&eventq)) {
+	if (sys_slist_is_empty(queue)) {
 		k_spin_unlock(&lock, key);
-		return;
+		return false;
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	sys_slist_merge_slist(events, queue);
 
 	k_spin_unlock(&lock, key);
 
+	return true;
+}
+
+static void events_process(sys_slist_t *events)
+{
 	/* Traverse the list of events. */
 	sys_snode_t *node;
-	while (NULL != (node = sys_slist_get(&events))) {
-		struct app_event_header *aeh = CONTAINER_OF(node,
-						       struct app_event_header,
-						       node);
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+	while (NULL != (node = sys_slist_get(events))) {
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
+	}
+}
 
-		const struct event_type *et = aeh->type_id;
+static void high_prio_events_process(void)
+{
+	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+	if (eventq_take(&events, &eventq_high)) {
+		events_process(&events);
+	}
+}
 
-		log_event(aeh);
+static void high_prio_events_process_inline(void)
+{
+	/* High priority events handled by a dedicated work queue are not processed inline.
+	 * Checking the list head without taking the lock is fine here, an event submitted
+	 * in the meantime kicks the work item again.
+	 */
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE) ||
+	    IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_DEDICATED_THREAD) ||
+	    sys_slist_is_empty(&eventq_high)) {
+		return;
+	}
 
-		bool consumed = false;
+	high_prio_events_process();
+}
 
-		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
-		     es++) {
+static void event_processor_fn(struct k_work *work)
+{
+	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
-			__ASSERT_NO_MSG(es != NULL);
+	high_prio_events_process_inline();
 
-			const struct event_listener *el = es->listener;
+	if (!eventq_take(&events, &eventq)) {
+		return;
+	}
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+	sys_snode_t *node;
 
-			log_event_progress(et, el);
+	while (NULL != (node = sys_slist_get(&events))) {
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
 
-			consumed = el->notification(aeh);
+		/* Dispatch high priority events submitted in the meantime before
+		 * the remaining events of the local list.
+		 */
+		high_prio_events_process_inline();
+	}
+}
 
-			if (consumed) {
-				log_event_consumed(et);
-			}
-		}
+#ifdef CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_DEDICATED_THREAD
+static void high_prio_event_processor_fn(struct k_work *work)
+{
+	high_prio_events_process();
+}
+#endif
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+static bool is_high_prio(const struct app_event_header *aeh)
+{
+	return IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE) &&
+	       app_event_get_type_flag(aeh->type_id, APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY);
+}
 
-		app_event_manager_free(aeh);
+static void event_processor_submit(bool high_prio)
+{
+#ifdef CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_DEDICATED_THREAD
+	if (high_prio) {
+		/* Submitting fails if the work queue is not yet started. Events queued before
+		 * the Application Event Manager is initialized are handled on initialization.
+		 */
+		(void)k_work_submit_to_queue(&high_prio_work_q, &high_prio_event_processor);
+		return;
 	}
+#endif
+
+	k_work_submit(&event_processor);
+}
+
+/* Must be called with the lock held. */
+static bool event_enqueue(struct app_event_header *aeh)
+{
+	bool high_prio = is_high_prio(aeh);
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
+			h->hook(aeh);
+		}
+	}
+	sys_slist_append(high_prio ? &eventq_high : &eventq, &aeh->node);
+
+	return high_prio;
 }
 
 void _event_submit(struct app_event_header *aeh)
@@ -210,16 +517,60 @@ void _event_submit(struct app_event_header *aeh)
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool high_prio = event_enqueue(aeh);
 
-	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
-		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
-			h->hook(aeh);
+	k_spin_unlock(&lock, key);
+
+	event_processor_submit(high_prio);
+}
+
+void app_event_manager_submit_batch(sys_slist_t *batch)
+{
+	__ASSERT_NO_MSG(batch);
+
+	if (sys_slist_is_empty(batch)) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_ASSERT)) {
+		sys_snode_t *node;
+
+		SYS_SLIST_FOR_EACH_NODE(batch, node) {
+			APP_EVENT_ASSERT_ID(CONTAINER_OF(node, struct app_event_header,
+							 node)->type_id);
+		}
+	}
+
+	bool regular_submitted = false;
+	bool high_prio_submitted = false;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS) ||
+	    IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE)) {
+		sys_snode_t *node;
+
+		while (NULL != (node = sys_slist_get(batch))) {
+			if (event_enqueue(CONTAINER_OF(node, struct app_event_header, node))) {
+				high_prio_submitted = true;
+			} else {
+				regular_submitted = true;
+			}
 		}
+	} else {
+		/* No per event work, link in the whole batch at once. */
+		sys_slist_merge_slist(&eventq, batch);
+		regular_submitted = true;
 	}
-	sys_slist_append(&eventq, &aeh->node);
+
 	k_spin_unlock(&lock, key);
 
-	k_work_submit(&event_processor);
+	if (high_prio_submitted) {
+		event_processor_submit(true);
+	}
+
+	if (regular_submitted) {
+		event_processor_submit(false);
+	}
 }
 
 int app_event_manager_init(void)
@@ -230,6 +581,20 @@ int app_event_manager_init(void)
 			CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT);
 
 	log_event_init();
+	event_mem_slab_check();
+
+#ifdef CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_DEDICATED_THREAD
+	static const struct k_work_queue_config cfg = {
+		.name = "app_event_manager_hp",
+	};
+
+	k_work_queue_start(&high_prio_work_q, high_prio_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(high_prio_work_q_stack),
+			   CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE_THREAD_PRIORITY, &cfg);
+
+	/* Handle high priority events submitted before the work queue was started. */
+	event_processor_submit(true);
+#endif
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
@@ -187,11 +187,23 @@ extern "C" {
 
 
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+#define _APP_EVENT_LISTENER_STATS_DEFINE(lname) \
+	static struct event_listener_stats _CONCAT(__event_listener_stats_, lname);
+#define _APP_EVENT_LISTENER_STATS_INIT(lname) \
+	.stats = &_CONCAT(__event_listener_stats_, lname),
+#else
+#define _APP_EVENT_LISTENER_STATS_DEFINE(lname)
+#define _APP_EVENT_LISTENER_STATS_INIT(lname)
+#endif
+
 /* Declarations and definitions - for more details refer to public API. */
 #define _APP_EVENT_LISTENER(lname, notification_fn)					\
+	_APP_EVENT_LISTENER_STATS_DEFINE(lname) /* No semicolon here intentionally */	\
 	STRUCT_SECTION_ITERABLE(event_listener, _CONCAT(__event_listener_, lname)) = {	\
 		.name = STRINGIFY(lname),						\
 		.notification = (notification_fn),					\
+		_APP_EVENT_LISTENER_STATS_INIT(lname) /* No comma here intentionally */	\
 	}
 
 
@@ -374,6 +386,23 @@ struct event_dyndata {
 };
 
 
+/** @brief Event listener statistics.
+ *
+ * The statistics are updated by the Application Event Manager when
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_LISTENER_STATS} is enabled.
+ */
+struct event_listener_stats {
+	/** Number of notifications delivered to the listener. */
+	uint32_t calls;
+
+	/** Number of events consumed by the listener. */
+	uint32_t consumed;
+
+	/** Number of hardware cycles spent in the notification function. */
+	uint64_t cycles;
+};
+
+
 /** @brief Event listener.
  *
  * All event listeners must be defined using @ref APP_EVENT_LISTENER.
@@ -387,6 +416,11 @@ struct event_listener {
 	 * not propagated to further listeners, or false, otherwise.
 	 */
 	bool (*notification)(const struct app_event_header *aeh);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	/** Pointer to the listener statistics. */
+	struct event_listener_stats *stats;
+#endif
 };
 
 
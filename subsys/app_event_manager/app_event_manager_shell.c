@@ -81,6 +81,56 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+static int show_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Listener statistics:\n");
+	shell_fprintf(shell, SHELL_NORMAL, "|\t%-24s %10s %10s %12s\n",
+		      "listener", "calls", "consumed", "time [us]");
+
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		struct event_listener_stats stats;
+
+		__ASSERT_NO_MSG(el->stats != NULL);
+
+		app_event_manager_listener_stats_get(el, &stats);
+
+		shell_fprintf(shell, SHELL_NORMAL, "|\t%-24s %10u %10u %12llu\n",
+			      el->name, stats.calls, stats.consumed,
+			      k_cyc_to_us_floor64(stats.cycles));
+	}
+
+	return 0;
+}
+
+static int reset_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	app_event_manager_listener_stats_reset();
+
+	shell_fprintf(shell, SHELL_NORMAL, "Listener statistics reset\n");
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LISTENER_STATS */
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB)
+static int show_mem_slabs(const struct shell *shell, size_t argc, char **argv)
+{
+	struct app_event_manager_mem_slab_stats stats;
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event memory slabs:\n");
+
+	for (size_t i = 0; !app_event_manager_mem_slab_stats_get(i, &stats); i++) {
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t%zu B: used %u/%u, max used %u, allocation failures %u\n",
+			      stats.block_size, stats.used, stats.block_cnt, stats.max_used,
+			      stats.alloc_fail_cnt);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_MEM_SLAB */
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -155,6 +205,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	SHELL_CMD_ARG(show_stats, NULL, "Show listener statistics", show_stats, 0, 0),
+	SHELL_CMD_ARG(reset_stats, NULL, "Reset listener statistics", reset_stats, 0, 0),
+#endif
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB)
+	SHELL_CMD_ARG(show_mem_slabs, NULL, "Show event memory slabs usage",
+		      show_mem_slabs, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
@@ -130,9 +130,54 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 		return false;
 	}
 
+	if (parameters->thread.data_slab != NULL &&
+	    parameters->thread.data_slab->info.num_blocks > CONFIG_AUDIO_MODULE_DATA_BUFFERS_MAX) {
+		LOG_ERR("Data slab has more blocks than CONFIG_AUDIO_MODULE_DATA_BUFFERS_MAX");
+		return false;
+	}
+
 	return true;
 }
 
+/**
+ * @brief Helper function to get the reference count of an audio data buffer.
+ *
+ * @param handle  [in/out]  The handle of the module owning the buffer.
+ * @param data    [in]      Pointer to the buffer taken from the module's data slab.
+ *
+ * @return Pointer to the reference count of the buffer.
+ */
+static atomic_t *data_ref_cnt_get(struct audio_module_handle *handle, void const *const data)
+{
+	struct k_mem_slab *slab = handle->thread.data_slab;
+	size_t idx = ((uint8_t const *)data - (uint8_t const *)slab->buffer) /
+		     slab->info.block_size;
+
+	__ASSERT(idx < ARRAY_SIZE(handle->data_ref_cnt), "Buffer not from data slab of module %s",
+		 handle->name);
+
+	return &handle->data_ref_cnt[idx];
+}
+
+/**
+ * @brief Release a reference to an audio data buffer. The buffer is returned to the module's data
+ *        slab when the last reference is released.
+ *
+ * @param handle  [in/out]  The handle of the module owning the buffer.
+ * @param data    [in]      Pointer to the buffer taken from the module's data slab.
+ */
+static void data_ref_put(struct audio_module_handle *handle, void const *const data)
+{
+	atomic_t *ref_cnt = data_ref_cnt_get(handle, data);
+
+	if (atomic_dec(ref_cnt) == 1) {
+		LOG_DBG("Audio data has been consumed in module %s", handle->name);
+
+		/* Audio data has been consumed by all modules so now can free the data memory. */
+		k_mem_slab_free(handle->thread.data_slab, (void *)data);
+	}
+}
+
 /**
  * @brief General callback for releasing the data when inter-module data
  *        passing.
@@ -143,21 +188,7 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 static void audio_data_release_cb(struct audio_module_handle_private *handle,
 				  struct audio_data const *const audio_data)
 {
-	int ret;
-	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
-
-	ret = k_sem_take(&hdl->sem, K_NO_WAIT);
-	if (ret) {
-		LOG_ERR("Failed to take semaphore for data release callback function");
-		return;
-	}
-
-	if (k_sem_count_get(&hdl->sem) == 0) {
-		LOG_DBG("Audio data has been consumed in module %s", hdl->name);
-
-		/* Audio data has been consumed by all modules so now can free the data memory. */
-		k_mem_slab_free(hdl->thread.data_slab, (void *)audio_data->data);
-	}
+	data_ref_put((struct audio_module_handle *)handle, audio_data->data);
 }
 
 /**
@@ -248,11 +279,6 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 
 		data_fifo_block_free(handle->thread.msg_tx, (void *)data_msg_tx);
 
-		ret = k_sem_take(&handle->sem, K_NO_WAIT);
-		if (ret) {
-			LOG_ERR("Failed to take semaphore for TX FIFO put");
-		}
-
 		return ret;
 	}
 
@@ -273,7 +299,10 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 				     struct audio_data const *const audio_data)
 {
 	int ret;
+	int err = 0;
 	struct audio_module_handle *handle_to;
+	bool use_tx_queue = handle->use_tx_queue && handle->thread.msg_tx;
+	atomic_t *ref_cnt = data_ref_cnt_get(handle, audio_data->data);
 
 	if (handle->dest_count == 0) {
 		LOG_WRN("Nowhere to send the audio data from module %s so releasing it",
@@ -284,24 +313,19 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 		return 0;
 	}
 
-	/* We need to ensure that all receiving modules have got the audio data.
-	 * This is so the first receiver cannot free the audio data before all receivers
-	 * have all gotten the audio data.
-	 */
 	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
+		k_mem_slab_free(handle->thread.data_slab, (void *)audio_data->data);
 		return ret;
 	}
 
-	/* Here the semaphore is used as a count of the number of audio data items out in the
-	 * connected modules.
+	/* The audio data buffer is shared read-only by all receivers, each holding one reference.
+	 * The sender holds an additional reference until all receivers have got the audio data,
+	 * so the first receiver cannot free the buffer before the others have got it. The
+	 * destination count includes this module's TX FIFO when it is connected.
 	 */
-	ret = k_sem_init(&handle->sem, handle->dest_count, handle->dest_count);
-	if (ret) {
-		LOG_ERR("Failed to initiate semaphore");
-		return ret;
-	}
+	atomic_set(ref_cnt, handle->dest_count + 1);
 
 	/* Send to all internally connected modules. */
 	SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
@@ -310,37 +334,37 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 			LOG_ERR("Failed to send audio data to module %s from %s, ret %d",
 				handle_to->name, handle->name, ret);
 
-			return ret;
+			data_ref_put(handle, audio_data->data);
+			err = ret;
 		}
 	}
 
 	ret = k_mutex_unlock(&handle->dest_mutex);
 	if (ret) {
 		LOG_ERR("Failed to release MUTEX");
-		return ret;
+		err = ret;
 	}
 
 	/* Send to this module's TX FIFO for extraction by an external
 	 * process with audio_module_rx().
 	 */
-	if (handle->use_tx_queue && handle->thread.msg_tx) {
+	if (use_tx_queue) {
 		ret = tx_fifo_put(handle, audio_data);
 		if (ret) {
 			LOG_ERR("Failed to send audio data on module %s TX message queue",
 				handle->name);
 
-			ret = k_sem_take(&handle->sem, K_NO_WAIT);
-			if (ret) {
-				LOG_ERR("Failed to take semaphore");
-			}
-
-			return ret;
+			data_ref_put(handle, audio_data->data);
+			err = ret;
+		} else {
+			LOG_DBG("Sent audio data to TX message queue for module %s", handle->name);
 		}
-
-		LOG_DBG("Sent audio data to TX message queue for module %s", handle->name);
 	}
 
-	return 0;
+	/* Release the sender's reference. */
+	data_ref_put(handle, audio_data->data);
+
+	return err;
 }
 
 /**
@@ -695,7 +719,7 @@ int audio_module_close(struct audio_module_handle *handle)
 
 	/*
 	 * TODO: How to return all the data to the slab items?
-	 *       Test the semaphore and wait for it to be zero.
+	 *       Test the reference counts and wait for them to be zero.
 	 */
 
 	k_thread_abort(handle->thread_id);
@@ -1118,6 +1142,81 @@ int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *
 	return ret;
 }
 
+int audio_module_data_rx_shared(struct audio_module_handle *handle,
+				struct audio_data const **audio_data, k_timeout_t timeout)
+{
+	int ret;
+	struct audio_module_message *msg_rx = NULL;
+	size_t msg_rx_size = 0;
+
+	if (handle == NULL || audio_data == NULL) {
+		LOG_ERR("Module handle or audio data pointer are NULL");
+		return -EINVAL;
+	}
+
+	if (!state_not_undefined(handle->state) || !has_input_type(handle->description->type)) {
+		LOG_ERR("Module %s in an invalid state (%d) or type (%d) to receive data",
+			handle->name, handle->state, handle->description->type);
+		return -ECANCELED;
+	}
+
+	if (!state_running(handle->state)) {
+		LOG_WRN("Module %s is not running", handle->name);
+		return -ECANCELED;
+	}
+
+	if (handle->thread.msg_tx == NULL) {
+		LOG_ERR("Module has message queue set to NULL");
+		return -ECANCELED;
+	}
+
+	ret = data_fifo_pointer_last_filled_get(handle->thread.msg_tx, (void **)&msg_rx,
+						&msg_rx_size, timeout);
+	if (ret) {
+		LOG_ERR("Failed to retrieve data from module %s, ret %d", handle->name, ret);
+		return ret;
+	}
+
+	if (msg_rx == NULL) {
+		LOG_ERR("Failed to retrieve message from %s", handle->name);
+		return -ECANCELED;
+	}
+
+	/* The message, and so the reference to the audio data buffer, is kept until
+	 * audio_module_data_rx_release() is called.
+	 */
+	*audio_data = &msg_rx->audio_data;
+
+	return 0;
+}
+
+int audio_module_data_rx_release(struct audio_module_handle *handle,
+				 struct audio_data const *const audio_data)
+{
+	struct audio_module_message *msg_rx;
+
+	if (handle == NULL || audio_data == NULL) {
+		LOG_ERR("Module handle or audio data pointer are NULL");
+		return -EINVAL;
+	}
+
+	if (handle->thread.msg_tx == NULL) {
+		LOG_ERR("Module has message queue set to NULL");
+		return -ECANCELED;
+	}
+
+	msg_rx = CONTAINER_OF(audio_data, struct audio_module_message, audio_data);
+
+	if (msg_rx->response_cb != NULL) {
+		msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
+				    &msg_rx->audio_data);
+	}
+
+	data_fifo_block_free(handle->thread.msg_tx, (void *)msg_rx);
+
+	return 0;
+}
+
 int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 			    struct audio_module_handle *handle_rx,
 			    struct audio_data const *const audio_data_tx,
@@ -10,9 +10,10 @@
 #include <math.h>
 
 #include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <dsp/transform_functions.h>
-#include <dsp/fast_math_functions.h>
+#include <dsp/complex_math_functions.h>
 #include <dsp/statistics_functions.h>
 #include <arm_const_structs.h>
 #include <bluetooth/cs_de.h>
@@ -24,7 +25,7 @@ LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
 #define SPEED_OF_LIGHT_M_PER_S (299792458.0f)
 
 #define CHANNEL_INDEX_OFFSET (2)
-#define NUM_CHANNELS	     (75)
+#define NUM_CHANNELS	     (CS_DE_NUM_CHANNELS)
 
 #define TONE_QI_BAD_TONE_COUNT_THRESHOLD (4)
 
@@ -34,10 +35,19 @@ LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
 #define DMEYR		    (1)
 #define NORMAL_PEAK_TO_NULL ((CONFIG_BT_CS_DE_NFFT_SIZE + NUM_CHANNELS - 1) / (NUM_CHANNELS))
 
-static float m_iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
-static uint16_t m_n_iqs[CONFIG_BT_RAS_MAX_ANTENNA_PATHS][NUM_CHANNELS];
-static cs_de_tone_quality_t m_tone_quality_indicators[CONFIG_BT_RAS_MAX_ANTENNA_PATHS]
-						     [NUM_CHANNELS];
+#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
+#define CFFT_INSTANCE (&arm_cfft_sR_f32_len512)
+#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
+#define CFFT_INSTANCE (&arm_cfft_sR_f32_len1024)
+#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
+#define CFFT_INSTANCE (&arm_cfft_sR_f32_len2048)
+#else
+#error
+#endif
+
+/* Context for cs_de_populate_report() and cs_de_calc(), which take no context of their own. */
+static cs_de_stream_t m_stream;
+static K_MUTEX_DEFINE(m_stream_lock);
 
 static void calculate_vec_cmac_f(float *iq_result, const float *i_1, const float *q_1,
 				 const float *i_2, const float *q_2)
@@ -193,25 +203,13 @@ static void calculate_dist_ifft(float *dist, float iq_tones_comb[2 * CONFIG_BT_C
 		}
 	}
 
-#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
-	arm_cfft_f32(&arm_cfft_sR_f32_len512, iq_tones_comb, 0, 1);
-#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
-	arm_cfft_f32(&arm_cfft_sR_f32_len1024, iq_tones_comb, 0, 1);
-#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
-	arm_cfft_f32(&arm_cfft_sR_f32_len2048, iq_tones_comb, 0, 1);
-#else
-#error
-#endif
+	/* The constant instance shares its twiddle and bit reversal tables between all calls. */
+	arm_cfft_f32(CFFT_INSTANCE, iq_tones_comb, 0, 1);
 
 	/* Compute the magnitude of iq_tones_comb[0:2*CONFIG_BT_CS_DE_NFFT_SIZE - 1], store output
 	 * in iq_tones_comb[0:CONFIG_BT_CS_DE_NFFT_SIZE - 1]
 	 */
-	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
-		float realIn = iq_tones_comb[2 * n];
-		float imagIn = iq_tones_comb[(2 * n) + 1];
-
-		arm_sqrt_f32((realIn * realIn) + (imagIn * imagIn), &iq_tones_comb[n]);
-	}
+	arm_cmplx_mag_f32(iq_tones_comb, iq_tones_comb, CONFIG_BT_CS_DE_NFFT_SIZE);
 	/* Reverse the elements in iq_tones_comb[0:CONFIG_BT_CS_DE_NFFT_SIZE-1] */
 	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE / 2; n++) {
 		float temp = iq_tones_comb[n];
@@ -298,11 +296,17 @@ static void cumulate_mean(float *avg, float new_value, uint16_t *N)
 	*avg = a * new_value + b * (*avg);
 }
 
-static void extract_pcts(cs_de_report_t *p_report, uint8_t channel_index,
+static void extract_pcts(cs_de_stream_t *p_stream, uint8_t channel_index,
 			 uint8_t antenna_permutation_index,
 			 struct bt_hci_le_cs_step_data_tone_info *local_tone_info,
 			 struct bt_hci_le_cs_step_data_tone_info *remote_tone_info)
 {
+	cs_de_report_t *p_report = p_stream->p_report;
+
+	if (channel_index >= NUM_CHANNELS) {
+		LOG_WRN("Invalid channel index.");
+		return;
+	}
 
 	for (uint8_t tone_index = 0; tone_index < p_report->n_ap; tone_index++) {
 		int antenna_path = bt_le_cs_get_antenna_path(p_report->n_ap,
@@ -324,23 +328,25 @@ static void extract_pcts(cs_de_report_t *p_report, uint8_t channel_index,
 		struct bt_le_cs_iq_sample remote_iq =
 			bt_le_cs_parse_pct(remote_tone_info[antenna_path].phase_correction_term);
 
-		m_n_iqs[antenna_path][channel_index]++;
-		m_tone_quality_indicators[antenna_path][channel_index] = CS_DE_TONE_QUALITY_OK;
+		uint16_t *p_n_iqs = &p_stream->n_iqs[antenna_path][channel_index];
 
-		if (m_n_iqs[antenna_path][channel_index] == 1) {
+		(*p_n_iqs)++;
+		p_stream->tone_quality[antenna_path][channel_index] = CS_DE_TONE_QUALITY_OK;
+
+		if (*p_n_iqs == 1) {
 			p_report->iq_tones[antenna_path].i_local[channel_index] = local_iq.i;
 			p_report->iq_tones[antenna_path].q_local[channel_index] = local_iq.q;
 			p_report->iq_tones[antenna_path].i_remote[channel_index] = remote_iq.i;
 			p_report->iq_tones[antenna_path].q_remote[channel_index] = remote_iq.q;
 		} else {
 			cumulate_mean(&p_report->iq_tones[antenna_path].i_local[channel_index],
-				      local_iq.i, &m_n_iqs[antenna_path][channel_index]);
+				      local_iq.i, p_n_iqs);
 			cumulate_mean(&p_report->iq_tones[antenna_path].q_local[channel_index],
-				      local_iq.q, &m_n_iqs[antenna_path][channel_index]);
+				      local_iq.q, p_n_iqs);
 			cumulate_mean(&p_report->iq_tones[antenna_path].i_remote[channel_index],
-				      remote_iq.i, &m_n_iqs[antenna_path][channel_index]);
+				      remote_iq.i, p_n_iqs);
 			cumulate_mean(&p_report->iq_tones[antenna_path].q_remote[channel_index],
-				      remote_iq.q, &m_n_iqs[antenna_path][channel_index]);
+				      remote_iq.q, p_n_iqs);
 		}
 	}
 }
@@ -373,7 +379,8 @@ static void extract_rtt_timings(cs_de_report_t *p_report,
 
 static bool process_ranging_header(struct ras_ranging_header *ranging_header, void *user_data)
 {
-	cs_de_report_t *p_report = (cs_de_report_t *)user_data;
+	cs_de_stream_t *p_stream = (cs_de_stream_t *)user_data;
+	cs_de_report_t *p_report = p_stream->p_report;
 
 	p_report->n_ap = ((ranging_header->antenna_paths_mask & BIT(0)) +
 			  ((ranging_header->antenna_paths_mask & BIT(1)) >> 1) +
@@ -385,7 +392,15 @@ static bool process_ranging_header(struct ras_ranging_header *ranging_header, vo
 static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
 			      struct bt_le_cs_subevent_step *peer_step, void *user_data)
 {
-	cs_de_report_t *p_report = (cs_de_report_t *)user_data;
+	cs_de_stream_step_add((cs_de_stream_t *)user_data, local_step, peer_step);
+
+	return true;
+}
+
+void cs_de_stream_step_add(cs_de_stream_t *p_stream, struct bt_le_cs_subevent_step *local_step,
+			   struct bt_le_cs_subevent_step *peer_step)
+{
+	cs_de_report_t *p_report = p_stream->p_report;
 
 	if (local_step->mode == BT_CONN_LE_CS_MAIN_MODE_2) {
 		struct bt_hci_le_cs_step_data_mode_2 *local_step_data =
@@ -393,7 +408,7 @@ static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
 		struct bt_hci_le_cs_step_data_mode_2 *peer_step_data =
 			(struct bt_hci_le_cs_step_data_mode_2 *)peer_step->data;
 
-		extract_pcts(p_report, local_step->channel - CHANNEL_INDEX_OFFSET,
+		extract_pcts(p_stream, local_step->channel - CHANNEL_INDEX_OFFSET,
 			     local_step_data->antenna_permutation_index, local_step_data->tone_info,
 			     peer_step_data->tone_info);
 	} else if (local_step->mode == BT_HCI_OP_LE_CS_MAIN_MODE_1) {
@@ -409,7 +424,7 @@ static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
 		struct bt_hci_le_cs_step_data_mode_3 *peer_step_data =
 			(struct bt_hci_le_cs_step_data_mode_3 *)peer_step->data;
 
-		extract_pcts(p_report, local_step->channel - CHANNEL_INDEX_OFFSET,
+		extract_pcts(p_stream, local_step->channel - CHANNEL_INDEX_OFFSET,
 			     local_step_data->antenna_permutation_index, local_step_data->tone_info,
 			     peer_step_data->tone_info);
 
@@ -417,22 +432,36 @@ static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
 				    (struct bt_hci_le_cs_step_data_mode_1 *)local_step_data,
 				    (struct bt_hci_le_cs_step_data_mode_1 *)peer_step_data);
 	}
-
-	return true;
 }
 
-void cs_de_populate_report(struct net_buf_simple *local_steps, struct net_buf_simple *peer_steps,
-			   enum bt_conn_le_cs_role role, cs_de_report_t *p_report)
+void cs_de_stream_begin(cs_de_stream_t *p_stream, enum bt_conn_le_cs_role role, uint8_t n_ap,
+			cs_de_report_t *p_report)
 {
 	memset(p_report, 0x0, sizeof(*p_report));
-	memset(m_n_iqs, 0, sizeof(m_n_iqs));
-	memset(m_tone_quality_indicators, CS_DE_TONE_QUALITY_BAD,
-	       sizeof(m_tone_quality_indicators));
+	memset(p_stream->n_iqs, 0, sizeof(p_stream->n_iqs));
+
+	for (uint8_t ap = 0; ap < CONFIG_BT_RAS_MAX_ANTENNA_PATHS; ap++) {
+		for (uint8_t n = 0; n < NUM_CHANNELS; n++) {
+			p_stream->tone_quality[ap][n] = CS_DE_TONE_QUALITY_BAD;
+		}
+	}
 
+	p_stream->p_report = p_report;
 	p_report->role = role;
+	p_report->n_ap = MIN(n_ap, CONFIG_BT_RAS_MAX_ANTENNA_PATHS);
+}
 
-	bt_ras_rreq_rd_subevent_data_parse(peer_steps, local_steps, role, process_ranging_header,
-					   NULL, process_step_data, p_report);
+void cs_de_stream_ranging_data_add(cs_de_stream_t *p_stream, struct net_buf_simple *local_steps,
+				   struct net_buf_simple *peer_steps)
+{
+	bt_ras_rreq_rd_subevent_data_parse(peer_steps, local_steps, p_stream->p_report->role,
+					   process_ranging_header, NULL, process_step_data,
+					   p_stream);
+}
+
+void cs_de_stream_end(cs_de_stream_t *p_stream)
+{
+	cs_de_report_t *p_report = p_stream->p_report;
 
 	for (uint8_t ap = 0; ap < p_report->n_ap; ap++) {
 		p_report->distance_estimates[ap].ifft = NAN;
@@ -440,7 +469,7 @@ void cs_de_populate_report(struct net_buf_simple *local_steps, struct net_buf_si
 		p_report->distance_estimates[ap].rtt = NAN;
 		p_report->distance_estimates[ap].best = NAN;
 
-		if (m_is_tone_quality_bad(&m_tone_quality_indicators[ap][0])) {
+		if (m_is_tone_quality_bad(&p_stream->tone_quality[ap][0])) {
 			p_report->tone_quality[ap] = CS_DE_TONE_QUALITY_BAD;
 		} else {
 			p_report->tone_quality[ap] = CS_DE_TONE_QUALITY_OK;
@@ -448,7 +477,20 @@ void cs_de_populate_report(struct net_buf_simple *local_steps, struct net_buf_si
 	}
 }
 
-cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
+void cs_de_populate_report(struct net_buf_simple *local_steps, struct net_buf_simple *peer_steps,
+			   enum bt_conn_le_cs_role role, cs_de_report_t *p_report)
+{
+	k_mutex_lock(&m_stream_lock, K_FOREVER);
+
+	cs_de_stream_begin(&m_stream, role, 0, p_report);
+	cs_de_stream_ranging_data_add(&m_stream, local_steps, peer_steps);
+	cs_de_stream_end(&m_stream);
+
+	k_mutex_unlock(&m_stream_lock);
+}
+
+static cs_de_quality_t calc(cs_de_report_t *p_report,
+			    float iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	cs_de_quality_t estimation_quality[CONFIG_BT_RAS_MAX_ANTENNA_PATHS];
 
@@ -462,18 +504,21 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
 			continue;
 		}
 
-		memset(m_iq_scratch_mem, 0, sizeof(m_iq_scratch_mem));
+		/* Combine init and refl IQ values and store in scratch mem. Only the zero padding
+		 * needs to be cleared, as the tones overwrite the start of the buffer.
+		 */
+		memset(&iq_scratch_mem[2 * NUM_CHANNELS], 0,
+		       (2 * (CONFIG_BT_CS_DE_NFFT_SIZE - NUM_CHANNELS)) * sizeof(float));
 
-		/* Combine init and refl IQ values and store in scratch mem. */
-		calculate_vec_cmac_f(m_iq_scratch_mem, p_report->iq_tones[ap].i_remote,
+		calculate_vec_cmac_f(iq_scratch_mem, p_report->iq_tones[ap].i_remote,
 				     p_report->iq_tones[ap].q_remote,
 				     p_report->iq_tones[ap].i_local,
 				     p_report->iq_tones[ap].q_local);
 
 		calculate_dist_d_spaced_kay_f(&p_report->distance_estimates[ap].phase_slope,
-					      m_iq_scratch_mem, DMEYR);
+					      iq_scratch_mem, DMEYR);
 
-		calculate_dist_ifft(&p_report->distance_estimates[ap].ifft, m_iq_scratch_mem);
+		calculate_dist_ifft(&p_report->distance_estimates[ap].ifft, iq_scratch_mem);
 
 		estimation_quality[ap] = set_best_estimate(&p_report->distance_estimates[ap]);
 	}
@@ -486,3 +531,19 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
 
 	return CS_DE_QUALITY_DO_NOT_USE;
 }
+
+cs_de_quality_t cs_de_stream_calc(cs_de_stream_t *p_stream)
+{
+	return calc(p_stream->p_report, p_stream->iq_scratch_mem);
+}
+
+cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
+{
+	cs_de_quality_t quality;
+
+	k_mutex_lock(&m_stream_lock, K_FOREVER);
+	quality = calc(p_report, m_stream.iq_scratch_mem);
+	k_mutex_unlock(&m_stream_lock);
+
+	return quality;
+}
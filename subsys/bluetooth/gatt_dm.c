@@ -7,6 +7,11 @@
 #include <inttypes.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+#include <zephyr/net_buf.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/bluetooth/conn.h>
+#endif
 
 #include <bluetooth/gatt_dm.h>
 
@@ -40,13 +45,52 @@ static int gatt_dm_wq_init(void)
 SYS_INIT(gatt_dm_wq_init, POST_KERNEL, CONFIG_BT_GATT_DM_WORKQ_INIT_PRIO);
 #endif
 
+static void dm_work_submit(struct k_work *work)
+{
+#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
+	k_work_submit_to_queue(&bt_gatt_dm_wq, work);
+#else
+	k_work_submit(work);
+#endif
+}
+
 /* Flags for parsed attribute array state */
 enum {
 	STATE_ATTRS_LOCKED,
 	STATE_ATTRS_RELEASE_PENDING,
+	STATE_CACHE_SAVE_PENDING,
 	STATE_NUM
 };
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+#define CACHE_SETTINGS_PREFIX "bt/dm"
+#define CACHE_VERSION 1
+#define CACHE_HASH_LEN 16
+
+/* Type and value of the largest UUID */
+#define CACHE_UUID_MAX_LEN (1 + BT_UUID_SIZE_128)
+
+/* Handle, permissions and UUID of an attribute, followed by the handle,
+ * properties and UUID of the characteristic or service value.
+ */
+#define CACHE_ATTR_MAX_LEN (2 * (sizeof(uint16_t) + 1 + CACHE_UUID_MAX_LEN))
+
+/* Version, database hash and attribute count, followed by the attributes */
+#define CACHE_RECORD_MAX_LEN \
+	(1 + CACHE_HASH_LEN + sizeof(uint16_t) + \
+	 CONFIG_BT_GATT_DM_MAX_ATTRS * CACHE_ATTR_MAX_LEN)
+
+/* "bt/dm/", peer address type and value, '/' and 128-bit service UUID */
+#define CACHE_KEY_LEN \
+	(sizeof(CACHE_SETTINGS_PREFIX) + 2 + 2 * sizeof(bt_addr_t) + 1 + \
+	 2 * BT_UUID_SIZE_128 + 1)
+
+/* Record of the service that was last discovered, kept until it is stored */
+static char cache_save_key[CACHE_KEY_LEN];
+static uint8_t cache_record_data[CACHE_RECORD_MAX_LEN];
+static size_t cache_record_len;
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 /* One item in linked list containing dynamically allocated user data chunks */
 struct data_chunk_item {
 	/* Required by the sys_slist */
@@ -92,6 +136,24 @@ struct bt_gatt_dm {
 
 	/* Work item used for discovery callbacks. */
 	struct k_work discover_work;
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* Parameters for reading the peer database hash. */
+	struct bt_gatt_read_params hash_read_params;
+
+	/* Work item used for looking up the cache. */
+	struct k_work cache_work;
+
+	/* Bonded peer whose services are cached. */
+	bt_addr_le_t cache_peer;
+
+	/* Database hash of the peer, if cache_hash_valid is set. */
+	uint8_t cache_hash[CACHE_HASH_LEN];
+	bool cache_hash_valid;
+
+	/* Set if the attributes were loaded from the cache. */
+	bool cache_hit;
+#endif /* CONFIG_BT_GATT_DM_CACHE */
 };
 
 /* Currently only one instance is supported */
@@ -268,9 +330,16 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+static void cache_store(struct bt_gatt_dm *dm);
+#endif
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	cache_store(dm);
+#endif
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -373,11 +442,7 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 	dm->discover_params.start_handle = cur_attr->handle + 1;
 	LOG_DBG("Starting descriptors discovery");
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-	k_work_submit(&dm->discover_work);
-#endif
+	dm_work_submit(&dm->discover_work);
 
 	return BT_GATT_ITER_STOP;
 }
@@ -396,11 +461,7 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 			dm->discover_params.type =
 				BT_GATT_DISCOVER_CHARACTERISTIC;
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-			k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-			k_work_submit(&dm->discover_work);
-#endif
+			dm_work_submit(&dm->discover_work);
 		} else {
 			discovery_complete(dm);
 		}
@@ -633,6 +694,487 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
 	return curr;
 }
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+static void cache_key_make(char *key, size_t key_size, const bt_addr_le_t *addr,
+			   const struct bt_uuid *uuid)
+{
+	size_t len;
+
+	len = snprintk(key, key_size, CACHE_SETTINGS_PREFIX "/%02x", addr->type);
+	len += bin2hex(addr->a.val, sizeof(addr->a.val), &key[len], key_size - len);
+
+	if (!uuid) {
+		return;
+	}
+
+	key[len++] = '/';
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		snprintk(&key[len], key_size - len, "%04x", BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		snprintk(&key[len], key_size - len, "%08x", BT_UUID_32(uuid)->val);
+		break;
+	case BT_UUID_TYPE_128:
+		bin2hex(BT_UUID_128(uuid)->val, BT_UUID_SIZE_128, &key[len], key_size - len);
+		break;
+	default:
+		key[len] = '\0';
+		break;
+	}
+}
+
+static void cache_uuid_encode(struct net_buf_simple *buf, const struct bt_uuid *uuid)
+{
+	net_buf_simple_add_u8(buf, uuid->type);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		net_buf_simple_add_le16(buf, BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		net_buf_simple_add_le32(buf, BT_UUID_32(uuid)->val);
+		break;
+	default:
+		net_buf_simple_add_mem(buf, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		break;
+	}
+}
+
+static int cache_uuid_decode(struct net_buf_simple *buf, struct bt_uuid_128 *uuid)
+{
+	size_t len;
+
+	if (buf->len < 1) {
+		return -EINVAL;
+	}
+
+	switch (net_buf_simple_pull_u8(buf)) {
+	case BT_UUID_TYPE_16:
+		len = BT_UUID_SIZE_16;
+		break;
+	case BT_UUID_TYPE_32:
+		len = BT_UUID_SIZE_32;
+		break;
+	case BT_UUID_TYPE_128:
+		len = BT_UUID_SIZE_128;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((buf->len < len) ||
+	    !bt_uuid_create(&uuid->uuid, net_buf_simple_pull_mem(buf, len), len)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void cache_save_work_handler(struct k_work *work)
+{
+	int err;
+
+	err = settings_save_one(cache_save_key, cache_record_data, cache_record_len);
+	if (err) {
+		LOG_WRN("Failed to store discovery cache, error: %d", err);
+	} else {
+		LOG_DBG("Stored %s", cache_save_key);
+	}
+
+	atomic_clear_bit(bt_gatt_dm_inst.state_flags, STATE_CACHE_SAVE_PENDING);
+}
+
+static K_WORK_DEFINE(cache_save_work, cache_save_work_handler);
+
+/* Serializes the discovered service and stores it from the work queue. */
+static void cache_store(struct bt_gatt_dm *dm)
+{
+	struct net_buf_simple buf;
+
+	if (!dm->cache_hash_valid || dm->cache_hit) {
+		return;
+	}
+
+	/* Only one record is kept for storing, skip this one if the last one
+	 * has not been stored yet.
+	 */
+	if (atomic_test_and_set_bit(dm->state_flags, STATE_CACHE_SAVE_PENDING)) {
+		LOG_DBG("Discovery cache busy");
+		return;
+	}
+
+	net_buf_simple_init_with_data(&buf, cache_record_data, sizeof(cache_record_data));
+	net_buf_simple_reset(&buf);
+
+	net_buf_simple_add_u8(&buf, CACHE_VERSION);
+	net_buf_simple_add_mem(&buf, dm->cache_hash, sizeof(dm->cache_hash));
+	net_buf_simple_add_le16(&buf, dm->cur_attr_id);
+
+	for (size_t i = 0; i < dm->cur_attr_id; i++) {
+		const struct bt_gatt_dm_attr *attr = &dm->attrs[i];
+		const struct bt_gatt_service_val *service_val = bt_gatt_dm_attr_service_val(attr);
+		const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+
+		net_buf_simple_add_le16(&buf, attr->handle);
+		net_buf_simple_add_u8(&buf, attr->perm);
+		cache_uuid_encode(&buf, attr->uuid);
+
+		if (service_val) {
+			net_buf_simple_add_le16(&buf, service_val->end_handle);
+			cache_uuid_encode(&buf, service_val->uuid);
+		} else if (chrc) {
+			net_buf_simple_add_le16(&buf, chrc->value_handle);
+			net_buf_simple_add_u8(&buf, chrc->properties);
+			cache_uuid_encode(&buf, chrc->uuid);
+		}
+	}
+
+	cache_record_len = buf.len;
+	cache_key_make(cache_save_key, sizeof(cache_save_key), &dm->cache_peer,
+		       &dm->svc_uuid.uuid);
+
+	dm_work_submit(&cache_save_work);
+}
+
+/* Restores the attributes of a service from a cache record. */
+static int cache_record_restore(struct bt_gatt_dm *dm, struct net_buf_simple *buf)
+{
+	uint16_t attr_cnt;
+
+	if ((buf->len < (1 + CACHE_HASH_LEN + sizeof(uint16_t))) ||
+	    (net_buf_simple_pull_u8(buf) != CACHE_VERSION)) {
+		return -EINVAL;
+	}
+
+	if (memcmp(net_buf_simple_pull_mem(buf, CACHE_HASH_LEN), dm->cache_hash,
+		   CACHE_HASH_LEN) != 0) {
+		LOG_DBG("Peer database has changed");
+		return -ESTALE;
+	}
+
+	attr_cnt = net_buf_simple_pull_le16(buf);
+	if ((attr_cnt == 0) || (attr_cnt > ARRAY_SIZE(dm->attrs))) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < attr_cnt; i++) {
+		struct bt_uuid_128 attr_uuid;
+		struct bt_uuid_128 val_uuid;
+		struct bt_gatt_attr attr = {
+			.uuid = &attr_uuid.uuid,
+		};
+		struct bt_gatt_dm_attr *cur_attr;
+		struct bt_gatt_service_val *service_val;
+		struct bt_gatt_chrc *chrc;
+		uint16_t val_handle = 0;
+		uint8_t properties = 0;
+		bool is_service;
+		bool is_chrc;
+
+		if (buf->len < (sizeof(uint16_t) + 1)) {
+			return -EINVAL;
+		}
+
+		attr.handle = net_buf_simple_pull_le16(buf);
+		attr.perm = net_buf_simple_pull_u8(buf);
+
+		if (cache_uuid_decode(buf, &attr_uuid)) {
+			return -EINVAL;
+		}
+
+		is_service = !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) ||
+			     !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY);
+		is_chrc = !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC);
+
+		if (is_service || is_chrc) {
+			if (buf->len < sizeof(uint16_t)) {
+				return -EINVAL;
+			}
+
+			val_handle = net_buf_simple_pull_le16(buf);
+
+			if (is_chrc) {
+				if (buf->len < 1) {
+					return -EINVAL;
+				}
+
+				properties = net_buf_simple_pull_u8(buf);
+			}
+
+			if (cache_uuid_decode(buf, &val_uuid)) {
+				return -EINVAL;
+			}
+		}
+
+		if (is_service) {
+			cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+			if (!cur_attr) {
+				return -ENOMEM;
+			}
+
+			service_val = bt_gatt_dm_attr_service_val(cur_attr);
+			service_val->end_handle = val_handle;
+			service_val->uuid = uuid_store(dm, &val_uuid.uuid);
+			if (!service_val->uuid) {
+				return -ENOMEM;
+			}
+		} else if (is_chrc) {
+			cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+			if (!cur_attr) {
+				return -ENOMEM;
+			}
+
+			chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+			chrc->value_handle = val_handle;
+			chrc->properties = properties;
+			chrc->uuid = uuid_store(dm, &val_uuid.uuid);
+			if (!chrc->uuid) {
+				return -ENOMEM;
+			}
+		} else if (!attr_store(dm, &attr, 0)) {
+			return -ENOMEM;
+		}
+	}
+
+	/* The first attribute is the service. */
+	if (!bt_gatt_dm_attr_service_val(&dm->attrs[0])) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+struct cache_load_ctx {
+	struct bt_gatt_dm *dm;
+	int err;
+};
+
+static int cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct cache_load_ctx *ctx = param;
+	struct net_buf_simple buf;
+	ssize_t size;
+
+	/* Only the record of the service itself, not of anything below it. */
+	if (key) {
+		return 0;
+	}
+
+	if (len > sizeof(cache_record_data)) {
+		ctx->err = -ENOMEM;
+		return 0;
+	}
+
+	/* The record buffer is shared with storing. */
+	if (atomic_test_and_set_bit(ctx->dm->state_flags, STATE_CACHE_SAVE_PENDING)) {
+		ctx->err = -EBUSY;
+		return 0;
+	}
+
+	size = read_cb(cb_arg, cache_record_data, len);
+	if (size != (ssize_t)len) {
+		ctx->err = -EIO;
+	} else {
+		net_buf_simple_init_with_data(&buf, cache_record_data, size);
+		ctx->err = cache_record_restore(ctx->dm, &buf);
+	}
+
+	atomic_clear_bit(ctx->dm->state_flags, STATE_CACHE_SAVE_PENDING);
+
+	return 0;
+}
+
+static void cache_work_handler(struct k_work *work)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(work, struct bt_gatt_dm, cache_work);
+	struct cache_load_ctx ctx = {
+		.dm = dm,
+		.err = -ENOENT,
+	};
+	char key[CACHE_KEY_LEN];
+	int err;
+
+	if (!atomic_test_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+		LOG_WRN("Attributes not locked");
+		return;
+	}
+
+	if (dm->cache_hash_valid) {
+		cache_key_make(key, sizeof(key), &dm->cache_peer, &dm->svc_uuid.uuid);
+
+		err = settings_load_subtree_direct(key, cache_load_cb, &ctx);
+		if (!err && !ctx.err) {
+			LOG_DBG("Service loaded from cache");
+
+			dm->cache_hit = true;
+			/* Same state as after discovering the service over the air,
+			 * so that bt_gatt_dm_continue() can be used.
+			 */
+			dm->discover_params.uuid = NULL;
+			dm->discover_params.end_handle =
+				bt_gatt_dm_attr_service_val(&dm->attrs[0])->end_handle;
+			discovery_complete(dm);
+			return;
+		}
+
+		LOG_DBG("No cached service, error: %d", err ? err : ctx.err);
+
+		/* Drop anything restored from a partial record. */
+		svc_attr_memory_release(dm);
+	}
+
+	/* Discover the service from the peer. */
+	gatt_discover_work(&dm->discover_work);
+}
+
+static uint8_t cache_hash_read_cb(struct bt_conn *conn, uint8_t err,
+				  struct bt_gatt_read_params *params,
+				  const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, hash_read_params);
+
+	if (!err && data && (length == CACHE_HASH_LEN)) {
+		memcpy(dm->cache_hash, data, CACHE_HASH_LEN);
+		dm->cache_hash_valid = true;
+	} else {
+		LOG_DBG("Database hash not available, error: %u", err);
+	}
+
+	dm_work_submit(&dm->cache_work);
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Starts reading the database hash of a bonded peer.
+ * Returns 0 if the discovery continues from the read callback.
+ */
+static int cache_discovery_start(struct bt_gatt_dm *dm)
+{
+	struct bt_conn_info info;
+	int err;
+
+	dm->cache_hash_valid = false;
+	dm->cache_hit = false;
+
+	if (!dm->search_svc_by_uuid) {
+		return -ENOTSUP;
+	}
+
+	err = bt_conn_get_info(dm->conn, &info);
+	if (err) {
+		return err;
+	}
+
+	if ((info.type != BT_CONN_TYPE_LE) || !bt_addr_le_is_bonded(info.id, info.le.dst)) {
+		return -ENOTSUP;
+	}
+
+	bt_addr_le_copy(&dm->cache_peer, info.le.dst);
+
+	k_work_init(&dm->cache_work, cache_work_handler);
+
+	dm->hash_read_params.func = cache_hash_read_cb;
+	dm->hash_read_params.handle_count = 0;
+	dm->hash_read_params.by_uuid.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	dm->hash_read_params.by_uuid.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	dm->hash_read_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	return bt_gatt_read(dm->conn, &dm->hash_read_params);
+}
+
+struct cache_delete_ctx {
+	char names[4][2 * BT_UUID_SIZE_128 + 1];
+	size_t cnt;
+};
+
+static int cache_delete_cb(const char *key, size_t len, settings_read_cb read_cb,
+			   void *cb_arg, void *param)
+{
+	struct cache_delete_ctx *ctx = param;
+
+	if (!key || (ctx->cnt >= ARRAY_SIZE(ctx->names))) {
+		return 0;
+	}
+
+	strncpy(ctx->names[ctx->cnt], key, sizeof(ctx->names[0]) - 1);
+	ctx->names[ctx->cnt][sizeof(ctx->names[0]) - 1] = '\0';
+	ctx->cnt++;
+
+	return 0;
+}
+
+int bt_gatt_dm_cache_delete(const bt_addr_le_t *addr)
+{
+	char prefix[CACHE_KEY_LEN];
+	char key[CACHE_KEY_LEN];
+	struct cache_delete_ctx ctx;
+	int err;
+
+	if (!addr) {
+		return -EINVAL;
+	}
+
+	cache_key_make(prefix, sizeof(prefix), addr, NULL);
+
+	/* Settings entries cannot be deleted while loading them,
+	 * so collect a few names at a time.
+	 */
+	do {
+		ctx.cnt = 0;
+
+		err = settings_load_subtree_direct(prefix, cache_delete_cb, &ctx);
+		if (err) {
+			return err;
+		}
+
+		for (size_t i = 0; i < ctx.cnt; i++) {
+			snprintk(key, sizeof(key), "%s/%s", prefix, ctx.names[i]);
+
+			err = settings_delete(key);
+			if (err) {
+				return err;
+			}
+		}
+	} while (ctx.cnt == ARRAY_SIZE(ctx.names));
+
+	return 0;
+}
+
+static void cache_bond_deleted(uint8_t id, const bt_addr_le_t *peer)
+{
+	int err;
+
+	err = bt_gatt_dm_cache_delete(peer);
+	if (err) {
+		LOG_WRN("Failed to delete discovery cache, error: %d", err);
+	}
+}
+
+static struct bt_conn_auth_info_cb cache_auth_info_cb = {
+	.bond_deleted = cache_bond_deleted,
+};
+
+static int cache_settings_set(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg)
+{
+	/* Records are read when needed, see cache_work_handler(). */
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bt_gatt_dm, CACHE_SETTINGS_PREFIX, NULL, cache_settings_set,
+			       NULL, NULL);
+
+static int cache_init(void)
+{
+	return bt_conn_auth_info_cb_register(&cache_auth_info_cb);
+}
+
+SYS_INIT(cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 int bt_gatt_dm_start(struct bt_conn *conn,
 		     const struct bt_uuid *svc_uuid,
 		     const struct bt_gatt_dm_cb *cb,
@@ -679,6 +1221,13 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	k_work_init(&dm->discover_work, gatt_discover_work);
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* For bonded peers, the discovery continues once the database hash is read. */
+	if (!cache_discovery_start(dm)) {
+		return 0;
+	}
+#endif
+
 	err = bt_gatt_discover(conn, &dm->discover_params);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
@@ -717,6 +1266,10 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	}
 
 	dm->context = context;
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* Only the first instance of a service is cached. */
+	dm->cache_hash_valid = false;
+#endif
 	dm->discover_params.start_handle = dm->discover_params.end_handle + 1;
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
@@ -18,6 +18,24 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
 
+/* Filters that are matched against the advertising data. */
+#define AD_FILTERS (MODE_CHECK & ~BT_SCAN_ADDR_FILTER)
+
+BUILD_ASSERT(CONFIG_BT_SCAN_ADDRESS_CNT < UINT16_MAX,
+	     "Up to 65534 address filters are supported");
+BUILD_ASSERT(CONFIG_BT_SCAN_UUID_CNT < UINT8_MAX,
+	     "Up to 254 UUID filters are supported");
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+/* Use at least one hash bucket for every two filters, so that the
+ * average chain stays short however many filters are configured.
+ */
+#define ADDR_INDEX_BUCKETS \
+	MAX(CONFIG_BT_SCAN_FILTER_INDEX_BUCKETS, CONFIG_BT_SCAN_ADDRESS_CNT / 2)
+#define UUID_INDEX_BUCKETS \
+	MAX(CONFIG_BT_SCAN_FILTER_INDEX_BUCKETS, CONFIG_BT_SCAN_UUID_CNT / 2)
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 /* Scan filter mutex. */
 K_MUTEX_DEFINE(scan_mutex);
 
@@ -28,6 +46,12 @@ struct bt_scan_control {
 	/* Number of active filters. */
 	uint8_t filter_cnt;
 
+	/* Types of the active filters. */
+	uint8_t filter_enabled;
+
+	/* Types of the filters matched so far. */
+	uint8_t filter_matched;
+
 	/* Number of matched filters. */
 	uint8_t filter_match_cnt;
 
@@ -45,6 +69,9 @@ struct bt_scan_control {
 
 	/* Scan filter status. */
 	struct bt_scan_filter_match filter_status;
+
+	/* UUID filters found in the advertising data. */
+	bool uuid_found[CONFIG_BT_SCAN_UUID_CNT];
 };
 
 /* Name filter structure.
@@ -89,8 +116,16 @@ struct bt_scan_addr_filter {
 	/* Addresses advertised by the peripherals. */
 	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	/* First filter in each hash bucket, as index + 1. Zero ends the chain. */
+	uint16_t bucket[ADDR_INDEX_BUCKETS];
+
+	/* Next filter in the same hash bucket, as index + 1. */
+	uint16_t next[CONFIG_BT_SCAN_ADDRESS_CNT];
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 	/* Address filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
@@ -120,6 +155,14 @@ struct bt_scan_uuid_filter {
 	 */
 	struct bt_scan_uuid uuid[CONFIG_BT_SCAN_UUID_CNT];
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	/* First filter in each hash bucket, as index + 1. Zero ends the chain. */
+	uint16_t bucket[UUID_INDEX_BUCKETS];
+
+	/* Next filter in the same hash bucket, as index + 1. */
+	uint16_t next[CONFIG_BT_SCAN_UUID_CNT];
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 	/* UUID filter counter. */
 	uint8_t cnt;
 
@@ -425,11 +468,8 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
-	char addr_str[BT_ADDR_LE_STR_LEN];
 	bool attempts_exceeded = false;
 
-	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
-
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if the device is in the filter array. */
@@ -438,8 +478,13 @@ static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 
 		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
 			if (device->attempts >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				LOG_DBG("Connection attempts count for %s exceeded",
-					addr_str);
+				if (IS_ENABLED(CONFIG_BT_SCAN_LOG_LEVEL_DBG)) {
+					char addr_str[BT_ADDR_LE_STR_LEN];
+
+					bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+					LOG_DBG("Connection attempts count for %s exceeded",
+						addr_str);
+				}
 				attempts_exceeded = true;
 			}
 
@@ -506,22 +551,81 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
-static bool adv_addr_compare(const bt_addr_le_t *target_addr,
-			     struct bt_scan_control *control)
+#if CONFIG_BT_SCAN_FILTER_INDEX
+static uint32_t filter_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+	/* FNV-1a */
+	for (size_t i = 0; i < len; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static void filter_index_link(uint16_t *bucket, uint16_t *next, uint16_t idx)
+{
+	next[idx] = *bucket;
+	*bucket = idx + 1;
+}
+
+static void filter_index_unlink(uint16_t *bucket, uint16_t *next, uint16_t idx)
+{
+	for (uint16_t *link = bucket; *link != 0; link = &next[*link - 1]) {
+		if (*link == (idx + 1)) {
+			*link = next[idx];
+			return;
+		}
+	}
+}
+
+static uint16_t *addr_bucket_get(const bt_addr_le_t *addr)
+{
+	uint32_t hash = filter_hash(2166136261U, &addr->type, sizeof(addr->type));
+
+	hash = filter_hash(hash, addr->a.val, sizeof(addr->a.val));
+
+	return &bt_scan.scan_filters.addr.bucket[hash % ADDR_INDEX_BUCKETS];
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+static int addr_filter_find(const bt_addr_le_t *target_addr)
 {
 	const bt_addr_le_t *addr =
 			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	for (uint16_t i = *addr_bucket_get(target_addr); i != 0;
+	     i = bt_scan.scan_filters.addr.next[i - 1]) {
+		if (bt_addr_le_cmp(target_addr, &addr[i - 1]) == 0) {
+			return i - 1;
+		}
+	}
+#else
+	uint16_t counter = bt_scan.scan_filters.addr.cnt;
 
 	for (size_t i = 0; i < counter; i++) {
 		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
-			control->filter_status.addr.addr = &addr[i];
-
-			return true;
+			return i;
 		}
 	}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 
-	return false;
+	return -ENOENT;
+}
+
+static bool adv_addr_compare(const bt_addr_le_t *target_addr,
+			     struct bt_scan_control *control)
+{
+	int idx = addr_filter_find(target_addr);
+
+	if (idx < 0) {
+		return false;
+	}
+
+	control->filter_status.addr.addr = &bt_scan.scan_filters.addr.target_addr[idx];
+
+	return true;
 }
 
 static bool is_addr_filter_enabled(void)
@@ -532,13 +636,11 @@ static bool is_addr_filter_enabled(void)
 static void check_addr(struct bt_scan_control *control,
 		       const bt_addr_le_t *addr)
 {
-	if (is_addr_filter_enabled()) {
+	if (control->filter_enabled & BT_SCAN_ADDR_FILTER) {
 		if (adv_addr_compare(addr, control)) {
-			control->filter_match_cnt++;
-
 			/* Information about the filters matched. */
 			control->filter_status.addr.match = true;
-			control->filter_match = true;
+			control->filter_matched |= BT_SCAN_ADDR_FILTER;
 		}
 	}
 }
@@ -548,7 +650,7 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	char addr[BT_ADDR_LE_STR_LEN];
 	bt_addr_le_t *addr_filter =
 			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	uint16_t counter = bt_scan.scan_filters.addr.cnt;
 
 	/* If no memory for filter. */
 	if (counter >= CONFIG_BT_SCAN_ADDRESS_CNT) {
@@ -556,15 +658,18 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	}
 
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr_filter[i]) == 0) {
-			return 0;
-		}
+	if (addr_filter_find(target_addr) >= 0) {
+		return 0;
 	}
 
 	/* Add target address to filter. */
 	bt_addr_le_copy(&addr_filter[counter], target_addr);
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	filter_index_link(addr_bucket_get(target_addr),
+			  bt_scan.scan_filters.addr.next, counter);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 	LOG_DBG("Filter set on address type %i",
 		addr_filter[counter].type);
 
@@ -578,6 +683,40 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	return 0;
 }
 
+static int scan_addr_filter_remove(const bt_addr_le_t *target_addr)
+{
+	struct bt_scan_addr_filter *addr_filter = &bt_scan.scan_filters.addr;
+	int idx = addr_filter_find(target_addr);
+	uint16_t last;
+
+	if (idx < 0) {
+		return idx;
+	}
+
+	last = addr_filter->cnt - 1;
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	filter_index_unlink(addr_bucket_get(&addr_filter->target_addr[idx]),
+			    addr_filter->next, idx);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+	/* Move the last filter into the freed slot. */
+	if (idx != last) {
+#if CONFIG_BT_SCAN_FILTER_INDEX
+		uint16_t *bucket = addr_bucket_get(&addr_filter->target_addr[last]);
+
+		filter_index_unlink(bucket, addr_filter->next, last);
+		filter_index_link(bucket, addr_filter->next, idx);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+		bt_addr_le_copy(&addr_filter->target_addr[idx],
+				&addr_filter->target_addr[last]);
+	}
+
+	addr_filter->cnt--;
+
+	return 0;
+}
+
 static bool adv_name_cmp(const uint8_t *data,
 			 uint8_t data_len,
 			 const char *target_name)
@@ -618,13 +757,11 @@ static inline bool is_name_filter_enabled(void)
 static void name_check(struct bt_scan_control *control,
 		       const struct bt_data *data)
 {
-	if (is_name_filter_enabled()) {
+	if (control->filter_enabled & BT_SCAN_NAME_FILTER) {
 		if (adv_name_compare(data, control)) {
-			control->filter_match_cnt++;
-
 			/* Information about the filters matched. */
 			control->filter_status.name.match = true;
-			control->filter_match = true;
+			control->filter_matched |= BT_SCAN_NAME_FILTER;
 		}
 	}
 }
@@ -711,13 +848,11 @@ static inline bool is_short_name_filter_enabled(void)
 static void short_name_check(struct bt_scan_control *control,
 			     const struct bt_data *data)
 {
-	if (is_short_name_filter_enabled()) {
+	if (control->filter_enabled & BT_SCAN_SHORT_NAME_FILTER) {
 		if (adv_short_name_compare(data, control)) {
-			control->filter_match_cnt++;
-
 			/* Information about the filters matched. */
 			control->filter_status.short_name.match = true;
-			control->filter_match = true;
+			control->filter_matched |= BT_SCAN_SHORT_NAME_FILTER;
 		}
 	}
 }
@@ -764,87 +899,108 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
-static bool find_uuid(const uint8_t *data,
-		      uint8_t data_len,
-		      uint8_t uuid_type,
-		      const struct bt_scan_uuid *target_uuid)
+#if CONFIG_BT_SCAN_FILTER_INDEX
+static uint16_t *uuid_bucket_get(const struct bt_uuid *uuid)
 {
-	uint8_t uuid_len;
+	uint32_t key;
+	uint8_t key_le[sizeof(key)];
 
-	switch (uuid_type) {
+	/* UUIDs of different sizes compare equal when they have the same 128-bit form.
+	 * Key on the 32 bits that hold the value of a 16-bit or 32-bit UUID, which
+	 * are also the most significant 32 bits of a 128-bit UUID.
+	 */
+	switch (uuid->type) {
 	case BT_UUID_TYPE_16:
-		uuid_len = sizeof(uint16_t);
+		key = BT_UUID_16(uuid)->val;
 		break;
 
 	case BT_UUID_TYPE_32:
-		uuid_len = sizeof(uint32_t);
-		break;
-
-	case BT_UUID_TYPE_128:
-		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
+		key = BT_UUID_32(uuid)->val;
 		break;
 
 	default:
-		return false;
+		key = sys_get_le32(&BT_UUID_128(uuid)->val[12]);
+		break;
 	}
 
-	for (size_t i = 0; i < data_len; i += uuid_len) {
-		struct bt_uuid_128 uuid;
+	sys_put_le32(key, key_le);
 
-		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
-			return false;
+	return &bt_scan.scan_filters.uuid.bucket[filter_hash(2166136261U, key_le, sizeof(key_le)) %
+						 UUID_INDEX_BUCKETS];
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+static int uuid_filter_find(const struct bt_uuid *uuid)
+{
+	const struct bt_scan_uuid *uuid_filter = bt_scan.scan_filters.uuid.uuid;
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	for (uint16_t i = *uuid_bucket_get(uuid); i != 0;
+	     i = bt_scan.scan_filters.uuid.next[i - 1]) {
+		if (bt_uuid_cmp(uuid, uuid_filter[i - 1].uuid) == 0) {
+			return i - 1;
 		}
+	}
+#else
+	uint8_t counter = bt_scan.scan_filters.uuid.cnt;
 
-		if (bt_uuid_cmp(&uuid.uuid, target_uuid->uuid) == 0) {
-			return true;
+	for (size_t i = 0; i < counter; i++) {
+		if (bt_uuid_cmp(uuid, uuid_filter[i].uuid) == 0) {
+			return i;
 		}
 	}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 
-	return false;
+	return -ENOENT;
 }
 
-static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
-			     struct bt_scan_control *control)
+static void adv_uuid_find(const struct bt_data *data, uint8_t uuid_type,
+			  struct bt_scan_control *control)
 {
 	const struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
-	const bool all_filters_mode = bt_scan.scan_filters.all_mode;
-	const uint8_t counter = bt_scan.scan_filters.uuid.cnt;
-	uint8_t data_len = data->data_len;
-	uint8_t uuid_match_cnt = 0;
+	struct bt_scan_uuid_filter_status *status =
+			&control->filter_status.uuid;
+	uint8_t uuid_len;
 
-	for (size_t i = 0; i < counter; i++) {
+	switch (uuid_type) {
+	case BT_UUID_TYPE_16:
+		uuid_len = sizeof(uint16_t);
+		break;
 
-		if (find_uuid(data->data, data_len, uuid_type,
-			      &uuid_filter->uuid[i])) {
-			control->filter_status.uuid.uuid[uuid_match_cnt] =
-				uuid_filter->uuid[i].uuid;
+	case BT_UUID_TYPE_32:
+		uuid_len = sizeof(uint32_t);
+		break;
 
-			uuid_match_cnt++;
+	case BT_UUID_TYPE_128:
+		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
+		break;
 
-			/* In the normal filter mode,
-			 * only one UUID is needed to match.
-			 */
-			if (!all_filters_mode) {
-				break;
-			}
+	default:
+		return;
+	}
 
-		} else if (all_filters_mode) {
-			break;
+	/* Look up each advertised UUID once. The matches of all UUID fields
+	 * of the advertising data are collected and evaluated in
+	 * uuid_result_check().
+	 */
+	for (size_t i = 0; (i + uuid_len) <= data->data_len; i += uuid_len) {
+		struct bt_uuid_128 uuid;
+		int idx;
+
+		if (!bt_uuid_create(&uuid.uuid, &data->data[i], uuid_len)) {
+			return;
 		}
-	}
 
-	control->filter_status.uuid.count = uuid_match_cnt;
+		idx = uuid_filter_find(&uuid.uuid);
+		if ((idx < 0) || control->uuid_found[idx]) {
+			continue;
+		}
 
-	/* In the multifilter mode, all UUIDs must be found in
-	 * the advertisement packets.
-	 */
-	if ((all_filters_mode && (uuid_match_cnt == counter)) ||
-	    ((!all_filters_mode) && (uuid_match_cnt > 0))) {
-		return true;
+		control->uuid_found[idx] = true;
+		status->uuid[status->count] = uuid_filter->uuid[idx].uuid;
+		status->count++;
 	}
-
-	return false;
 }
 
 static bool is_uuid_filter_enabled(void)
@@ -856,14 +1012,28 @@ static void uuid_check(struct bt_scan_control *control,
 		       const struct bt_data *data,
 		       uint8_t type)
 {
-	if (is_uuid_filter_enabled()) {
-		if (adv_uuid_compare(data, type, control)) {
-			control->filter_match_cnt++;
+	if (control->filter_enabled & BT_SCAN_UUID_FILTER) {
+		adv_uuid_find(data, type, control);
+	}
+}
 
-			/* Information about the filters matched. */
-			control->filter_status.uuid.match = true;
-			control->filter_match = true;
-		}
+static void uuid_result_check(struct bt_scan_control *control)
+{
+	uint8_t found = control->filter_status.uuid.count;
+
+	if (!(control->filter_enabled & BT_SCAN_UUID_FILTER)) {
+		return;
+	}
+
+	/* In the multifilter mode, all UUIDs must be found in
+	 * the advertisement packets. In the normal filter mode,
+	 * only one UUID is needed to match.
+	 */
+	if ((control->all_mode && (found == bt_scan.scan_filters.uuid.cnt)) ||
+	    ((!control->all_mode) && (found > 0))) {
+		/* Information about the filters matched. */
+		control->filter_status.uuid.match = true;
+		control->filter_matched |= BT_SCAN_UUID_FILTER;
 	}
 }
 
@@ -881,10 +1051,8 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 	}
 
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_uuid_cmp(uuid_filter[i].uuid, uuid) == 0) {
-			return 0;
-		}
+	if (uuid_filter_find(uuid) >= 0) {
+		return 0;
 	}
 
 	/* Add UUID to the filter. */
@@ -917,12 +1085,51 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 		return -EINVAL;
 	}
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	filter_index_link(uuid_bucket_get(uuid), bt_scan.scan_filters.uuid.next, counter);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 	bt_scan.scan_filters.uuid.cnt++;
 	LOG_DBG("Added filter on UUID type %x", uuid->type);
 
 	return 0;
 }
 
+static int scan_uuid_filter_remove(const struct bt_uuid *uuid)
+{
+	struct bt_scan_uuid_filter *uuid_filter = &bt_scan.scan_filters.uuid;
+	int idx = uuid_filter_find(uuid);
+	uint8_t last;
+
+	if (idx < 0) {
+		return idx;
+	}
+
+	last = uuid_filter->cnt - 1;
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	filter_index_unlink(uuid_bucket_get(uuid_filter->uuid[idx].uuid),
+			    uuid_filter->next, idx);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+	/* Move the last filter into the freed slot. */
+	if (idx != last) {
+#if CONFIG_BT_SCAN_FILTER_INDEX
+		uint16_t *bucket = uuid_bucket_get(uuid_filter->uuid[last].uuid);
+
+		filter_index_unlink(bucket, uuid_filter->next, last);
+		filter_index_link(bucket, uuid_filter->next, idx);
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+		uuid_filter->uuid[idx].uuid_data = uuid_filter->uuid[last].uuid_data;
+		uuid_filter->uuid[idx].uuid =
+				(struct bt_uuid *)&uuid_filter->uuid[idx].uuid_data;
+	}
+
+	uuid_filter->cnt--;
+
+	return 0;
+}
+
 static bool find_appearance(const uint8_t *data,
 			    uint8_t data_len,
 			    const uint16_t *appearance)
@@ -976,13 +1183,11 @@ static inline bool is_appearance_filter_enabled(void)
 static void appearance_check(struct bt_scan_control *control,
 			     const struct bt_data *data)
 {
-	if (is_appearance_filter_enabled()) {
+	if (control->filter_enabled & BT_SCAN_APPEARANCE_FILTER) {
 		if (adv_appearance_compare(data, control)) {
-			control->filter_match_cnt++;
-
 			/* Information about the filters matched. */
 			control->filter_status.appearance.match = true;
-			control->filter_match = true;
+			control->filter_matched |= BT_SCAN_APPEARANCE_FILTER;
 		}
 	}
 }
@@ -1063,13 +1268,11 @@ static inline bool is_manufacturer_data_filter_enabled(void)
 static void manufacturer_data_check(struct bt_scan_control *control,
 				    const struct bt_data *data)
 {
-	if (is_manufacturer_data_filter_enabled()) {
+	if (control->filter_enabled & BT_SCAN_MANUFACTURER_DATA_FILTER) {
 		if (adv_manufacturer_data_compare(data, control)) {
-			control->filter_match_cnt++;
-
 			/* Information about the filters matched. */
 			control->filter_status.manufacturer_data.match = true;
-			control->filter_match = true;
+			control->filter_matched |= BT_SCAN_MANUFACTURER_DATA_FILTER;
 		}
 	}
 }
@@ -1214,6 +1417,43 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
 	return err;
 }
 
+int bt_scan_filter_remove(enum bt_scan_filter_type type,
+			  const void *data)
+{
+	int err;
+
+	if (!data) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	switch (type) {
+	case BT_SCAN_FILTER_TYPE_ADDR:
+		err = scan_addr_filter_remove((const bt_addr_le_t *)data);
+		break;
+
+	case BT_SCAN_FILTER_TYPE_UUID:
+		err = scan_uuid_filter_remove((const struct bt_uuid *)data);
+		break;
+
+	case BT_SCAN_FILTER_TYPE_NAME:
+	case BT_SCAN_FILTER_TYPE_SHORT_NAME:
+	case BT_SCAN_FILTER_TYPE_APPEARANCE:
+	case BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA:
+		err = -ENOTSUP;
+		break;
+
+	default:
+		err = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	return err;
+}
+
 void bt_scan_filter_remove_all(void)
 {
 	k_mutex_lock(&scan_mutex, K_FOREVER);
@@ -1229,10 +1469,16 @@ void bt_scan_filter_remove_all(void)
 	struct bt_scan_addr_filter *addr_filter =
 			&bt_scan.scan_filters.addr;
 	addr_filter->cnt = 0;
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	memset(addr_filter->bucket, 0, sizeof(addr_filter->bucket));
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 
 	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
 	uuid_filter->cnt = 0;
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	memset(uuid_filter->bucket, 0, sizeof(uuid_filter->bucket));
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 
 	struct bt_scan_appearance_filter *appearance_filter =
 			&bt_scan.scan_filters.appearance;
@@ -1381,31 +1627,50 @@ void bt_scan_update_init_conn_params(struct bt_le_conn_param *new_conn_param)
 
 static void check_enabled_filters(struct bt_scan_control *control)
 {
-	control->filter_cnt = 0;
+	control->filter_enabled = 0;
 
 	if (is_addr_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_ADDR_FILTER;
 	}
 
 	if (is_name_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_NAME_FILTER;
 	}
 
 	if (is_short_name_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_SHORT_NAME_FILTER;
 	}
 
 	if (is_uuid_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_UUID_FILTER;
 	}
 
 	if (is_appearance_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_APPEARANCE_FILTER;
 	}
 
 	if (is_manufacturer_data_filter_enabled()) {
-		control->filter_cnt++;
+		control->filter_enabled |= BT_SCAN_MANUFACTURER_DATA_FILTER;
+	}
+
+	control->filter_cnt = POPCOUNT(control->filter_enabled);
+}
+
+static bool ad_filters_check_needed(const struct bt_scan_control *control)
+{
+	if (!(control->filter_enabled & AD_FILTERS)) {
+		return false;
 	}
+
+	/* In the multifilter mode, a report from an address that does not
+	 * match the address filter cannot match, whatever its data.
+	 */
+	if (control->all_mode && (control->filter_enabled & BT_SCAN_ADDR_FILTER) &&
+	    !(control->filter_matched & BT_SCAN_ADDR_FILTER)) {
+		return false;
+	}
+
+	return true;
 }
 
 static bool adv_data_found(struct bt_data *data, void *user_data)
@@ -1461,9 +1726,8 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 static void filter_state_check(struct bt_scan_control *control,
 			       const bt_addr_le_t *addr)
 {
-	if (!scan_device_filter_check(addr)) {
-		return;
-	}
+	control->filter_match_cnt = POPCOUNT(control->filter_matched);
+	control->filter_match = (control->filter_matched != 0);
 
 	if (control->all_mode &&
 	    (control->filter_match_cnt == control->filter_cnt)) {
@@ -1497,6 +1761,13 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	struct bt_scan_control scan_control;
 	struct net_buf_simple_state state;
 
+	/* Blocklisted devices are not reported, skip them before looking
+	 * at the advertising data.
+	 */
+	if (!scan_device_filter_check(info->addr)) {
+		return;
+	}
+
 	memset(&scan_control, 0, sizeof(scan_control));
 
 	scan_control.all_mode = bt_scan.scan_filters.all_mode;
@@ -1507,15 +1778,27 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	scan_control.connectable =
 		(info->adv_props & BT_GAP_ADV_PROP_CONNECTABLE) != 0;
 
+	/* Filters may be added or removed from another thread. */
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
-	/* Save advertising buffer state to transfer it
-	 * data to application if futher processing is needed.
+	/* Evaluate all advertising data filters in a single pass over
+	 * the advertising data, only if any of them can change the result.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (ad_filters_check_needed(&scan_control)) {
+		/* Save advertising buffer state to transfer it
+		 * data to application if futher processing is needed.
+		 */
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+
+		uuid_result_check(&scan_control);
+	}
+
+	k_mutex_unlock(&scan_mutex);
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
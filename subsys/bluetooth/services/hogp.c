@@ -43,6 +43,10 @@ struct bt_hogp_rep_info {
 		enum bt_hids_report_type type; /**< Report type       */
 	} ref;
 	uint8_t size; /**< The size of the value */
+#if defined(CONFIG_BT_HOGP_REP_TIMESTAMP)
+	/** Cycle count at the arrival of the last value */
+	uint32_t timestamp;
+#endif
 };
 
 /* Memory slab used for reports */
@@ -847,6 +851,12 @@ static uint8_t rep_read_process(struct bt_conn *conn, uint8_t err,
 	rep = CONTAINER_OF(params,
 			   struct bt_hogp_rep_info,
 			   read_params);
+#if defined(CONFIG_BT_HOGP_REP_TIMESTAMP)
+	/* A failed read does not carry a report value. */
+	if (!err && (data != NULL)) {
+		rep->timestamp = k_cycle_get_32();
+	}
+#endif
 	if (!rep->read_cb) {
 		LOG_ERR("No read callback present");
 		return BT_GATT_ITER_STOP;
@@ -967,7 +977,7 @@ int bt_hogp_rep_write_wo_rsp(struct bt_hogp *hogp,
 {
 	int err;
 
-	if (!hogp || !rep || !func) {
+	if (!hogp || !rep) {
 		return -EINVAL;
 	}
 
@@ -975,6 +985,17 @@ int bt_hogp_rep_write_wo_rsp(struct bt_hogp *hogp,
 		return -ENOTSUP;
 	}
 
+	/* Without a callback, the write is only queued in the stack, so any
+	 * number of writes can be pending at the same time.
+	 */
+	if (!func) {
+		return bt_gatt_write_without_response(hogp->conn,
+						      rep->handlers.val,
+						      data,
+						      length,
+						      false);
+	}
+
 	if (rep->write_cb) {
 		return -EBUSY;
 	}
@@ -1027,10 +1048,14 @@ static uint8_t rep_notify_process(struct bt_conn *conn,
 		length = UINT8_MAX;
 	}
 	/* Zephyr uses the callback with data set to NULL to inform about the
-	 * subscription removal. Do not update the report size in that case.
+	 * subscription removal. Do not update the report size and timestamp
+	 * in that case.
 	 */
 	if (data != NULL) {
 		rep->size = (uint8_t)length;
+#if defined(CONFIG_BT_HOGP_REP_TIMESTAMP)
+		rep->timestamp = k_cycle_get_32();
+#endif
 	}
 
 	return rep->notify_cb(rep->hogp, rep, 0, data);
@@ -1360,3 +1385,10 @@ size_t bt_hogp_rep_size(const struct bt_hogp_rep_info *rep)
 {
 	return rep->size;
 }
+
+#if defined(CONFIG_BT_HOGP_REP_TIMESTAMP)
+uint32_t bt_hogp_rep_timestamp(const struct bt_hogp_rep_info *rep)
+{
+	return rep->timestamp;
+}
+#endif
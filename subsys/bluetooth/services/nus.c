@@ -11,10 +11,39 @@
 #include <bluetooth/services/nus.h>
 #include <zephyr/logging/log.h>
 
+#if defined(CONFIG_BT_NUS_TX_STREAM)
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
+#endif
+
 LOG_MODULE_REGISTER(bt_nus, CONFIG_BT_NUS_LOG_LEVEL);
 
 static struct bt_nus_cb nus_cb;
 
+#if defined(CONFIG_BT_NUS_TX_STREAM)
+/* Largest notification payload that the ATT MTU allows. */
+#define STREAM_PDU_MAX (CONFIG_BT_L2CAP_TX_MTU - 3)
+
+/* Retry delay when the stack has no buffers and no notification is in flight. */
+#define STREAM_RETRY_DELAY K_MSEC(10)
+
+struct nus_stream {
+	/* Connection that the stream is bound to, NULL if unused. */
+	struct bt_conn *conn;
+	struct ring_buf tx_ring;
+	struct k_spinlock lock;
+	struct k_work_delayable tx_work;
+	/* Number of notifications that can still be queued in the stack. */
+	atomic_t credits;
+};
+
+static struct nus_stream streams[CONFIG_BT_MAX_CONN];
+static uint8_t stream_buf[CONFIG_BT_MAX_CONN][CONFIG_BT_NUS_TX_STREAM_BUF_SIZE];
+
+/* Only used from the system workqueue. */
+static uint8_t stream_pdu[STREAM_PDU_MAX];
+#endif /* CONFIG_BT_NUS_TX_STREAM */
+
 static void nus_ccc_cfg_changed(const struct bt_gatt_attr *attr,
 				  uint16_t value)
 {
@@ -81,12 +110,143 @@ BT_GATT_PRIMARY_SERVICE(BT_UUID_NUS_SERVICE),
 			       NULL, on_receive, NULL),
 );
 
+#if defined(CONFIG_BT_NUS_TX_STREAM)
+static void stream_tx_work_handler(struct k_work *work);
+
+static struct nus_stream *stream_get(struct bt_conn *conn)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&stream->lock);
+
+	if (stream->conn != conn) {
+		__ASSERT_NO_MSG(!stream->conn);
+
+		ring_buf_init(&stream->tx_ring, sizeof(stream_buf[0]),
+			      stream_buf[bt_conn_index(conn)]);
+		atomic_set(&stream->credits, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+		k_work_init_delayable(&stream->tx_work, stream_tx_work_handler);
+		stream->conn = bt_conn_ref(conn);
+	}
+
+	k_spin_unlock(&stream->lock, key);
+
+	return stream;
+}
+
+static void stream_on_sent(struct bt_conn *conn, void *user_data)
+{
+	struct nus_stream *stream = user_data;
+
+	if (nus_cb.sent) {
+		nus_cb.sent(conn);
+	}
+
+	/* The stream may have been released on disconnection. */
+	if (stream->conn != conn) {
+		return;
+	}
+
+	atomic_inc(&stream->credits);
+	k_work_schedule(&stream->tx_work, K_NO_WAIT);
+}
+
+static void stream_tx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nus_stream *stream = CONTAINER_OF(dwork, struct nus_stream, tx_work);
+	struct bt_gatt_notify_params params = {
+		.attr = &nus_svc.attrs[2],
+		.data = stream_pdu,
+		.func = stream_on_sent,
+		.user_data = stream,
+	};
+	struct bt_conn *conn = stream->conn;
+	k_spinlock_key_t key;
+	atomic_val_t credits;
+	uint32_t pdu_max;
+	bool freed = false;
+	int err;
+
+	if (!conn) {
+		return;
+	}
+
+	pdu_max = MIN(bt_nus_get_mtu(conn), sizeof(stream_pdu));
+
+	/* Queue as many notifications as there are credits, each one filled
+	 * up to the ATT MTU, so that several of them can be sent in a single
+	 * connection event.
+	 */
+	while (atomic_get(&stream->credits) > 0) {
+		key = k_spin_lock(&stream->lock);
+		params.len = ring_buf_peek(&stream->tx_ring, stream_pdu, pdu_max);
+		k_spin_unlock(&stream->lock, key);
+
+		if (params.len == 0) {
+			break;
+		}
+
+		atomic_dec(&stream->credits);
+
+		err = bt_gatt_notify_cb(conn, &params);
+		if (err) {
+			credits = atomic_inc(&stream->credits) + 1;
+
+			/* Retried when the next notification has been sent. If none
+			 * is in flight, there is no sent callback to retry from.
+			 */
+			if (err != -ENOMEM) {
+				LOG_WRN("Stream notification failed (err %d)", err);
+			} else if (credits == CONFIG_BT_NUS_TX_STREAM_CREDITS) {
+				k_work_schedule(&stream->tx_work, STREAM_RETRY_DELAY);
+			}
+			break;
+		}
+
+		key = k_spin_lock(&stream->lock);
+		ring_buf_get(&stream->tx_ring, NULL, params.len);
+		k_spin_unlock(&stream->lock, key);
+
+		freed = true;
+	}
+
+	if (freed && nus_cb.stream_space) {
+		nus_cb.stream_space(conn, bt_nus_stream_space_get(conn));
+	}
+}
+
+static void stream_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+	struct k_work_sync sync;
+
+	if (stream->conn != conn) {
+		return;
+	}
+
+	/* The work handler uses the connection, wait until it has finished. */
+	(void)k_work_cancel_delayable_sync(&stream->tx_work, &sync);
+
+	bt_conn_unref(stream->conn);
+	stream->conn = NULL;
+}
+
+BT_CONN_CB_DEFINE(nus_stream_conn_callbacks) = {
+	.disconnected = stream_disconnected,
+};
+#endif /* CONFIG_BT_NUS_TX_STREAM */
+
 int bt_nus_init(struct bt_nus_cb *callbacks)
 {
 	if (callbacks) {
 		nus_cb.received = callbacks->received;
 		nus_cb.sent = callbacks->sent;
 		nus_cb.send_enabled = callbacks->send_enabled;
+#if defined(CONFIG_BT_NUS_TX_STREAM)
+		nus_cb.stream_space = callbacks->stream_space;
+#endif
 	}
 
 	return 0;
@@ -111,3 +271,49 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 		return -EINVAL;
 	}
 }
+
+#if defined(CONFIG_BT_NUS_TX_STREAM)
+int bt_nus_stream_write(struct bt_conn *conn, const uint8_t *data, size_t len)
+{
+	struct nus_stream *stream;
+	k_spinlock_key_t key;
+	uint32_t written;
+
+	if (!conn || !data) {
+		return -EINVAL;
+	}
+
+	if (!bt_gatt_is_subscribed(conn, &nus_svc.attrs[2], BT_GATT_CCC_NOTIFY)) {
+		return -EINVAL;
+	}
+
+	stream = stream_get(conn);
+
+	key = k_spin_lock(&stream->lock);
+	written = ring_buf_put(&stream->tx_ring, data, len);
+	k_spin_unlock(&stream->lock, key);
+
+	if (written > 0) {
+		k_work_schedule(&stream->tx_work, K_NO_WAIT);
+	}
+
+	return written;
+}
+
+size_t bt_nus_stream_space_get(struct bt_conn *conn)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+	k_spinlock_key_t key;
+	size_t space;
+
+	if (stream->conn != conn) {
+		return CONFIG_BT_NUS_TX_STREAM_BUF_SIZE;
+	}
+
+	key = k_spin_lock(&stream->lock);
+	space = ring_buf_space_get(&stream->tx_ring);
+	k_spin_unlock(&stream->lock, key);
+
+	return space;
+}
+#endif /* CONFIG_BT_NUS_TX_STREAM */
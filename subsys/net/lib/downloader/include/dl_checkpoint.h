@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DL_CHECKPOINT_H
+#define DL_CHECKPOINT_H
+
+#include <net/downloader.h>
+#include <sys/types.h>
+
+#if defined(CONFIG_DOWNLOADER_CHECKPOINT)
+void dl_checkpoint_start(struct downloader *dl, const char *url, size_t from);
+void dl_checkpoint_update(struct downloader *dl, const void *data, size_t len);
+void dl_checkpoint_flush(struct downloader *dl);
+void dl_checkpoint_complete(struct downloader *dl);
+int dl_checkpoint_etag_check(struct downloader *dl, const char *etag, size_t len);
+#else
+static inline void dl_checkpoint_start(struct downloader *dl, const char *url, size_t from) {}
+static inline void dl_checkpoint_update(struct downloader *dl, const void *data, size_t len) {}
+static inline void dl_checkpoint_flush(struct downloader *dl) {}
+static inline void dl_checkpoint_complete(struct downloader *dl) {}
+static inline int dl_checkpoint_etag_check(struct downloader *dl, const char *etag, size_t len)
+{
+	return 0;
+}
+#endif
+
+#endif /* DL_CHECKPOINT_H */
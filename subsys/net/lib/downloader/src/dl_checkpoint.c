@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/crc.h>
+#include <net/downloader.h>
+#include <net/downloader_transport.h>
+
+#include "dl_checkpoint.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(downloader, CONFIG_DOWNLOADER_LOG_LEVEL);
+
+struct checkpoint_load_ctx {
+	struct downloader_checkpoint *checkpoint;
+	bool found;
+};
+
+static int checkpoint_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg, void *param)
+{
+	struct checkpoint_load_ctx *ctx = param;
+	ssize_t rc;
+
+	/* Only the checkpoint key itself, not keys below it */
+	if (key != NULL) {
+		return 0;
+	}
+
+	if (len != sizeof(*ctx->checkpoint)) {
+		LOG_WRN("Ignoring checkpoint of unexpected size %zu", len);
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, ctx->checkpoint, sizeof(*ctx->checkpoint));
+	if (rc != sizeof(*ctx->checkpoint)) {
+		return 0;
+	}
+
+	ctx->checkpoint->etag[sizeof(ctx->checkpoint->etag) - 1] = '\0';
+	ctx->found = true;
+
+	return 0;
+}
+
+static int checkpoint_load(const char *key, struct downloader_checkpoint *checkpoint)
+{
+	int err;
+	struct checkpoint_load_ctx ctx = {
+		.checkpoint = checkpoint,
+	};
+
+	err = settings_load_subtree_direct(key, checkpoint_load_cb, &ctx);
+	if (err) {
+		LOG_ERR("Failed to load checkpoint, err %d", err);
+		return err;
+	}
+
+	return ctx.found ? 0 : -ENOENT;
+}
+
+static void checkpoint_save(struct downloader *dl)
+{
+	int err;
+
+	dl->checkpoint.progress = dl->progress;
+	dl->checkpoint.file_size = dl->file_size;
+
+	err = settings_save_one(dl->cfg.checkpoint_key, &dl->checkpoint, sizeof(dl->checkpoint));
+	if (err) {
+		LOG_WRN("Failed to save checkpoint, err %d", err);
+		return;
+	}
+
+	dl->checkpoint_saved = dl->progress;
+	LOG_DBG("Checkpoint saved at %zu bytes", dl->progress);
+}
+
+void dl_checkpoint_start(struct downloader *dl, const char *url, size_t from)
+{
+	uint32_t url_crc;
+	int err;
+
+	dl->checkpoint_active = false;
+
+	if (!dl->cfg.checkpoint_key) {
+		return;
+	}
+
+	url_crc = crc32_ieee((const uint8_t *)url, strlen(url));
+
+	if (from) {
+		err = checkpoint_load(dl->cfg.checkpoint_key, &dl->checkpoint);
+		if (err || dl->checkpoint.url_crc != url_crc || dl->checkpoint.progress != from) {
+			/* The running CRC of the bytes before the offset is unknown */
+			LOG_WRN("No checkpoint at offset %zu, download is not checkpointed", from);
+			return;
+		}
+
+		LOG_INF("Resuming from checkpoint at %zu bytes", from);
+	} else {
+		/* A fresh download invalidates any earlier checkpoint */
+		(void)settings_delete(dl->cfg.checkpoint_key);
+
+		memset(&dl->checkpoint, 0, sizeof(dl->checkpoint));
+		dl->checkpoint.url_crc = url_crc;
+	}
+
+	dl->checkpoint_saved = from;
+	dl->checkpoint_active = true;
+}
+
+void dl_checkpoint_update(struct downloader *dl, const void *data, size_t len)
+{
+	if (!dl->checkpoint_active) {
+		return;
+	}
+
+	dl->checkpoint.crc = crc32_ieee_update(dl->checkpoint.crc, data, len);
+
+	/* Nothing to resume once the whole file is in, the checkpoint is deleted instead */
+	if (dl->file_size && dl->progress >= dl->file_size) {
+		return;
+	}
+
+	if (dl->progress - dl->checkpoint_saved >= CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL) {
+		checkpoint_save(dl);
+	}
+}
+
+void dl_checkpoint_flush(struct downloader *dl)
+{
+	if (!dl->checkpoint_active || dl->complete || dl->progress == dl->checkpoint_saved) {
+		return;
+	}
+
+	checkpoint_save(dl);
+}
+
+void dl_checkpoint_complete(struct downloader *dl)
+{
+	if (!dl->checkpoint_active) {
+		return;
+	}
+
+	dl->checkpoint_active = false;
+	(void)settings_delete(dl->cfg.checkpoint_key);
+}
+
+int dl_checkpoint_etag_check(struct downloader *dl, const char *etag, size_t len)
+{
+	if (!dl->checkpoint_active) {
+		return 0;
+	}
+
+	if (dl->checkpoint.etag[0] == '\0') {
+		/* First response of the download, remember the entity tag */
+		if (len >= sizeof(dl->checkpoint.etag)) {
+			LOG_WRN("Entity tag too long (%zu), not verified on resume", len);
+			return 0;
+		}
+
+		memcpy(dl->checkpoint.etag, etag, len);
+		dl->checkpoint.etag[len] = '\0';
+		return 0;
+	}
+
+	if (strlen(dl->checkpoint.etag) != len || memcmp(dl->checkpoint.etag, etag, len) != 0) {
+		LOG_WRN("File changed since checkpoint, etag %.*s", (int)len, etag);
+		dl->checkpoint_active = false;
+		(void)settings_delete(dl->cfg.checkpoint_key);
+		return -ESTALE;
+	}
+
+	return 0;
+}
+
+int downloader_checkpoint_get(struct downloader *dl, const char *url,
+			      struct downloader_checkpoint *checkpoint)
+{
+	int err;
+
+	if (!dl || !url || !checkpoint || !dl->cfg.checkpoint_key) {
+		return -EINVAL;
+	}
+
+	err = checkpoint_load(dl->cfg.checkpoint_key, checkpoint);
+	if (err) {
+		return err;
+	}
+
+	if (checkpoint->url_crc != crc32_ieee((const uint8_t *)url, strlen(url))) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+int downloader_checkpoint_clear(struct downloader *dl)
+{
+	if (!dl || !dl->cfg.checkpoint_key) {
+		return -EINVAL;
+	}
+
+	return settings_delete(dl->cfg.checkpoint_key);
+}
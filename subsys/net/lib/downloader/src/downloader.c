@@ -12,6 +12,7 @@
 #include <net/downloader.h>
 #include <net/downloader_transport.h>
 
+#include "dl_checkpoint.h"
 #include "dl_parse.h"
 #include "dl_socket.h"
 
@@ -145,6 +146,8 @@ static int reconnect(struct downloader *dl)
 
 	LOG_DBG("Reconnecting...");
 
+	dl_checkpoint_flush(dl);
+
 	err = transport_close(dl);
 	if (err) {
 		LOG_DBG("disconnect failed, %d", err);
@@ -159,6 +162,8 @@ static void restart_and_suspend(struct downloader *dl)
 		return;
 	}
 
+	dl_checkpoint_flush(dl);
+
 	if (!dl->host_cfg.keep_connection) {
 		transport_close(dl);
 		if (!dl->complete) {
@@ -228,7 +233,7 @@ int dl_transport_evt_data(struct downloader *dl, void *data, size_t len)
 {
 	int err;
 
-	LOG_DBG("Read %d bytes from transport", len);
+	LOG_DBG("Read %zu bytes from transport", len);
 
 	if (dl->file_size) {
 		LOG_INF("Downloaded %u/%u bytes (%d%%)", dl->progress, dl->file_size,
@@ -239,13 +244,24 @@ int dl_transport_evt_data(struct downloader *dl, void *data, size_t len)
 
 	err = data_evt_send(dl, data, len);
 	if (err) {
-		/* Application refused data, suspend */
+		/* Application refused data, suspend. The transport has already counted
+		 * the bytes, take them back so that the checkpoint resumes with them.
+		 */
+		dl->progress -= len;
 		restart_and_suspend(dl);
+		return 0;
 	}
 
+	dl_checkpoint_update(dl, data, len);
+
 	return 0;
 }
 
+int dl_transport_evt_etag(struct downloader *dl, const char *etag, size_t len)
+{
+	return dl_checkpoint_etag_check(dl, etag, len);
+}
+
 void download_thread(void *cli, void *a, void *b)
 {
 	int rc, rc2;
@@ -292,6 +308,15 @@ void download_thread(void *cli, void *a, void *b)
 					goto reconnect;
 				}
 
+				if (rc == -ESTALE) {
+					/* The file changed since the checkpoint, resuming at the
+					 * current offset would mix two versions of it.
+					 */
+					error_evt_send(dl, rc);
+					restart_and_suspend(dl);
+					continue;
+				}
+
 				rc = error_evt_send(dl, rc);
 				if (rc) {
 					restart_and_suspend(dl);
@@ -323,6 +348,7 @@ reconnect:
 
 			if (dl->complete) {
 				LOG_INF("Download complete");
+				dl_checkpoint_complete(dl);
 				restart_and_suspend(dl);
 				download_complete_evt_send(dl);
 			}
@@ -501,6 +527,8 @@ static int downloader_start(struct downloader *dl, const struct downloader_host_
 		}
 	};
 
+	dl_checkpoint_start(dl, url, from);
+
 	if (is_state(dl, DOWNLOADER_CONNECTED)) {
 		if (host_connected) {
 			state_set(dl, DOWNLOADER_CONNECTED, DOWNLOADER_DOWNLOADING);
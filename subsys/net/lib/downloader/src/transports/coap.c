@@ -253,13 +253,13 @@ static int coap_parse(struct downloader *dl, size_t len)
 	dl->progress += payload_len;
 	dl->buf_offset = 0;
 
-	dl_transport_evt_data(dl, (void *)payload, payload_len);
-
 	if (!more) {
 		/* Mark the end, in case we did not know the total size */
 		dl->file_size = dl->progress;
 	}
 
+	dl_transport_evt_data(dl, (void *)payload, payload_len);
+
 	coap->new_data_req = true;
 	return 0;
 }
@@ -100,6 +100,16 @@ struct transport_params_http {
 		struct sockaddr remote_addr;
 	} sock;
 
+	/** Pipelined range requests */
+	struct {
+		/** Offset of the first byte not yet requested. */
+		size_t next_offset;
+		/** Range requests sent and not completely received. */
+		uint8_t in_flight;
+		/** The buffer holds the start of the next response. */
+		bool pending;
+	} pipeline;
+
 	/** Request new data */
 	bool new_data_req;
 	/** Redirect retries */
@@ -139,18 +149,21 @@ extern char *strnstr(const char *haystack, const char *needle, size_t haystack_s
 
 static int parse_protocol(struct downloader *dl, const char *url);
 
+/* Request the next range, or the rest of the file.
+ * The request is built in the free part of the buffer, after any data not yet processed.
+ */
 static int http_get_request_send(struct downloader *dl)
 {
 	int err;
 	int len;
 	size_t off = 0;
 	bool tls_force_range;
+	char *buf = dl->cfg.buf + dl->buf_offset;
+	size_t buf_size = dl->cfg.buf_size - dl->buf_offset;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
 
-	http->header.has_end = false;
-
 	/* nRF91 series has a limitation of decoding ~2k of data at once when using TLS */
 	tls_force_range = (http->sock.proto == IPPROTO_TLS_1_2 && !dl->host_cfg.set_native_tls &&
 			   IS_ENABLED(CONFIG_SOC_SERIES_NRF91X));
@@ -164,47 +177,82 @@ static int http_get_request_send(struct downloader *dl)
 	}
 
 	if (dl->host_cfg.range_override) {
-		off = dl->progress + dl->host_cfg.range_override - 1;
+		off = http->pipeline.next_offset + dl->host_cfg.range_override - 1;
 
 		if (dl->file_size) {
 			/* Don't request bytes past the end of file */
 			off = MIN(off, dl->file_size - 1);
 		}
 
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_RANGE, dl->file,
-			       dl->hostname, dl->progress, off);
+		len = snprintf(buf, buf_size, HTTP_GET_RANGE, dl->file, dl->hostname,
+			       http->pipeline.next_offset, off);
 		http->ranged = true;
-		http->ranged_progress = 0;
 		LOG_DBG("Range request up to %d bytes", dl->host_cfg.range_override);
 		goto send;
 	} else if (dl->progress) {
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_OFFSET, dl->file,
+		len = snprintf(buf, buf_size, HTTP_GET_OFFSET, dl->file,
 			       dl->hostname, dl->progress);
 		http->ranged = false;
 	} else {
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET, dl->file,
+		len = snprintf(buf, buf_size, HTTP_GET, dl->file,
 			       dl->hostname);
 		http->ranged = false;
 	}
 
 send:
-	if (len < 0 || len > dl->cfg.buf_size) {
-		LOG_ERR("Cannot create GET request, buffer too small");
+	if (len < 0 || len >= buf_size) {
 		return -ENOMEM;
 	}
 
 	if (IS_ENABLED(CONFIG_DOWNLOADER_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(dl->cfg.buf, len, "HTTP request");
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
 	}
 
-	LOG_DBG("http request:\n%s", dl->cfg.buf);
+	LOG_DBG("http request:\n%s", buf);
 
-	err = dl_socket_send(http->sock.fd, dl->cfg.buf, len);
+	err = dl_socket_send(http->sock.fd, buf, len);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
 	}
 
+	if (http->ranged) {
+		http->pipeline.next_offset = off + 1;
+		http->pipeline.in_flight++;
+	}
+
+	return 0;
+}
+
+static uint8_t http_pipeline_depth(struct transport_params_http *http)
+{
+	return http->cfg.pipeline_depth ? http->cfg.pipeline_depth
+					: CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH;
+}
+
+/* Send range requests until the pipeline is full. HTTP/1.1 servers respond to pipelined
+ * requests in order, so the responses need no reassembly.
+ */
+static int http_pipeline_fill(struct downloader *dl)
+{
+	int err;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	/* The file size is not known before the first response */
+	while (http->ranged && dl->file_size &&
+	       http->pipeline.in_flight < http_pipeline_depth(http) &&
+	       http->pipeline.next_offset < dl->file_size) {
+		err = http_get_request_send(dl);
+		if (err == -ENOMEM) {
+			/* No room for the request next to the received data, retry later */
+			return 0;
+		} else if (err) {
+			return err;
+		}
+	}
+
 	return 0;
 }
 
@@ -353,6 +401,22 @@ static int http_header_parse(struct downloader *dl, size_t buf_len)
 		}
 	} while (0);
 
+	p = strnstr(dl->cfg.buf, "\r\netag:", parse_len);
+	if (p) {
+		q = strnstr(p + 1, "\r\n", parse_len - ((p + 1) - dl->cfg.buf));
+		if (q) {
+			p += strlen("\r\netag:");
+			while (p < q && *p == ' ') {
+				p++;
+			}
+
+			err = dl_transport_evt_etag(dl, p, q - p);
+			if (err) {
+				return err;
+			}
+		}
+	}
+
 	p = strnstr(dl->cfg.buf, "\r\nconnection: close", parse_len);
 	if (p) {
 		LOG_WRN("Peer closed connection, will re-connect");
@@ -587,9 +651,22 @@ static int dl_http_close(struct downloader *dl)
 	return -EBADF;
 }
 
+/* Bytes left of the range being received */
+static size_t http_range_remaining(struct downloader *dl)
+{
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	return MIN(dl->host_cfg.range_override - http->ranged_progress,
+		   dl->file_size - dl->progress);
+}
+
 static int dl_http_download(struct downloader *dl)
 {
 	int ret, recv_len, data_len, expected_len;
+	size_t pending_len = 0;
+	bool closed = false;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
@@ -597,8 +674,17 @@ static int dl_http_download(struct downloader *dl)
 	if (http->new_data_req) {
 		/* Request next fragment */
 		dl->buf_offset = 0;
+		http->header.has_end = false;
+		http->ranged_progress = 0;
+		http->pipeline.next_offset = dl->progress;
+		http->pipeline.in_flight = 0;
+		http->pipeline.pending = false;
+
 		ret = http_get_request_send(dl);
 		if (ret) {
+			if (ret == -ENOMEM) {
+				LOG_ERR("Cannot create GET request, buffer too small");
+			}
 			LOG_DBG("data_req failed, err %d", ret);
 			/** Attempt reconnection. */
 			return -ECONNRESET;
@@ -607,13 +693,28 @@ static int dl_http_download(struct downloader *dl)
 		http->new_data_req = false;
 	}
 
+	ret = http_pipeline_fill(dl);
+	if (ret) {
+		LOG_DBG("Pipelined data_req failed, err %d", ret);
+		return -ECONNRESET;
+	}
+
 	__ASSERT(dl->buf_offset < dl->cfg.buf_size, "Buffer overflow");
 
-	LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
-		(void *)(dl->cfg.buf + dl->buf_offset));
+	if (http->pipeline.pending) {
+		/* Parse the start of the next response before waiting for more data, it may
+		 * already hold the whole response.
+		 */
+		http->pipeline.pending = false;
+		recv_len = 0;
+	} else {
+		LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
+			(void *)(dl->cfg.buf + dl->buf_offset));
 
-	recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
-			     dl->cfg.buf_size - dl->buf_offset);
+		recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
+					  dl->cfg.buf_size - dl->buf_offset);
+		closed = (recv_len == 0);
+	}
 
 	if (recv_len < 0) {
 		if (recv_len == -EMSGSIZE && dl->host_cfg.range_override) {
@@ -641,13 +742,32 @@ static int dl_http_download(struct downloader *dl)
 		return data_len;
 	}
 
+	if (http->header.has_end) {
+		/* The file size is known after the first header */
+		ret = http_pipeline_fill(dl);
+		if (ret) {
+			LOG_DBG("Pipelined data_req failed, err %d", ret);
+			return -ECONNRESET;
+		}
+	}
+
 	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, dl->file_size - dl->progress);
 
+	if (http->ranged && http->header.has_end) {
+		/* Data past the range belongs to the next pipelined response */
+		if (data_len > http_range_remaining(dl)) {
+			pending_len = data_len - http_range_remaining(dl);
+			data_len -= pending_len;
+		}
+
+		expected_len = MIN(expected_len, http_range_remaining(dl));
+	}
+
 	if (data_len < expected_len) {
 		/* Wait for more data after the HTTP headers,
 		 * so we don't end up forwarding too small chunks to FOTA library.
 		 */
-		return recv_len > 0 ? 0 : -ECONNRESET; /* Fail if closed while expecting more */
+		return closed ? -ECONNRESET : 0; /* Fail if closed while expecting more */
 	}
 
 	/* Accumulate progress */
@@ -655,13 +775,28 @@ static int dl_http_download(struct downloader *dl)
 	if (data_len) {
 		dl_transport_evt_data(dl, dl->cfg.buf, data_len);
 	}
+	dl->buf_offset = 0;
+
 	if (http->ranged) {
 		http->ranged_progress += data_len;
-		if (http->ranged_progress < dl->host_cfg.range_override) {
+		if (http->ranged_progress < dl->host_cfg.range_override &&
+		    dl->progress != dl->file_size) {
 			/* Ranged query: read until a full fragment is received */
 		} else {
-			/* Ranged query: request next fragment */
-			http->new_data_req = true;
+			/* Ranged query: the response is complete, continue with the next
+			 * pipelined response or request the next fragment.
+			 */
+			http->pipeline.in_flight--;
+			http->header.has_end = false;
+			http->ranged_progress = 0;
+
+			if (http->pipeline.in_flight == 0) {
+				http->new_data_req = true;
+			} else if (pending_len) {
+				memmove(dl->cfg.buf, dl->cfg.buf + data_len, pending_len);
+				dl->buf_offset = pending_len;
+				http->pipeline.pending = true;
+			}
 		}
 	}
 	if (dl->progress == dl->file_size) {
@@ -669,13 +804,12 @@ static int dl_http_download(struct downloader *dl)
 		dl->complete = true;
 		http->new_data_req = true;
 	}
-	dl->buf_offset = 0;
 
 	if (dl->complete) {
 		return 0;
 	}
 	/* Continue reading, unless connection is closed */
-	return recv_len > 0 ? 0 : -ECONNRESET;
+	return closed ? -ECONNRESET : 0;
 }
 
 static const struct dl_transport dl_transport_http = {
@@ -405,6 +405,35 @@ int nrf_cloud_coap_json_message_send(const char *message, bool bulk, bool confir
 	return err;
 }
 
+#if defined(CONFIG_NRF_CLOUD_SENSOR_BATCH)
+int nrf_cloud_coap_sensor_batch_send(struct nrf_cloud_sensor_batch *const batch,
+				     bool confirmable)
+{
+	if (!nrf_cloud_coap_is_connected()) {
+		return -EACCES;
+	}
+	struct nrf_cloud_data data;
+	int err;
+
+	err = nrf_cloud_sensor_batch_encode(batch, &data);
+	if (err) {
+		return err;
+	}
+	err = nrf_cloud_coap_post(COAP_D2C_BULK_RSC, NULL, data.ptr, data.len,
+				  (batch->fmt == NRF_CLOUD_BATCH_FMT_CBOR) ?
+				   COAP_CONTENT_FORMAT_APP_CBOR : COAP_CONTENT_FORMAT_APP_JSON,
+				  confirmable, NULL, NULL);
+	if (err < 0) {
+		LOG_ERR("Failed to send POST request: %d", err);
+	} else if (err > 0) {
+		LOG_RESULT_CODE_ERR("Error from server:", err);
+	} else {
+		nrf_cloud_sensor_batch_reset(batch);
+	}
+	return err;
+}
+#endif /* CONFIG_NRF_CLOUD_SENSOR_BATCH */
+
 int nrf_cloud_coap_location_send(const struct nrf_cloud_gnss_data *gnss, bool confirmable)
 {
 	__ASSERT_NO_MSG(gnss != NULL);
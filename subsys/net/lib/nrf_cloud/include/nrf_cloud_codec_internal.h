@@ -93,6 +93,13 @@ int nrf_cloud_alert_encode(const struct nrf_cloud_alert_info *alert,
 int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *input,
 				 struct nrf_cloud_data *output);
 
+/** @brief Encode the sensor data into the provided buffer, without allocating memory.
+ *  On success, output->ptr points to buf.
+ *  Returns -ENOMEM if the message does not fit.
+ */
+int nrf_cloud_sensor_data_stream_encode(const struct nrf_cloud_sensor_data *input,
+					char *buf, size_t size, struct nrf_cloud_data *output);
+
 /** @brief Encode general message of either a given numeric value or, if not NULL,
  *  a string value.  If topic is present, that topic will be used.
  */
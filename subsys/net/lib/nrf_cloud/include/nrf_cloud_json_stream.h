@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_STREAM_H__
+#define NRF_CLOUD_JSON_STREAM_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of the JSON writer. */
+#define NRF_CLOUD_JSON_WRITER_DEPTH_MAX 31
+
+/**
+ * @brief JSON writer, encoding directly into a caller-provided buffer.
+ *
+ * Errors are sticky: once the buffer is full, subsequent calls have no effect and
+ * @ref nrf_cloud_json_writer_finish returns the error. Encoding functions therefore
+ * do not need to check the result of each call.
+ */
+struct nrf_cloud_json_writer {
+	char *buf;
+	size_t size;
+	size_t len;
+	/* Bit n is set when the container at depth n already has a member */
+	uint32_t has_member;
+	uint8_t depth;
+	int err;
+};
+
+/** @brief A JSON value inside a JSON document, not null-terminated. */
+struct nrf_cloud_json_span {
+	const char *ptr;
+	size_t len;
+};
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *w, char *buf, size_t size);
+
+/* For the add functions, key is NULL for the root value and for array elements. */
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *w, const char *key);
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *w);
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *w, const char *key);
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *w);
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *w, const char *key, const char *val);
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *w, const char *key, double val);
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val);
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *w, const char *key, bool val);
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *w, const char *key);
+
+/**
+ * @brief Null-terminate the encoded document.
+ *
+ * @retval Length of the document, excluding the null-terminator.
+ * @retval -ENOMEM The buffer is too small.
+ * @retval -EINVAL Containers were not closed, or nested too deep.
+ */
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *w);
+
+/**
+ * @brief Initialize a span covering a null-terminated JSON document.
+ */
+void nrf_cloud_json_span_init(struct nrf_cloud_json_span *span, const char *json);
+
+/**
+ * @brief Find a member of a JSON object, without parsing the other members.
+ *
+ * @retval 0 Member found, @p val covers its value.
+ * @retval -ENOENT Member not found.
+ * @retval -EBADMSG @p obj is not a well-formed JSON object.
+ */
+int nrf_cloud_json_member_get(const struct nrf_cloud_json_span *obj, const char *key,
+			      struct nrf_cloud_json_span *val);
+
+/** @brief Get the value of a JSON number. Returns 0 on success, -EBADMSG otherwise. */
+int nrf_cloud_json_num_get(const struct nrf_cloud_json_span *val, double *num);
+
+/** @brief Check if a JSON value is a string equal to @p str, which must not need escaping. */
+bool nrf_cloud_json_str_eq(const struct nrf_cloud_json_span *val, const char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_STREAM_H__ */
@@ -31,6 +31,7 @@ extern "C" {
 #define NUM_BLOCKS			NUM_PREDICTIONS
 #define BLOCK_SIZE			PGPS_PREDICTION_STORAGE_SIZE
 #define NO_BLOCK			-1
+#define NO_INDEX_BLOCK			0xFFU
 
 struct gps_location {
 	int32_t latitude;
@@ -38,6 +39,16 @@ struct gps_location {
 	int64_t gps_sec;
 };
 
+/* Persisted map from prediction number to flash block, so that stored
+ * predictions can be located at boot without scanning the whole partition.
+ * It is only valid for the prediction set starting at start_sec.
+ */
+struct npgps_saved_index {
+	int64_t start_sec;
+	uint16_t count;
+	uint8_t block[NUM_PREDICTIONS]; /* NO_INDEX_BLOCK if not stored */
+};
+
 struct nrf_cloud_pgps_header;
 
 typedef int (*npgps_buffer_handler_t)(uint8_t *buf, size_t len);
@@ -51,6 +62,8 @@ void npgps_download_unlock(void);
 /* settings functions */
 int npgps_save_header(struct nrf_cloud_pgps_header *header);
 const struct nrf_cloud_pgps_header *npgps_get_saved_header(void);
+int npgps_save_index(const struct npgps_saved_index *idx);
+const struct npgps_saved_index *npgps_get_saved_index(void);
 const struct gps_location *npgps_get_saved_location(void);
 int npgps_settings_init(void);
 
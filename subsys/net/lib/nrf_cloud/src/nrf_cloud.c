@@ -17,6 +17,12 @@
 
 LOG_MODULE_REGISTER(nrf_cloud, CONFIG_NRF_CLOUD_LOG_LEVEL);
 
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+#define SENSOR_DATA_BUF_SIZE CONFIG_NRF_CLOUD_CODEC_STREAM_BUF_SIZE
+#else
+#define SENSOR_DATA_BUF_SIZE 1
+#endif
+
 /* Flag to indicate if a disconnect has been requested. */
 static atomic_t disconnect_requested;
 
@@ -289,10 +295,32 @@ int nrf_cloud_shadow_device_status_update(const struct nrf_cloud_device_status *
 	return err;
 }
 
+/* Encode into buf when the streaming codec is enabled and the message fits,
+ * otherwise into a heap buffer.
+ */
+static int sensor_data_encode(const struct nrf_cloud_sensor_data *param, char *buf,
+			      struct nrf_cloud_data *output)
+{
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+	if (nrf_cloud_sensor_data_stream_encode(param, buf, SENSOR_DATA_BUF_SIZE, output) == 0) {
+		return 0;
+	}
+#endif
+	return nrf_cloud_sensor_data_encode(param, output);
+}
+
+static void sensor_data_free(const char *buf, const struct nrf_cloud_data *data)
+{
+	if (data->ptr != buf) {
+		nrf_cloud_free((void *)data->ptr);
+	}
+}
+
 int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 {
 	int err;
 	struct nct_dc_data sensor_data;
+	char buf[SENSOR_DATA_BUF_SIZE];
 
 	if (current_state != STATE_DC_CONNECTED) {
 		return -EACCES;
@@ -302,7 +330,7 @@ int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_sensor_data_encode(param, &sensor_data.data);
+	err = sensor_data_encode(param, buf, &sensor_data.data);
 	if (err) {
 		return err;
 	}
@@ -314,7 +342,7 @@ int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 	}
 
 	err = nct_dc_send(&sensor_data);
-	nrf_cloud_free((void *)sensor_data.data.ptr);
+	sensor_data_free(buf, &sensor_data.data);
 
 	return err;
 }
@@ -323,6 +351,7 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param)
 {
 	int err;
 	struct nct_dc_data sensor_data;
+	char buf[SENSOR_DATA_BUF_SIZE];
 
 	if (current_state != STATE_DC_CONNECTED) {
 		return -EACCES;
@@ -332,13 +361,13 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_sensor_data_encode(param, &sensor_data.data);
+	err = sensor_data_encode(param, buf, &sensor_data.data);
 	if (err) {
 		return err;
 	}
 
 	err = nct_dc_stream(&sensor_data);
-	nrf_cloud_free((void *)sensor_data.data.ptr);
+	sensor_data_free(buf, &sensor_data.data);
 
 	return err;
 }
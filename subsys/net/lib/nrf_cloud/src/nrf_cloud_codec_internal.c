@@ -9,6 +9,7 @@
 #include "nrf_cloud_fsm.h"
 #include <net/nrf_cloud_codec.h>
 #include "nrf_cloud_log_internal.h"
+#include "nrf_cloud_json_stream.h"
 #include <net/nrf_cloud_location.h>
 #include <net/nrf_cloud_alert.h>
 #include <net/nrf_cloud_log.h>
@@ -455,6 +456,43 @@ int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 	return 0;
 }
 
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+int nrf_cloud_sensor_data_stream_encode(const struct nrf_cloud_sensor_data *sensor,
+					char *buf, size_t size, struct nrf_cloud_data *output)
+{
+	int ret;
+	struct nrf_cloud_json_writer w;
+
+	__ASSERT_NO_MSG(sensor != NULL);
+	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
+	__ASSERT_NO_MSG(sensor->data.len != 0);
+	__ASSERT_NO_MSG(buf != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
+
+	/* Same message as nrf_cloud_sensor_data_encode(), without a cJSON tree */
+	nrf_cloud_json_writer_init(&w, buf, size);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_APPID_KEY, sensor_type_str[sensor->type]);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_DATA_KEY, sensor->data.ptr);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (sensor->ts_ms != NRF_CLOUD_NO_TIMESTAMP) {
+		nrf_cloud_json_int_add(&w, NRF_CLOUD_MSG_TIMESTAMP_KEY, sensor->ts_ms);
+	}
+	nrf_cloud_json_obj_end(&w);
+
+	ret = nrf_cloud_json_writer_finish(&w);
+	if (ret < 0) {
+		return ret;
+	}
+
+	output->ptr = buf;
+	output->len = ret;
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_CODEC_STREAM */
+
 int nrf_cloud_state_encode(uint32_t reported_state, const bool update_desired_topic,
 			   const bool add_info_sections, struct nrf_cloud_data *output)
 {
@@ -864,13 +902,77 @@ int nrf_cloud_shadow_control_decode(struct nrf_cloud_obj *const ctrl_obj,
 	return 0;
 }
 
-int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *const data,
-					     bool accept,
-					     struct nrf_cloud_data *const output)
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+static void device_control_stream_encode(struct nrf_cloud_json_writer *w,
+					 struct nrf_cloud_ctrl_data const *const data)
 {
-	__ASSERT_NO_MSG(data != NULL);
-	__ASSERT_NO_MSG(output != NULL);
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_CTRL);
+	if (data) {
+		nrf_cloud_json_bool_add(w, NRF_CLOUD_JSON_KEY_ALERT, data->alerts_enabled);
+		nrf_cloud_json_int_add(w, NRF_CLOUD_JSON_KEY_LOG, data->log_level);
+	} else {
+		/* If data is NULL, add null to control object */
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_ALERT);
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_LOG);
+	}
+	nrf_cloud_json_obj_end(w);
+}
+
+/* Same message as the cJSON encoder, encoded on the stack and copied into a single
+ * allocation that the caller frees as before.
+ */
+static int shadow_control_response_stream_encode(struct nrf_cloud_ctrl_data const *const data,
+						 bool accept,
+						 struct nrf_cloud_data *const output)
+{
+	char buf[CONFIG_NRF_CLOUD_CODEC_STREAM_BUF_SIZE];
+	struct nrf_cloud_json_writer w;
+	char *buffer;
+	int ret;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_COAP)) {
+		nrf_cloud_json_obj_start(&w, NRF_CLOUD_JSON_KEY_STATE);
+		if (!accept) {
+			/* Rejecting, add nulls to desired control items */
+			nrf_cloud_json_obj_start(&w, NRF_CLOUD_JSON_KEY_DES);
+			device_control_stream_encode(&w, NULL);
+			nrf_cloud_json_obj_end(&w);
+		}
+		nrf_cloud_json_obj_start(&w, NRF_CLOUD_JSON_KEY_REP);
+		device_control_stream_encode(&w, data);
+		nrf_cloud_json_obj_end(&w);
+		nrf_cloud_json_obj_end(&w);
+	} else {
+		device_control_stream_encode(&w, data);
+	}
+
+	nrf_cloud_json_obj_end(&w);
 
+	ret = nrf_cloud_json_writer_finish(&w);
+	if (ret < 0) {
+		return ret;
+	}
+
+	buffer = nrf_cloud_malloc(ret + 1);
+	if (!buffer) {
+		return -ENOMEM;
+	}
+
+	memcpy(buffer, buf, ret + 1);
+	output->ptr = buffer;
+	output->len = ret;
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_CODEC_STREAM */
+
+static int shadow_control_response_cjson_encode(struct nrf_cloud_ctrl_data const *const data,
+						bool accept,
+						struct nrf_cloud_data *const output)
+{
 	char *buffer = NULL;
 	int err = 0;
 
@@ -918,6 +1020,23 @@ end:
 	return err;
 }
 
+int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *const data,
+					     bool accept,
+					     struct nrf_cloud_data *const output)
+{
+	__ASSERT_NO_MSG(data != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+	if (shadow_control_response_stream_encode(data, accept, output) == 0) {
+		LOG_DBG("Shadow response: %s", (const char *)output->ptr);
+		return 0;
+	}
+#endif
+
+	return shadow_control_response_cjson_encode(data, accept, output);
+}
+
 static int shadow_connection_info_update(cJSON *device_obj)
 {
 	int ret = 0;
@@ -2886,17 +3005,78 @@ clean_up:
 	return ret;
 }
 
-int nrf_cloud_location_response_decode(const char *const buf,
-				       struct nrf_cloud_location_result *result)
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+static int location_stream_parse(const struct nrf_cloud_json_span *loc_obj,
+				 struct nrf_cloud_location_result *const location_out)
+{
+	struct nrf_cloud_json_span lat, lon, unc, type;
+	double unc_val;
+
+	if (nrf_cloud_json_member_get(loc_obj, NRF_CLOUD_LOCATION_JSON_KEY_LAT, &lat) ||
+	    nrf_cloud_json_member_get(loc_obj, NRF_CLOUD_LOCATION_JSON_KEY_LON, &lon) ||
+	    nrf_cloud_json_member_get(loc_obj, NRF_CLOUD_LOCATION_JSON_KEY_UNCERT, &unc) ||
+	    nrf_cloud_json_member_get(loc_obj, NRF_CLOUD_JSON_FULFILL_KEY, &type)) {
+		return -ENOTSUP;
+	}
+
+	if (nrf_cloud_json_str_eq(&type, NRF_CLOUD_LOCATION_TYPE_VAL_MCELL)) {
+		location_out->type = LOCATION_TYPE_MULTI_CELL;
+	} else if (nrf_cloud_json_str_eq(&type, NRF_CLOUD_LOCATION_TYPE_VAL_SCELL)) {
+		location_out->type = LOCATION_TYPE_SINGLE_CELL;
+	} else if (nrf_cloud_json_str_eq(&type, NRF_CLOUD_LOCATION_TYPE_VAL_WIFI)) {
+		location_out->type = LOCATION_TYPE_WIFI;
+	} else {
+		/* Anchors and unknown types are left to the cJSON parser */
+		return -ENOTSUP;
+	}
+
+	if (nrf_cloud_json_num_get(&lat, &location_out->lat) ||
+	    nrf_cloud_json_num_get(&lon, &location_out->lon) ||
+	    nrf_cloud_json_num_get(&unc, &unc_val)) {
+		return -ENOTSUP;
+	}
+
+	location_out->unc = (uint32_t)unc_val;
+
+	return 0;
+}
+
+/* Decode the common location responses without allocating memory.
+ * Returns -ENOTSUP for anything else, such as error responses.
+ */
+static int location_response_stream_decode(const char *const buf,
+					   struct nrf_cloud_location_result *result)
+{
+	struct nrf_cloud_json_span loc_obj;
+	struct nrf_cloud_json_span val;
+
+	nrf_cloud_json_span_init(&loc_obj, buf);
+
+	/* REST payload */
+	if (location_stream_parse(&loc_obj, result) == 0) {
+		return 0;
+	}
+
+	/* MQTT payload */
+	if (nrf_cloud_json_member_get(&loc_obj, NRF_CLOUD_JSON_MSG_TYPE_KEY, &val) ||
+	    !nrf_cloud_json_str_eq(&val, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA) ||
+	    nrf_cloud_json_member_get(&loc_obj, NRF_CLOUD_JSON_APPID_KEY, &val) ||
+	    !nrf_cloud_json_str_eq(&val, NRF_CLOUD_JSON_APPID_VAL_LOCATION) ||
+	    nrf_cloud_json_member_get(&loc_obj, NRF_CLOUD_JSON_DATA_KEY, &val)) {
+		return -ENOTSUP;
+	}
+
+	return location_stream_parse(&val, result);
+}
+#endif /* CONFIG_NRF_CLOUD_CODEC_STREAM */
+
+static int location_response_cjson_decode(const char *const buf,
+					  struct nrf_cloud_location_result *result)
 {
 	int ret;
 	cJSON *loc_obj;
 	cJSON *data_obj;
 
-	if ((buf == NULL) || (result == NULL)) {
-		return -EINVAL;
-	}
-
 	loc_obj = cJSON_Parse(buf);
 	if (!loc_obj) {
 		LOG_DBG("No JSON found for location");
@@ -2965,6 +3145,22 @@ cleanup:
 	return ret;
 }
 
+int nrf_cloud_location_response_decode(const char *const buf,
+				       struct nrf_cloud_location_result *result)
+{
+	if ((buf == NULL) || (result == NULL)) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_NRF_CLOUD_CODEC_STREAM)
+	if (location_response_stream_decode(buf, result) == 0) {
+		return 0;
+	}
+#endif
+
+	return location_response_cjson_decode(buf, result);
+}
+
 int nrf_cloud_rest_error_decode(const char *const buf, enum nrf_cloud_error *const err)
 {
 	int ret = -ENOMSG;
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "nrf_cloud_json_stream.h"
+
+/* Doubles with an integral value up to this magnitude are encoded as integers */
+#define JSON_INT_MAX ((double)(1LL << 53))
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *w, char *buf, size_t size)
+{
+	w->buf = buf;
+	w->size = size;
+	w->len = 0;
+	w->has_member = 0;
+	w->depth = 0;
+	w->err = (size == 0) ? -ENOMEM : 0;
+}
+
+static void put(struct nrf_cloud_json_writer *w, const char *data, size_t len)
+{
+	if (w->err) {
+		return;
+	}
+
+	/* Keep room for the null-terminator */
+	if (w->len + len >= w->size) {
+		w->err = -ENOMEM;
+		return;
+	}
+
+	memcpy(w->buf + w->len, data, len);
+	w->len += len;
+}
+
+static void put_char(struct nrf_cloud_json_writer *w, char c)
+{
+	put(w, &c, 1);
+}
+
+static void str_put(struct nrf_cloud_json_writer *w, const char *str)
+{
+	const char *run = str;
+	char esc[7];
+
+	put_char(w, '"');
+
+	/* Copy unescaped runs in one go */
+	for (; *str; str++) {
+		unsigned char c = *str;
+
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		put(w, run, str - run);
+		run = str + 1;
+
+		switch (c) {
+		case '"':
+			put(w, "\\\"", 2);
+			break;
+		case '\\':
+			put(w, "\\\\", 2);
+			break;
+		case '\b':
+			put(w, "\\b", 2);
+			break;
+		case '\f':
+			put(w, "\\f", 2);
+			break;
+		case '\n':
+			put(w, "\\n", 2);
+			break;
+		case '\r':
+			put(w, "\\r", 2);
+			break;
+		case '\t':
+			put(w, "\\t", 2);
+			break;
+		default:
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			put(w, esc, 6);
+			break;
+		}
+	}
+
+	put(w, run, str - run);
+	put_char(w, '"');
+}
+
+/* Separator and key of a new member of the current container */
+static void member_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	if (w->has_member & BIT(w->depth)) {
+		put_char(w, ',');
+	}
+	w->has_member |= BIT(w->depth);
+
+	if (key) {
+		str_put(w, key);
+		put_char(w, ':');
+	}
+}
+
+static void container_start(struct nrf_cloud_json_writer *w, const char *key, char open)
+{
+	member_start(w, key);
+	put_char(w, open);
+
+	if (w->depth == NRF_CLOUD_JSON_WRITER_DEPTH_MAX) {
+		w->err = w->err ? w->err : -EINVAL;
+		return;
+	}
+
+	w->depth++;
+	w->has_member &= ~BIT(w->depth);
+}
+
+static void container_end(struct nrf_cloud_json_writer *w, char close)
+{
+	if (w->depth == 0) {
+		w->err = w->err ? w->err : -EINVAL;
+		return;
+	}
+
+	w->depth--;
+	put_char(w, close);
+}
+
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	container_start(w, key, '{');
+}
+
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *w)
+{
+	container_end(w, '}');
+}
+
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *w, const char *key)
+{
+	container_start(w, key, '[');
+}
+
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *w)
+{
+	container_end(w, ']');
+}
+
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *w, const char *key, const char *val)
+{
+	member_start(w, key);
+	str_put(w, val);
+}
+
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *w, const char *key, int64_t val)
+{
+	char num[21];
+	int len;
+
+	member_start(w, key);
+	len = snprintf(num, sizeof(num), "%lld", (long long)val);
+	put(w, num, len);
+}
+
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *w, const char *key, double val)
+{
+	char num[26];
+	int len;
+
+	if (isnan(val) || isinf(val)) {
+		nrf_cloud_json_null_add(w, key);
+		return;
+	}
+
+	if (val == floor(val) && fabs(val) <= JSON_INT_MAX) {
+		nrf_cloud_json_int_add(w, key, (int64_t)val);
+		return;
+	}
+
+	/* Same precision as cJSON: shortest of 15 or 17 digits that reads back */
+	len = snprintf(num, sizeof(num), "%1.15g", val);
+	if (strtod(num, NULL) != val) {
+		len = snprintf(num, sizeof(num), "%1.17g", val);
+	}
+
+	member_start(w, key);
+	put(w, num, len);
+}
+
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *w, const char *key, bool val)
+{
+	member_start(w, key);
+	if (val) {
+		put(w, "true", 4);
+	} else {
+		put(w, "false", 5);
+	}
+}
+
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *w, const char *key)
+{
+	member_start(w, key);
+	put(w, "null", 4);
+}
+
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *w)
+{
+	if (!w->err && w->depth != 0) {
+		w->err = -EINVAL;
+	}
+
+	if (w->err) {
+		return w->err;
+	}
+
+	/* put() always leaves room for this */
+	w->buf[w->len] = '\0';
+
+	return w->len;
+}
+
+void nrf_cloud_json_span_init(struct nrf_cloud_json_span *span, const char *json)
+{
+	span->ptr = json;
+	span->len = strlen(json);
+}
+
+static const char *ws_skip(const char *p, const char *end)
+{
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+		p++;
+	}
+
+	return p;
+}
+
+/* Returns the position after the closing quote of the string starting at p */
+static const char *str_skip(const char *p, const char *end)
+{
+	for (p++; p < end; p++) {
+		if (*p == '\\') {
+			p++;
+		} else if (*p == '"') {
+			return p + 1;
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns the position after the value starting at p */
+static const char *value_skip(const char *p, const char *end)
+{
+	int depth = 0;
+
+	while (p < end) {
+		switch (*p) {
+		case '"':
+			p = str_skip(p, end);
+			if (!p) {
+				return NULL;
+			}
+			if (depth == 0) {
+				return p;
+			}
+			continue;
+		case '{':
+		case '[':
+			depth++;
+			break;
+		case '}':
+		case ']':
+			if (depth == 0) {
+				/* End of a scalar at the end of the parent container */
+				return p;
+			}
+			if (--depth == 0) {
+				return p + 1;
+			}
+			break;
+		case ',':
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			if (depth == 0) {
+				return p;
+			}
+			break;
+		default:
+			break;
+		}
+		p++;
+	}
+
+	return (depth == 0) ? p : NULL;
+}
+
+int nrf_cloud_json_member_get(const struct nrf_cloud_json_span *obj, const char *key,
+			      struct nrf_cloud_json_span *val)
+{
+	const char *end = obj->ptr + obj->len;
+	const char *p = ws_skip(obj->ptr, end);
+	const char *key_end;
+	const char *val_end;
+	size_t key_len = strlen(key);
+	bool match;
+
+	if (p == end || *p != '{') {
+		return -EBADMSG;
+	}
+
+	p = ws_skip(p + 1, end);
+	if (p < end && *p == '}') {
+		return -ENOENT;
+	}
+
+	while (p < end) {
+		if (*p != '"') {
+			return -EBADMSG;
+		}
+
+		key_end = str_skip(p, end);
+		if (!key_end) {
+			return -EBADMSG;
+		}
+
+		/* Keys are compared as is, the keys of nRF Cloud messages need no escaping */
+		match = ((size_t)(key_end - p - 2) == key_len) && !memcmp(p + 1, key, key_len);
+
+		p = ws_skip(key_end, end);
+		if (p == end || *p != ':') {
+			return -EBADMSG;
+		}
+
+		p = ws_skip(p + 1, end);
+		val_end = value_skip(p, end);
+		if (!val_end || val_end == p) {
+			return -EBADMSG;
+		}
+
+		if (match) {
+			val->ptr = p;
+			val->len = val_end - p;
+			return 0;
+		}
+
+		p = ws_skip(val_end, end);
+		if (p == end) {
+			break;
+		}
+		if (*p == '}') {
+			return -ENOENT;
+		}
+		if (*p != ',') {
+			return -EBADMSG;
+		}
+		p = ws_skip(p + 1, end);
+	}
+
+	return -EBADMSG;
+}
+
+int nrf_cloud_json_num_get(const struct nrf_cloud_json_span *val, double *num)
+{
+	char tmp[32];
+	char *num_end;
+
+	if (val->len == 0 || val->len >= sizeof(tmp) ||
+	    !(val->ptr[0] == '-' || (val->ptr[0] >= '0' && val->ptr[0] <= '9'))) {
+		return -EBADMSG;
+	}
+
+	/* The span is not null-terminated */
+	memcpy(tmp, val->ptr, val->len);
+	tmp[val->len] = '\0';
+
+	*num = strtod(tmp, &num_end);
+	if (num_end != tmp + val->len) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+bool nrf_cloud_json_str_eq(const struct nrf_cloud_json_span *val, const char *str)
+{
+	size_t len = strlen(str);
+
+	return (val->len == len + 2) && (val->ptr[0] == '"') &&
+	       !memcmp(val->ptr + 1, str, len) && (val->ptr[len + 1] == '"');
+}
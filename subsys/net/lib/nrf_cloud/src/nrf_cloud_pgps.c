@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/kernel.h>
+#include <stddef.h>
 #include <nrfx_nvmc.h>
 #include <zephyr/device.h>
 #include <zephyr/storage/stream_flash.h>
@@ -109,6 +110,8 @@ static uint8_t prediction_cache[PGPS_PREDICTION_STORAGE_SIZE];
 #endif
 
 static uint8_t prediction_buf[PGPS_PREDICTION_STORAGE_SIZE];
+/* Blocks whose prediction has been fully validated since it was located */
+static bool block_validated[NUM_BLOCKS];
 static volatile bool accept_packets;
 static volatile bool loading_in_progress;
 static volatile bool notified;
@@ -201,6 +204,19 @@ static struct nrf_cloud_pgps_prediction *get_prediction_slot(int slot, off_t *fl
 	return get_cached_prediction(off);
 }
 
+static int read_prediction_sentinel(off_t off, uint32_t *sentinel)
+{
+	off += offsetof(struct nrf_cloud_pgps_prediction, sentinel);
+
+#if defined(CONFIG_PM_PARTITION_REGION_PGPS_EXTERNAL)
+	return flash_area_read(prediction_flash_area, off - prediction_flash_area->fa_off,
+			       sentinel, sizeof(*sentinel));
+#else
+	memcpy(sentinel, (const void *)off, sizeof(*sentinel));
+	return 0;
+#endif
+}
+
 static int determine_prediction_num(struct nrf_cloud_pgps_header *header,
 				    struct nrf_cloud_pgps_prediction *p)
 {
@@ -341,6 +357,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	for (pnum = 0; pnum < count; pnum++) {
 		index.predictions[pnum] = NULL;
 	}
+	memset(block_validated, 0, sizeof(block_validated));
 
 	npgps_reset_block_pool();
 
@@ -398,6 +415,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
 		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
 		npgps_mark_block_used(i, true);
+		block_validated[i] = true;
 	}
 
 	/* find first free block in flash, if any, after chronologicaly
@@ -431,6 +449,156 @@ static void get_prediction_day_time(int pnum, int64_t *gps_sec, uint16_t *gps_da
 	}
 }
 
+/* Save the location of the first num_valid predictions, which are known to be good */
+static void save_index(int num_valid)
+{
+	struct npgps_saved_index saved = {
+		.start_sec = index.start_sec,
+		.count = index.header.prediction_count,
+	};
+	int block;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_INDEX)) {
+		return;
+	}
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		block = ((pnum < num_valid) && index.predictions[pnum]) ?
+			get_prediction_block(pnum) : NO_BLOCK;
+		saved.block[pnum] = (block == NO_BLOCK) ? NO_INDEX_BLOCK : (uint8_t)block;
+	}
+
+	err = npgps_save_index(&saved);
+	if (err) {
+		LOG_WRN("Unable to save P-GPS index:%d", err);
+	}
+}
+
+static void invalidate_index(void)
+{
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_INDEX) ||
+	    (npgps_get_saved_index()->count == 0)) {
+		return;
+	}
+
+	(void)npgps_save_index(NULL);
+}
+
+/* Rebuild the catalog of predictions from the saved index instead of scanning
+ * every slot of the storage. Only the sentinel of each prediction is checked here;
+ * the rest of the prediction is validated the first time it is used.
+ * Returns the number of consecutive valid predictions, or a negative error code
+ * if the index does not match the stored predictions.
+ */
+static int load_indexed_predictions(uint16_t *first_bad_day, uint32_t *first_bad_time)
+{
+	const struct npgps_saved_index *saved = npgps_get_saved_index();
+	uint16_t count = index.header.prediction_count;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	uint32_t sentinel;
+	int64_t gps_sec;
+	int block = NO_BLOCK;
+	int pnum;
+	off_t off;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_INDEX)) {
+		return -ENOTSUP;
+	}
+
+	if ((saved->count != count) || (saved->start_sec != index.start_sec)) {
+		LOG_INF("No P-GPS index for stored data");
+		return -ENOENT;
+	}
+
+	discard_prediction_buffer();
+	memset(index.predictions, 0, sizeof(index.predictions));
+	memset(block_validated, 0, sizeof(block_validated));
+	npgps_reset_block_pool();
+
+	for (pnum = 0; pnum < count; pnum++) {
+		get_prediction_day_time(pnum, &gps_sec, &gps_day, &gps_time_of_day);
+
+		if (saved->block[pnum] == NO_INDEX_BLOCK) {
+			LOG_WRN("Prediction num:%u missing", pnum);
+			*first_bad_day = gps_day;
+			*first_bad_time = gps_time_of_day;
+			break;
+		}
+		if (saved->block[pnum] >= NUM_BLOCKS) {
+			LOG_ERR("Invalid block:%u in P-GPS index", saved->block[pnum]);
+			return -EINVAL;
+		}
+
+		block = saved->block[pnum];
+		off = (off_t)npgps_block_to_pointer(block);
+		err = read_prediction_sentinel(off, &sentinel);
+		if (err || (sentinel != (uint32_t)gps_sec)) {
+			LOG_WRN("P-GPS index does not match prediction num:%u, blk:%d",
+				pnum, block);
+			return -EBADMSG;
+		}
+
+		index.predictions[pnum] = (struct nrf_cloud_pgps_prediction *)off;
+		npgps_mark_block_used(block, true);
+	}
+
+	if (block != NO_BLOCK) {
+		(void)npgps_find_first_free(block);
+	}
+
+	npgps_print_blocks();
+	return pnum;
+}
+
+static int validate_indexed_prediction(int pnum, const struct nrf_cloud_pgps_prediction *p)
+{
+	int block = get_prediction_block(pnum);
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	int err;
+
+	if ((block == NO_BLOCK) || block_validated[block]) {
+		return 0;
+	}
+
+	get_prediction_day_time(pnum, NULL, &gps_day, &gps_time_of_day);
+	err = validate_prediction(p, gps_day, gps_time_of_day,
+				  index.header.prediction_period_min, true, false);
+	if (err) {
+		LOG_ERR("Indexed prediction num:%d is bad:%d", pnum, err);
+		index.predictions[pnum] = NULL;
+		npgps_free_block(block);
+		/* force a full scan of the storage at next boot */
+		invalidate_index();
+		index.cur_pnum = 0xff;
+		state = PGPS_EXPIRED;
+		loading_in_progress = false; /* make sure we request it */
+		return -ENODATA;
+	}
+
+	block_validated[block] = true;
+	return 0;
+}
+
+/* Locate the stored predictions, from the saved index if it matches them, otherwise
+ * by scanning the storage. Returns the number of consecutive valid predictions.
+ */
+static int load_stored_predictions(uint16_t *first_bad_day, uint32_t *first_bad_time)
+{
+	int num_valid;
+
+	num_valid = load_indexed_predictions(first_bad_day, first_bad_time);
+	if (num_valid < 0) {
+		num_valid = validate_stored_predictions(first_bad_day, first_bad_time);
+		save_index(num_valid);
+	}
+
+	return num_valid;
+}
+
 static void discard_oldest_predictions(int num)
 {
 	int i;
@@ -452,6 +620,7 @@ static void discard_oldest_predictions(int num)
 		__ASSERT((block != -1), "unexpected ptr:%p for Prediction num:%d",
 			 index.predictions[pnum], pnum);
 		npgps_free_block(block);
+		block_validated[block] = false;
 	}
 
 	/* move predictions we are keeping to the start */
@@ -704,6 +873,11 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 	index.cur_pnum = pnum;
 	*prediction = get_prediction(pnum);
 	if (*prediction) {
+		err = validate_indexed_prediction(pnum, *prediction);
+		if (err) {
+			*prediction = NULL;
+			return err;
+		}
 		err = validate_prediction(*prediction,
 					  cur_gps_day, cur_gps_time_of_day,
 					  period_min, false, margin);
@@ -1530,6 +1704,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 				goto fail;
 			}
 			index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
+			block_validated[index.store_block] = true;
 
 			if (!finished) {
 				if (loading_in_progress && !notified && (index.loading_count > 1)) {
@@ -1552,6 +1727,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 
 				LOG_INF("All P-GPS data received. Done.");
 				state = PGPS_READY;
+				save_index(index.header.prediction_count);
 				if (evt_handler) {
 					struct nrf_cloud_pgps_event evt = {
 						.type = PGPS_EVT_READY,
@@ -1620,6 +1796,9 @@ int nrf_cloud_pgps_begin_update(void)
 	/* assume cache is no longer valid */
 	discard_prediction_buffer();
 
+	/* the saved index no longer matches the storage until this update finishes */
+	invalidate_index();
+
 	index.loading_count = 0;
 	index.store_block = npgps_alloc_block();
 	if (index.store_block == NO_BLOCK) {
@@ -1792,7 +1971,7 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 		 */
 		LOG_INF("Checking stored P-GPS data; count:%u, period_min:%u",
 			count, period_min);
-		num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+		num_valid = load_stored_predictions(&gps_day, &gps_time_of_day);
 	}
 
 	struct nrf_cloud_pgps_prediction *found_prediction = NULL;
@@ -29,6 +29,8 @@ LOG_MODULE_DECLARE(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
 #define SETTINGS_FULL_LOCATION			SETTINGS_NAME "/" SETTINGS_KEY_LOCATION
 #define SETTINGS_KEY_LEAP_SEC			"g2u_leap_sec"
 #define SETTINGS_FULL_LEAP_SEC			SETTINGS_NAME "/" SETTINGS_KEY_LEAP_SEC
+#define SETTINGS_KEY_PGPS_INDEX			"pgps_index"
+#define SETTINGS_FULL_PGPS_INDEX		SETTINGS_NAME "/" SETTINGS_KEY_PGPS_INDEX
 
 struct block_pool {
 	int first_free;
@@ -44,6 +46,7 @@ static int num_blocks;
 static int gps_leap_seconds = GPS_TO_UTC_LEAP_SECONDS;
 static struct gps_location saved_location;
 static struct nrf_cloud_pgps_header saved_header;
+static struct npgps_saved_index saved_index;
 
 static K_SEM_DEFINE(dl_active, 1, 1);
 
@@ -86,6 +89,15 @@ static int settings_set(const char *key, size_t len_rd,
 			return 0;
 		}
 	}
+	if (!strncmp(key, SETTINGS_KEY_PGPS_INDEX,
+		     strlen(SETTINGS_KEY_PGPS_INDEX)) &&
+	    (len_rd == sizeof(saved_index))) {
+		if (read_cb(cb_arg, (void *)&saved_index, len_rd) == len_rd) {
+			LOG_DBG("Read pgps_index: count:%u, gps sec:%d",
+				saved_index.count, (int32_t)saved_index.start_sec);
+			return 0;
+		}
+	}
 	if (!strncmp(key, SETTINGS_KEY_LOCATION,
 		     strlen(SETTINGS_KEY_LOCATION)) &&
 	    (len_rd == sizeof(saved_location))) {
@@ -140,6 +152,26 @@ const struct nrf_cloud_pgps_header *npgps_get_saved_header(void)
 	return &saved_header;
 }
 
+int npgps_save_index(const struct npgps_saved_index *idx)
+{
+	int ret = 0;
+
+	if (idx) {
+		memcpy(&saved_index, idx, sizeof(saved_index));
+	} else {
+		memset(&saved_index, 0, sizeof(saved_index));
+	}
+
+	LOG_DBG("Saving pgps index; count:%u", saved_index.count);
+	ret = settings_save_one(SETTINGS_FULL_PGPS_INDEX, &saved_index, sizeof(saved_index));
+	return ret;
+}
+
+const struct npgps_saved_index *npgps_get_saved_index(void)
+{
+	return &saved_index;
+}
+
 /* @TODO: consider rate-limiting these updates to reduce Flash wear */
 static int save_location(void)
 {
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_defs.h>
+#include <net/nrf_cloud_codec.h>
+
+#include "nrf_cloud_json_stream.h"
+#if defined(CONFIG_NRF_CLOUD_COAP)
+#include <zephyr/net/coap.h>
+#include "coap_codec.h"
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(nrf_cloud_sensor_batch, CONFIG_NRF_CLOUD_LOG_LEVEL);
+
+/* JSON: room for the closing bracket and the null-terminator */
+#define JSON_TAIL_SIZE 2
+
+/* CBOR: room for the array header, written in front of the samples when encoding.
+ * The largest header used is for a 16-bit sample count.
+ */
+#define CBOR_HDR_SIZE 3
+#define CBOR_COUNT_MAX UINT16_MAX
+
+/* Upper bound of an encoded sample: map header, three keys, the app ID string
+ * with its header, a float64 value and a uint64 timestamp.
+ */
+#define CBOR_SAMPLE_SIZE_MAX(app_id_len) (1 + 3 + (3 + (app_id_len)) + 9 + 9)
+
+int nrf_cloud_sensor_batch_init(struct nrf_cloud_sensor_batch *const batch,
+				enum nrf_cloud_batch_fmt fmt, uint8_t *buf, size_t size)
+{
+	if (!batch || !buf) {
+		return -EINVAL;
+	}
+
+	switch (fmt) {
+	case NRF_CLOUD_BATCH_FMT_JSON:
+		if (size < 1 + JSON_TAIL_SIZE) {
+			return -EINVAL;
+		}
+		break;
+	case NRF_CLOUD_BATCH_FMT_CBOR:
+		if (!IS_ENABLED(CONFIG_NRF_CLOUD_COAP)) {
+			return -ENOTSUP;
+		}
+		if (size <= CBOR_HDR_SIZE) {
+			return -EINVAL;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	batch->fmt = fmt;
+	batch->buf = buf;
+	batch->size = size;
+	nrf_cloud_sensor_batch_reset(batch);
+
+	return 0;
+}
+
+void nrf_cloud_sensor_batch_reset(struct nrf_cloud_sensor_batch *const batch)
+{
+	__ASSERT_NO_MSG(batch != NULL);
+
+	batch->count = 0;
+
+	if (batch->fmt == NRF_CLOUD_BATCH_FMT_JSON) {
+		batch->buf[0] = '[';
+		batch->len = 1;
+	} else {
+		batch->len = CBOR_HDR_SIZE;
+	}
+}
+
+static int json_sample_add(struct nrf_cloud_sensor_batch *const batch, const char *const app_id,
+			   double value, int64_t ts_ms)
+{
+	struct nrf_cloud_json_writer w;
+	size_t sep = (batch->count > 0) ? 1 : 0;
+	size_t avail = batch->size - batch->len - sep;
+	int ret;
+
+	if (avail <= JSON_TAIL_SIZE) {
+		return -ENOMEM;
+	}
+
+	/* The writer keeps one byte for its null-terminator, the batch needs one more */
+	nrf_cloud_json_writer_init(&w, (char *)batch->buf + batch->len + sep, avail - 1);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_APPID_KEY, app_id);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	nrf_cloud_json_num_add(&w, NRF_CLOUD_JSON_DATA_KEY, value);
+	nrf_cloud_json_int_add(&w, NRF_CLOUD_MSG_TIMESTAMP_KEY, ts_ms);
+	nrf_cloud_json_obj_end(&w);
+
+	ret = nrf_cloud_json_writer_finish(&w);
+	if (ret < 0) {
+		return -ENOMEM;
+	}
+
+	if (sep) {
+		batch->buf[batch->len] = ',';
+	}
+	batch->len += sep + ret;
+
+	return 0;
+}
+
+#if defined(CONFIG_NRF_CLOUD_COAP)
+static int cbor_sample_add(struct nrf_cloud_sensor_batch *const batch, const char *const app_id,
+			   double value, int64_t ts_ms)
+{
+	size_t len = batch->size - batch->len;
+	struct nrf_cloud_obj_coap_cbor msg = {
+		.app_id = (char *)app_id,
+		.type = NRF_CLOUD_DATA_TYPE_DOUBLE,
+		.double_val = value,
+		.ts = ts_ms,
+	};
+
+	/* Checked up front, so that a full batch is not reported as an encoding error */
+	if (batch->count == CBOR_COUNT_MAX || len < CBOR_SAMPLE_SIZE_MAX(strlen(app_id))) {
+		return -ENOMEM;
+	}
+
+	/* Each sample is encoded like a single CoAP device message */
+	if (coap_codec_message_encode(&msg, batch->buf + batch->len, &len,
+				      COAP_CONTENT_FORMAT_APP_CBOR)) {
+		return -ENOMEM;
+	}
+
+	batch->len += len;
+
+	return 0;
+}
+#endif
+
+int nrf_cloud_sensor_batch_add(struct nrf_cloud_sensor_batch *const batch,
+			       const char *const app_id, double value, int64_t ts_ms)
+{
+	int err;
+
+	if (!batch || !app_id || ts_ms < 0) {
+		return -EINVAL;
+	}
+
+	if (batch->fmt == NRF_CLOUD_BATCH_FMT_JSON) {
+		err = json_sample_add(batch, app_id, value, ts_ms);
+	} else {
+#if defined(CONFIG_NRF_CLOUD_COAP)
+		err = cbor_sample_add(batch, app_id, value, ts_ms);
+#else
+		err = -ENOTSUP;
+#endif
+	}
+
+	if (err) {
+		LOG_DBG("Sample not added to batch of %u, err %d", batch->count, err);
+		return err;
+	}
+
+	batch->count++;
+
+	return 0;
+}
+
+int nrf_cloud_sensor_batch_encode(struct nrf_cloud_sensor_batch *const batch,
+				  struct nrf_cloud_data *const output)
+{
+	uint8_t *hdr;
+
+	if (!batch || !output) {
+		return -EINVAL;
+	}
+
+	if (batch->count == 0) {
+		return -ENODATA;
+	}
+
+	if (batch->fmt == NRF_CLOUD_BATCH_FMT_JSON) {
+		/* Room was kept for these when adding */
+		batch->buf[batch->len] = ']';
+		batch->buf[batch->len + 1] = '\0';
+
+		output->ptr = batch->buf;
+		output->len = batch->len + 1;
+
+		return 0;
+	}
+
+	/* CBOR array header, just in front of the samples */
+	if (batch->count < 24) {
+		hdr = batch->buf + CBOR_HDR_SIZE - 1;
+		hdr[0] = 0x80 | batch->count;
+	} else if (batch->count <= UINT8_MAX) {
+		hdr = batch->buf + CBOR_HDR_SIZE - 2;
+		hdr[0] = 0x98;
+		hdr[1] = batch->count;
+	} else {
+		hdr = batch->buf;
+		hdr[0] = 0x99;
+		hdr[1] = batch->count >> 8;
+		hdr[2] = batch->count & 0xff;
+	}
+
+	output->ptr = hdr;
+	output->len = batch->len - (hdr - batch->buf);
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <modem/at_monitor.h>
+#include <nrf_modem_at.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, nrf_modem_at_notif_handler_set, nrf_modem_at_notif_handler_t);
+
+/* at_monitor_dispatch() is implemented in at_monitor library and
+ * we'll call it directly to fake received notifications.
+ */
+extern void at_monitor_dispatch(const char *notif);
+
+/* Monitors are dispatched in the order they are defined, which is the order of their names. */
+AT_MONITOR_ISR(mon_a_any, ANY, any_handler);
+AT_MONITOR_ISR(mon_b_cereg, "+CEREG", cereg_handler);
+AT_MONITOR_ISR(mon_c_cereg_unprefixed, "CEREG", cereg_unprefixed_handler);
+AT_MONITOR_ISR(mon_d_cmt, "+CMT", cmt_handler);
+AT_MONITOR_ISR(mon_e_cmti, "+CMTI", cmti_handler);
+AT_MONITOR_ISR(mon_f_error, "ERROR", error_handler);
+AT_MONITOR_ISR(mon_g_xtime, "%XTIME", xtime_handler);
+AT_MONITOR_ISR(mon_h_battery_low, "%MDMEV: ME BATTERY LOW", battery_low_handler);
+AT_MONITOR_ISR(mon_i_paused, "+CEREG", paused_handler, PAUSED);
+AT_MONITOR(mon_j_cscon, "+CSCON", cscon_handler);
+
+static char dispatched[128];
+
+static void dispatched_add(const char *name)
+{
+	TEST_ASSERT_LESS_THAN(sizeof(dispatched), strlen(dispatched) + strlen(name) + 1);
+
+	strcat(dispatched, name);
+	strcat(dispatched, " ");
+}
+
+static void any_handler(const char *notif)
+{
+	dispatched_add("any");
+}
+
+static void cereg_handler(const char *notif)
+{
+	dispatched_add("cereg");
+}
+
+static void cereg_unprefixed_handler(const char *notif)
+{
+	dispatched_add("cereg_unprefixed");
+}
+
+static void cmt_handler(const char *notif)
+{
+	dispatched_add("cmt");
+}
+
+static void cmti_handler(const char *notif)
+{
+	dispatched_add("cmti");
+}
+
+static void error_handler(const char *notif)
+{
+	dispatched_add("error");
+}
+
+static void xtime_handler(const char *notif)
+{
+	dispatched_add("xtime");
+}
+
+static void battery_low_handler(const char *notif)
+{
+	dispatched_add("battery_low");
+}
+
+static void paused_handler(const char *notif)
+{
+	dispatched_add("paused");
+}
+
+static void cscon_handler(const char *notif)
+{
+	dispatched_add("cscon");
+}
+
+static void dispatch_expect(const char *notif, const char *expected)
+{
+	dispatched[0] = '\0';
+
+	at_monitor_dispatch(notif);
+
+	TEST_ASSERT_EQUAL_STRING(expected, dispatched);
+}
+
+void setUp(void)
+{
+	dispatched[0] = '\0';
+}
+
+void tearDown(void)
+{
+	at_monitor_resume(&mon_b_cereg);
+	at_monitor_pause(&mon_i_paused);
+}
+
+void test_at_monitor_handler_set(void)
+{
+	/* Called in SYS_INIT, before the tests */
+	TEST_ASSERT_EQUAL(1, nrf_modem_at_notif_handler_set_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(at_monitor_dispatch, nrf_modem_at_notif_handler_set_fake.arg0_val);
+}
+
+void test_at_monitor_command_name(void)
+{
+	dispatch_expect("+CEREG: 1,\"0001\",\"01020304\",7\r\n", "any cereg cereg_unprefixed ");
+	dispatch_expect("%XTIME: ,\"42502181613140\",\"01\"\r\n", "any xtime ");
+}
+
+void test_at_monitor_no_match(void)
+{
+	dispatch_expect("%CESQ: 54,2,16,2\r\n", "any ");
+	dispatch_expect("\r\n", "any ");
+}
+
+void test_at_monitor_filter_with_parameters(void)
+{
+	dispatch_expect("%MDMEV: ME BATTERY LOW\r\n", "any battery_low ");
+	dispatch_expect("%MDMEV: PRACH CE-LEVEL 0\r\n", "any ");
+}
+
+void test_at_monitor_command_name_is_prefix(void)
+{
+	dispatch_expect("+CMT: \"+4712345678\",22\r\n", "any cmt ");
+
+	/* With the index, "+CMT" only matches the notifications of the CMT command */
+	if (IS_ENABLED(CONFIG_AT_MONITOR_FILTER_INDEX)) {
+		dispatch_expect("+CMTI: \"SM\",1\r\n", "any cmti ");
+	} else {
+		dispatch_expect("+CMTI: \"SM\",1\r\n", "any cmt cmti ");
+	}
+}
+
+void test_at_monitor_unprefixed_filter_substring(void)
+{
+	/* Unprefixed filters are matched anywhere in the notification, with or without index */
+	dispatch_expect("+CME ERROR: 10\r\n", "any error ");
+	dispatch_expect("ERROR\r\n", "any error ");
+
+	if (IS_ENABLED(CONFIG_AT_MONITOR_FILTER_INDEX)) {
+		dispatch_expect("%XFOO: \"+CEREG\"\r\n", "any cereg_unprefixed ");
+	} else {
+		dispatch_expect("%XFOO: \"+CEREG\"\r\n", "any cereg cereg_unprefixed ");
+	}
+}
+
+void test_at_monitor_pause_resume(void)
+{
+	at_monitor_resume(&mon_i_paused);
+	dispatch_expect("+CEREG: 5\r\n", "any cereg cereg_unprefixed paused ");
+
+	at_monitor_pause(&mon_b_cereg);
+	dispatch_expect("+CEREG: 5\r\n", "any cereg_unprefixed paused ");
+
+	at_monitor_pause(&mon_i_paused);
+	at_monitor_resume(&mon_b_cereg);
+	dispatch_expect("+CEREG: 5\r\n", "any cereg cereg_unprefixed ");
+}
+
+void test_at_monitor_deferred(void)
+{
+	/* Only the ISR monitors are called in the dispatch */
+	dispatch_expect("+CSCON: 1\r\n", "any ");
+
+	k_sleep(K_MSEC(100));
+
+	TEST_ASSERT_EQUAL_STRING("any cscon ", dispatched);
+}
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
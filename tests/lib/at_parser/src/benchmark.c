@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <modem/at_parser.h>
+
+#define BENCHMARK_ROUNDS 100
+
+/* Responses captured from nRF91 Series devices. */
+static const char * const xmonitor_corpus[] = {
+	"%XMONITOR: 1,\"EDAV\",\"EDAV\",\"26295\",\"00B7\",7,4,\"00011B07\",7,2300,63,39,\"\","
+	"\"11100000\",\"11100000\",\"01001001\"\r\nOK\r\n",
+	"%XMONITOR: 5,\"\",\"\",\"24201\",\"0A0C\",7,20,\"03DF0503\",269,6400,46,38,\"\","
+	"\"00101101\",\"11100000\",\"00111000\",\"00000011\",0,0,0,-92\r\nOK\r\n",
+	"%XMONITOR: 1,\"Telia N\",\"Telia N\",\"24202\",\"0901\",7,20,\"012BEF0F\",366,6300,"
+	"53,22,\"\",\"00000101\",\"11100000\",\"01001001\"\r\nOK\r\n",
+	"%XMONITOR: 2\r\nOK\r\n",
+};
+
+static const char * const ncellmeas_corpus[] = {
+	"%NCELLMEAS: 0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2,30,2,5365,"
+	"6300,167,51,11,24,6300,178,48,5,24,84\r\n",
+	"%NCELLMEAS: 0,\"03DF0503\",\"24201\",\"0A0C\",64,6400,269,46,15,1024853,"
+	"6400,12,39,8,20,6400,344,35,3,20,1800,47,28,-2,56,1800,108,22,-6,56,"
+	"3750,403,19,-9,72,1024701\r\n",
+	"%NCELLMEAS: 1\r\n",
+};
+
+static void parse_sequential(const char *response, uint32_t *sum)
+{
+	int err;
+	size_t count;
+	size_t len;
+	int32_t num;
+	const char *str;
+	struct at_parser parser;
+
+	err = at_parser_init(&parser, response);
+	zassert_ok(err);
+
+	err = at_parser_cmd_count_get(&parser, &count);
+	zassert_ok(err);
+
+	*sum = 0;
+
+	for (size_t i = 1; i < count; i++) {
+		if (at_parser_num_get(&parser, i, &num) == 0) {
+			*sum += num;
+		} else if (at_parser_string_ptr_get(&parser, i, &str, &len) == 0) {
+			*sum += len;
+		}
+	}
+}
+
+static void parse_reverse(const char *response, uint32_t *sum)
+{
+	int err;
+	size_t count;
+	size_t len;
+	int32_t num;
+	const char *str;
+	struct at_parser parser;
+
+	err = at_parser_init(&parser, response);
+	zassert_ok(err);
+
+	err = at_parser_cmd_count_get(&parser, &count);
+	zassert_ok(err);
+
+	*sum = 0;
+
+	for (size_t i = count - 1; i > 0; i--) {
+		if (at_parser_num_get(&parser, i, &num) == 0) {
+			*sum += num;
+		} else if (at_parser_string_ptr_get(&parser, i, &str, &len) == 0) {
+			*sum += len;
+		}
+	}
+}
+
+static void benchmark(const char *name, const char * const *corpus, size_t corpus_len)
+{
+	uint32_t start;
+	uint32_t seq_cycles = 0;
+	uint32_t rev_cycles = 0;
+	uint32_t seq_sum;
+	uint32_t rev_sum;
+
+	for (size_t i = 0; i < corpus_len; i++) {
+		/* Both access orders must give the same values */
+		parse_sequential(corpus[i], &seq_sum);
+		parse_reverse(corpus[i], &rev_sum);
+		zassert_equal(seq_sum, rev_sum);
+	}
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		for (size_t i = 0; i < corpus_len; i++) {
+			start = k_cycle_get_32();
+			parse_sequential(corpus[i], &seq_sum);
+			seq_cycles += k_cycle_get_32() - start;
+
+			start = k_cycle_get_32();
+			parse_reverse(corpus[i], &rev_sum);
+			rev_cycles += k_cycle_get_32() - start;
+
+			zassert_equal(seq_sum, rev_sum);
+		}
+	}
+
+	TC_PRINT("%s: %u responses, token index %s\n", name, corpus_len * BENCHMARK_ROUNDS,
+		 IS_ENABLED(CONFIG_AT_PARSER_TOKEN_INDEX) ? "enabled" : "disabled");
+	TC_PRINT("  sequential access: %u cycles/response\n",
+		 seq_cycles / (corpus_len * BENCHMARK_ROUNDS));
+	TC_PRINT("  reverse access: %u cycles/response\n",
+		 rev_cycles / (corpus_len * BENCHMARK_ROUNDS));
+}
+
+ZTEST(at_parser_benchmark, test_xmonitor_values)
+{
+	int err;
+	struct at_parser parser;
+	char buffer[16];
+	size_t len = sizeof(buffer);
+	uint16_t earfcn;
+	uint16_t band;
+	int16_t rsrp;
+
+	err = at_parser_init(&parser, xmonitor_corpus[1]);
+	zassert_ok(err);
+
+	/* Out of order, as done when parsing the %XMONITOR response */
+	err = at_parser_num_get(&parser, 21, &rsrp);
+	zassert_ok(err);
+	zassert_equal(rsrp, -92);
+
+	err = at_parser_num_get(&parser, 7, &band);
+	zassert_ok(err);
+	zassert_equal(band, 20);
+
+	err = at_parser_string_get(&parser, 5, buffer, &len);
+	zassert_ok(err);
+	zassert_mem_equal(buffer, "0A0C", len);
+
+	err = at_parser_num_get(&parser, 10, &earfcn);
+	zassert_ok(err);
+	zassert_equal(earfcn, 6400);
+
+	err = at_parser_num_get(&parser, 22, &rsrp);
+	zassert_equal(err, -EIO);
+}
+
+ZTEST(at_parser_benchmark, test_ncellmeas_values)
+{
+	int err;
+	struct at_parser parser;
+	uint16_t earfcn;
+	uint16_t phys_cell_id;
+	uint64_t meas_time;
+	size_t count;
+
+	err = at_parser_init(&parser, ncellmeas_corpus[1]);
+	zassert_ok(err);
+
+	err = at_parser_cmd_count_get(&parser, &count);
+	zassert_ok(err);
+	zassert_equal(count, 37);
+
+	/* Last neighbor cell, then the timing advance measurement time */
+	err = at_parser_num_get(&parser, 31, &earfcn);
+	zassert_ok(err);
+	zassert_equal(earfcn, 3750);
+
+	err = at_parser_num_get(&parser, 36, &meas_time);
+	zassert_ok(err);
+	zassert_equal(meas_time, 1024701);
+
+	/* First neighbor cell */
+	err = at_parser_num_get(&parser, 12, &phys_cell_id);
+	zassert_ok(err);
+	zassert_equal(phys_cell_id, 12);
+
+	err = at_parser_num_get(&parser, 37, &earfcn);
+	zassert_equal(err, -EIO);
+}
+
+ZTEST(at_parser_benchmark, test_benchmark_xmonitor)
+{
+	benchmark("%XMONITOR", xmonitor_corpus, ARRAY_SIZE(xmonitor_corpus));
+}
+
+ZTEST(at_parser_benchmark, test_benchmark_ncellmeas)
+{
+	benchmark("%NCELLMEAS", ncellmeas_corpus, ARRAY_SIZE(ncellmeas_corpus));
+}
+
+ZTEST_SUITE(at_parser_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <errno.h>
+#include <data_fifo.h>
+
+#define SPSC_BLOCKS_NUM 8
+#define SPSC_BLOCK_SIZE 128
+
+/* Not a power of two, so the ring index does not follow the counters' natural wrap. */
+#define SPSC_WRAP_BLOCKS_NUM 5
+
+#define SPSC_THREAD_STACK_SIZE 1024
+#define SPSC_THREAD_PRIORITY   5
+#define SPSC_WAIT_TIMEOUT_MS   100
+
+#define BENCHMARK_ITERATIONS 10000
+#define BENCHMARK_DATA_SIZE  4
+
+static void spsc_put(struct data_fifo *data_fifo, uint8_t val)
+{
+	uint8_t *data_ptr;
+	int ret;
+
+	ret = data_fifo_pointer_first_vacant_get(data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	data_ptr[0] = val;
+
+	ret = data_fifo_block_lock(data_fifo, (void **)&data_ptr, sizeof(val));
+	zassert_equal(ret, 0, "block_lock did not return 0");
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_put_get_ok)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	uint32_t num_alloced;
+	uint32_t num_locked;
+	uint8_t *data_ptr;
+	size_t data_size;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	/* Wrap around the ring several times. */
+	for (uint32_t i = 0; i < (3 * SPSC_BLOCKS_NUM); i++) {
+		spsc_put(&data_fifo, i);
+		spsc_put(&data_fifo, i + 1);
+
+		ret = data_fifo_num_used_get(&data_fifo, &num_alloced, &num_locked);
+		zassert_equal(ret, 0, "num_used_get did not return 0");
+		zassert_equal(num_alloced, 2, "num_alloced %d", num_alloced);
+		zassert_equal(num_locked, 2, "num_locked %d", num_locked);
+
+		for (uint32_t j = 0; j < 2; j++) {
+			ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr,
+								&data_size, K_NO_WAIT);
+			zassert_equal(ret, 0, "last_filled_get did not return 0");
+			zassert_equal(data_size, 1, "data size incorrect");
+			zassert_equal(data_ptr[0], (uint8_t)(i + j), "data incorrect");
+
+			data_fifo_block_free(&data_fifo, data_ptr);
+		}
+	}
+
+	ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr, &data_size,
+						K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, "last_filled_get did not return -ENOMSG");
+
+	ret = data_fifo_num_used_get(&data_fifo, &num_alloced, &num_locked);
+	zassert_equal(ret, 0, "num_used_get did not return 0");
+	zassert_equal(num_alloced, 0, "num_alloced %d", num_alloced);
+	zassert_equal(num_locked, 0, "num_locked %d", num_locked);
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_put_too_many)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	uint8_t *data_ptr;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	for (uint32_t i = 0; i < SPSC_BLOCKS_NUM; i++) {
+		spsc_put(&data_fifo, i);
+	}
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "first_vacant_get did not return -ENOMEM");
+
+	ret = data_fifo_uninit(&data_fifo);
+	zassert_equal(ret, 0, "uninit did not return 0");
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_lock_out_of_order)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	uint8_t *data_ptr_1;
+	uint8_t *data_ptr_2;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr_1, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr_2, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr_2, 1);
+	zassert_equal(ret, -ESPIPE, "block_lock did not return -ESPIPE");
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_counter_wrap)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_WRAP_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	uint32_t num_alloced;
+	uint32_t num_locked;
+	uint8_t *data_ptr;
+	size_t data_size;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	/* Start just before the counters wrap. */
+	atomic_set(&data_fifo.spsc_state.alloced, 2 * SPSC_WRAP_BLOCKS_NUM - 2);
+	atomic_set(&data_fifo.spsc_state.locked, 2 * SPSC_WRAP_BLOCKS_NUM - 2);
+	atomic_set(&data_fifo.spsc_state.read, 2 * SPSC_WRAP_BLOCKS_NUM - 2);
+	atomic_set(&data_fifo.spsc_state.freed, 2 * SPSC_WRAP_BLOCKS_NUM - 2);
+
+	for (uint32_t i = 0; i < (3 * SPSC_WRAP_BLOCKS_NUM); i++) {
+		/* Fill the ring across the wrap. */
+		for (uint32_t j = 0; j < SPSC_WRAP_BLOCKS_NUM; j++) {
+			spsc_put(&data_fifo, i + j);
+		}
+
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr,
+							 K_NO_WAIT);
+		zassert_equal(ret, -ENOMEM, "first_vacant_get did not return -ENOMEM");
+
+		ret = data_fifo_num_used_get(&data_fifo, &num_alloced, &num_locked);
+		zassert_equal(ret, 0, "num_used_get did not return 0");
+		zassert_equal(num_alloced, SPSC_WRAP_BLOCKS_NUM, "num_alloced %d", num_alloced);
+		zassert_equal(num_locked, SPSC_WRAP_BLOCKS_NUM, "num_locked %d", num_locked);
+
+		for (uint32_t j = 0; j < SPSC_WRAP_BLOCKS_NUM; j++) {
+			ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr,
+								&data_size, K_NO_WAIT);
+			zassert_equal(ret, 0, "last_filled_get did not return 0");
+			zassert_equal(data_ptr[0], (uint8_t)(i + j), "data incorrect");
+
+			data_fifo_block_free(&data_fifo, data_ptr);
+		}
+
+		/* Shift the start of the next fill by one block. */
+		spsc_put(&data_fifo, 0);
+
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr,
+							&data_size, K_NO_WAIT);
+		zassert_equal(ret, 0, "last_filled_get did not return 0");
+
+		data_fifo_block_free(&data_fifo, data_ptr);
+
+		ret = data_fifo_num_used_get(&data_fifo, &num_alloced, &num_locked);
+		zassert_equal(ret, 0, "num_used_get did not return 0");
+		zassert_equal(num_alloced, 0, "num_alloced %d", num_alloced);
+		zassert_equal(num_locked, 0, "num_locked %d", num_locked);
+	}
+}
+
+K_THREAD_STACK_DEFINE(spsc_consumer_stack, SPSC_THREAD_STACK_SIZE);
+static struct k_thread spsc_consumer_thread;
+
+struct spsc_consumer_result {
+	struct data_fifo *data_fifo;
+	k_timeout_t timeout;
+	int ret;
+	uint8_t data;
+	int64_t waited_ms;
+};
+
+static void spsc_consumer(void *p1, void *p2, void *p3)
+{
+	struct spsc_consumer_result *result = p1;
+	uint8_t *data_ptr;
+	size_t data_size;
+	int64_t start = k_uptime_get();
+
+	result->ret = data_fifo_pointer_last_filled_get(result->data_fifo, (void **)&data_ptr,
+							&data_size, result->timeout);
+	result->waited_ms = k_uptime_get() - start;
+
+	if (result->ret == 0) {
+		result->data = data_ptr[0];
+		data_fifo_block_free(result->data_fifo, data_ptr);
+	}
+}
+
+static k_tid_t spsc_consumer_start(struct spsc_consumer_result *result)
+{
+	return k_thread_create(&spsc_consumer_thread, spsc_consumer_stack,
+			       K_THREAD_STACK_SIZEOF(spsc_consumer_stack), spsc_consumer, result,
+			       NULL, NULL, K_PRIO_PREEMPT(SPSC_THREAD_PRIORITY), 0, K_NO_WAIT);
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_consumer_wake)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	struct spsc_consumer_result result = {.data_fifo = &data_fifo, .timeout = K_FOREVER};
+	k_tid_t tid;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	tid = spsc_consumer_start(&result);
+
+	/* Let the consumer block on the empty FIFO. */
+	k_sleep(K_MSEC(10));
+
+	ret = k_thread_join(tid, K_NO_WAIT);
+	zassert_equal(ret, -EBUSY, "consumer did not block on the empty FIFO");
+
+	spsc_put(&data_fifo, 0xAA);
+
+	ret = k_thread_join(tid, K_MSEC(SPSC_WAIT_TIMEOUT_MS));
+	zassert_equal(ret, 0, "consumer was not woken up");
+	zassert_equal(result.ret, 0, "last_filled_get did not return 0");
+	zassert_equal(result.data, 0xAA, "data incorrect");
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_consumer_timeout)
+{
+	DATA_FIFO_SPSC_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	struct spsc_consumer_result result = {.data_fifo = &data_fifo,
+					      .timeout = K_MSEC(SPSC_WAIT_TIMEOUT_MS)};
+	k_tid_t tid;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	tid = spsc_consumer_start(&result);
+
+	/* Wake the consumer without data several times. The timeout must still be counted from
+	 * the start of the call.
+	 */
+	for (int i = 0; i < 4; i++) {
+		k_sleep(K_MSEC(SPSC_WAIT_TIMEOUT_MS / 3));
+		k_sem_give(&data_fifo.spsc_state.filled_sem);
+	}
+
+	ret = k_thread_join(tid, K_MSEC(SPSC_WAIT_TIMEOUT_MS));
+	zassert_equal(ret, 0, "consumer did not return");
+	zassert_equal(result.ret, -EAGAIN, "last_filled_get did not return -EAGAIN");
+	zassert_within(result.waited_ms, SPSC_WAIT_TIMEOUT_MS, SPSC_WAIT_TIMEOUT_MS / 4,
+		       "waited %lld ms", result.waited_ms);
+}
+
+static uint64_t benchmark_run(struct data_fifo *data_fifo)
+{
+	timing_t start;
+	timing_t end;
+	void *data_ptr;
+	size_t data_size;
+	int ret;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		ret = data_fifo_pointer_first_vacant_get(data_fifo, &data_ptr, K_NO_WAIT);
+		__ASSERT_NO_MSG(ret == 0);
+		ret = data_fifo_block_lock(data_fifo, &data_ptr, BENCHMARK_DATA_SIZE);
+		__ASSERT_NO_MSG(ret == 0);
+		ret = data_fifo_pointer_last_filled_get(data_fifo, &data_ptr, &data_size,
+							K_NO_WAIT);
+		__ASSERT_NO_MSG(ret == 0);
+		data_fifo_block_free(data_fifo, data_ptr);
+	}
+
+	end = timing_counter_get();
+
+	return timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCHMARK_ITERATIONS;
+}
+
+ZTEST(suite_data_fifo_spsc, test_data_fifo_spsc_benchmark)
+{
+	DATA_FIFO_DEFINE(data_fifo, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+	DATA_FIFO_SPSC_DEFINE(data_fifo_spsc, SPSC_BLOCKS_NUM, SPSC_BLOCK_SIZE);
+
+	uint64_t ns;
+	uint64_t ns_spsc;
+	int ret;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_init(&data_fifo_spsc);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	timing_init();
+	timing_start();
+
+	ns = benchmark_run(&data_fifo);
+	ns_spsc = benchmark_run(&data_fifo_spsc);
+
+	timing_stop();
+
+	TC_PRINT("put/get/free round trip: data_fifo %llu ns, SPSC data_fifo %llu ns\n", ns,
+		 ns_spsc);
+}
+
+ZTEST_SUITE(suite_data_fifo_spsc, NULL, NULL, NULL, NULL, NULL);
@@ -1497,6 +1497,22 @@ void test_error_wifi_cellular_method(void)
 	TEST_ASSERT_EQUAL(-EINVAL, err);
 }
 
+/* Test location request with LOCATION_REQ_MODE_RACE when the mode is not enabled. */
+void test_error_mode_race_not_enabled(void)
+{
+#if !defined(CONFIG_LOCATION_REQUEST_MODE_RACE)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_RACE;
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+#endif
+}
+
 /* Test cancelling location request when there is no pending location request. */
 void test_error_cancel_no_operation(void)
 {
@@ -1921,6 +1937,345 @@ void test_location_request_mode_all_cellular_error_gnss_timeout(void)
 	k_sleep(K_MSEC(1));
 }
 
+/********* TESTS FOR LOCATION_REQ_MODE_RACE ***********************/
+
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+#if defined(CONFIG_LOCATION_TEST_AGNSS)
+/* Valid assistance data, so that GNSS does not request any */
+static struct nrf_modem_gnss_agnss_expiry race_agnss_expiry = {
+	.data_flags = 0,
+	.utc_expiry = 0xffff,
+	.klob_expiry = 0xffff,
+	.neq_expiry = 0xffff,
+	.integrity_expiry = 0xffff,
+	.position_expiry = 0xffff
+};
+#endif
+
+static struct location_data race_cellular_location = {
+	.latitude = 61.50375,
+	.longitude = 23.896979,
+	.accuracy = 750.0,
+	.datetime.valid = false
+};
+
+/* Expect LOCATION_EVT_STARTED for both methods. */
+static void race_started_expect(void)
+{
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+#endif
+}
+
+/* Wait for LOCATION_EVT_STARTED, which is sent for both methods before location_request()
+ * returns.
+ */
+static void race_started_wait(void)
+{
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	int err;
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(2, location_cb_occurred);
+#endif
+}
+
+/* Expect cellular and GNSS to be started at the same time. */
+static void race_methods_start_expect(void)
+{
+	/* Cellular */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	/* GNSS */
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+#if defined(CONFIG_LOCATION_TEST_AGNSS)
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ExpectAndReturn(NULL, 0);
+	__cmock_nrf_modem_gnss_agnss_expiry_get_IgnoreArg_agnss_expiry();
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ReturnMemThruPtr_agnss_expiry(
+		&race_agnss_expiry, sizeof(race_agnss_expiry));
+#endif
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+	__cmock_nrf_modem_gnss_start_ExpectAndReturn(0);
+
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+#if !defined(CONFIG_LOCATION_TEST_AGNSS)
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp, sizeof(xmonitor_resp));
+#endif
+}
+
+/* Set the GNSS fix that the next PVT event reads, and the location it results in. */
+static void race_gnss_fix_set(struct location_event_data *expected)
+{
+	test_pvt_data.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID;
+	test_pvt_data.latitude = 60.987;
+	test_pvt_data.longitude = -45.997;
+	test_pvt_data.accuracy = 15.83;
+	test_pvt_data.datetime.year = 2021;
+	test_pvt_data.datetime.month = 8;
+	test_pvt_data.datetime.day = 2;
+	test_pvt_data.datetime.hour = 12;
+	test_pvt_data.datetime.minute = 34;
+	test_pvt_data.datetime.seconds = 23;
+	test_pvt_data.datetime.ms = 789;
+
+	expected->id = LOCATION_EVT_LOCATION;
+	expected->method = LOCATION_METHOD_GNSS;
+	expected->location.latitude = 60.987;
+	expected->location.longitude = -45.997;
+	expected->location.accuracy = 15.83;
+	expected->location.datetime.valid = true;
+	expected->location.datetime.year = 2021;
+	expected->location.datetime.month = 8;
+	expected->location.datetime.day = 2;
+	expected->location.datetime.hour = 12;
+	expected->location.datetime.minute = 34;
+	expected->location.datetime.second = 23;
+	expected->location.datetime.ms = 789;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	expected->location.details.gnss.pvt_data = test_pvt_data;
+#endif
+}
+
+/* Trigger the GNSS fix set with race_gnss_fix_set(). */
+static void race_gnss_fix_trigger(void)
+{
+	__cmock_nrf_modem_gnss_read_ExpectAndReturn(
+		NULL, sizeof(test_pvt_data), NRF_MODEM_GNSS_DATA_PVT, 0);
+	__cmock_nrf_modem_gnss_read_IgnoreArg_buf();
+	__cmock_nrf_modem_gnss_read_ReturnMemThruPtr_buf(&test_pvt_data, sizeof(test_pvt_data));
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+	method_gnss_event_handler(NRF_MODEM_GNSS_EVT_PVT);
+}
+#endif
+
+/* Test LOCATION_REQ_MODE_RACE when GNSS meets the accuracy target first:
+ * - GNSS location is returned while cellular is still measuring neighbor cells
+ * - Cellular is cancelled
+ * - A late cellular result is ignored
+ */
+void test_location_request_mode_race_target_met(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_RACE;
+	config.accuracy_target = 50;
+	config.methods[0].cellular.cell_count = 1;
+
+	race_started_expect();
+
+	race_gnss_fix_set(&test_location_event_data[location_cb_expected]);
+	location_cb_expected++;
+
+	race_methods_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+	race_started_wait();
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/* GNSS fix meets the accuracy target, so the cellular scan is stopped */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", 0);
+	race_gnss_fix_trigger();
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* The request is complete, the cellular result no longer has any effect */
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS,
+					       &race_cellular_location);
+
+	/* Need to wait a bit because no %NCELLMEAS notification is sent after AT%NCELLMEASSTOP. */
+	k_sleep(K_MSEC(2100));
+#endif
+}
+
+/* Test LOCATION_REQ_MODE_RACE when no method meets the accuracy target:
+ * - Cellular location is kept while GNSS is still running
+ * - The more accurate GNSS location is returned once both methods are done
+ */
+void test_location_request_mode_race_target_not_met(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_RACE;
+	config.accuracy_target = 10;
+	config.methods[0].cellular.cell_count = 1;
+
+	race_started_expect();
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	race_gnss_fix_set(&test_location_event_data[location_cb_expected]);
+	location_cb_expected++;
+
+	race_methods_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+	race_started_wait();
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/* Cellular finishes first, with a location that does not meet the accuracy target */
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS,
+					       &race_cellular_location);
+	k_sleep(K_MSEC(10));
+	TEST_ASSERT_EQUAL(location_cb_expected - 1, location_cb_occurred);
+
+	/* GNSS finishes last, and its location is the most accurate */
+	race_gnss_fix_trigger();
+	k_sleep(K_MSEC(1));
+#endif
+}
+
+/* Test LOCATION_REQ_MODE_RACE when the entire location request times out:
+ * - Cellular location does not meet the accuracy target and GNSS gets no fix
+ * - GNSS is stopped on the timeout
+ * - The best location so far is returned
+ */
+void test_location_request_mode_race_timeout(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_RACE;
+	config.accuracy_target = 50;
+	config.timeout = 500;
+	config.methods[0].cellular.cell_count = 1;
+
+	race_started_expect();
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	test_location_event_data[location_cb_expected].location = race_cellular_location;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].location.details.cellular.ncells_count = 1;
+	test_location_event_data[location_cb_expected].location.details.cellular.gci_cells_count =
+		0;
+#endif
+	location_cb_expected++;
+
+	race_methods_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+	race_started_wait();
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* GNSS is stopped when the location request times out */
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS,
+					       &race_cellular_location);
+	k_sleep(K_MSEC(10));
+	TEST_ASSERT_EQUAL(location_cb_expected - 1, location_cb_occurred);
+
+	/* Wait for the location request timeout, which returns the cellular location */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+}
+
+/* Test LOCATION_REQ_MODE_RACE when the entire location request times out before any method
+ * reports:
+ * - Both methods are stopped on the timeout
+ * - The timeout is reported for the first method
+ */
+void test_location_request_mode_race_timeout_no_result(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_RACE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_RACE;
+	config.accuracy_target = 50;
+	config.timeout = 500;
+	config.methods[0].cellular.cell_count = 1;
+
+	race_started_expect();
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_TIMEOUT;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	race_methods_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+	race_started_wait();
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/* Cellular and GNSS are stopped when the location request times out */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", 0);
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* Need to wait a bit because no %NCELLMEAS notification is sent after AT%NCELLMEASSTOP. */
+	k_sleep(K_MSEC(2100));
+#endif
+}
+
 /********* TESTS PERIODIC POSITIONING REQUESTS ***********************/
 
 /* Test periodic location request and cancel it once some iterations are done. */
@@ -1629,6 +1629,97 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	TEST_ASSERT_EQUAL(ret, 0);
 }
 
+void test_nrf9x_socket_offload_sendmsg_single_iov_no_copy(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = AF_INET;
+	int type = SOCK_STREAM;
+	int proto = IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct msghdr msg = { 0 };
+	struct iovec chunks[2] = { 0 };
+	/* Larger than the intermediate buffer */
+	int data[3] = { 42, 43, 44 };
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	/* An empty part does not count */
+	chunks[0].iov_base = NULL;
+	chunks[0].iov_len = 0;
+	chunks[1].iov_base = data;
+	chunks[1].iov_len = sizeof(data);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 2;
+
+	/* The caller's buffer is passed through, in one call */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, data, sizeof(data),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, sizeof(data));
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, sizeof(data));
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
+void test_nrf9x_socket_offload_sendmsg_dgram_not_fits_buf(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = AF_INET;
+	int type = SOCK_DGRAM;
+	int proto = IPPROTO_UDP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct msghdr msg = { 0 };
+	struct iovec chunks[3] = { 0 };
+	int chunk_1 = 42;
+	int chunk_2 = 43;
+	int chunk_3 = 44;
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_DGRAM, NRF_IPPROTO_UDP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	chunks[0].iov_base = &chunk_1;
+	chunks[0].iov_len = sizeof(int);
+	chunks[1].iov_base = &chunk_2;
+	chunks[1].iov_len = sizeof(int);
+	chunks[2].iov_base = &chunk_3;
+	chunks[2].iov_len = sizeof(int);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 3;
+
+	/* The datagram is not split, even though it does not fit the intermediate buffer */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 3 * sizeof(int),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, 3 * sizeof(int));
+	__cmock_nrf_sendto_IgnoreArg_message();
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, 3 * sizeof(int));
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
 void test_nrf9x_socket_offload_fcntl_einval(void)
 {
 	int ret;
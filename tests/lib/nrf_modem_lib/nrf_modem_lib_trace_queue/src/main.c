@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/fff.h>
+#include <modem/nrf_modem_lib.h>
+#include <modem/trace_backend.h>
+
+#include "nrf_modem_lib_trace.h"
+
+#include "cmock_trace_backend_mock.h"
+#include "cmock_nrf_modem.h"
+#include "cmock_nrf_modem_trace.h"
+#include "cmock_nrf_modem_os.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC_VARARG(int, nrf_modem_at_printf, const char *, ...);
+
+LOG_MODULE_REGISTER(trace_queue_test, CONFIG_NRF_MODEM_LIB_TRACE_QUEUE_TEST_LOG_LEVEL);
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+extern void nrf_modem_lib_trace_init(void);
+
+/* Larger than the trace queue, to have the modem wait for the backend */
+#define TRACE_DATA_SIZE 1000
+#define TRACE_FRAG_SIZE 100
+
+#define WAIT_TIMEOUT K_SECONDS(1)
+
+static uint8_t trace_data[TRACE_DATA_SIZE];
+static uint8_t written[TRACE_DATA_SIZE];
+static size_t written_len;
+static size_t processed_len;
+static int processed_num_calls;
+
+static struct nrf_modem_trace_data *get_frags;
+static size_t get_n_frags;
+static int nrf_modem_trace_get_error;
+static int trace_backend_write_error;
+static bool trace_backend_write_blocked;
+
+static int callback_evt;
+
+K_SEM_DEFINE(get_sem, 0, 1);
+K_SEM_DEFINE(processed_sem, 0, 1);
+K_SEM_DEFINE(write_gate_sem, 0, 1);
+K_SEM_DEFINE(written_sem, 0, 1);
+K_SEM_DEFINE(backend_deinit_sem, 0, 1);
+
+/* This is the override for the _weak callback. */
+void nrf_modem_lib_trace_callback(enum nrf_modem_lib_trace_event evt)
+{
+	callback_evt = evt;
+}
+
+void setUp(void)
+{
+	for (size_t i = 0; i < sizeof(trace_data); i++) {
+		trace_data[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	memset(written, 0, sizeof(written));
+	written_len = 0;
+	processed_len = 0;
+	processed_num_calls = 0;
+
+	get_frags = NULL;
+	get_n_frags = 0;
+	nrf_modem_trace_get_error = 0;
+	trace_backend_write_error = 0;
+	trace_backend_write_blocked = false;
+	callback_evt = -1;
+
+	k_sem_reset(&get_sem);
+	k_sem_reset(&processed_sem);
+	k_sem_reset(&write_gate_sem);
+	k_sem_reset(&written_sem);
+	k_sem_reset(&backend_deinit_sem);
+
+	RESET_FAKE(nrf_modem_at_printf);
+}
+
+/* Blocks like the modem library does, until the test hands over fragments or an error. */
+int nrf_modem_trace_get_stub(struct nrf_modem_trace_data **frags, size_t *n_frags, int timeout,
+			     int cmock_num_calls)
+{
+	k_sem_take(&get_sem, K_FOREVER);
+
+	if (nrf_modem_trace_get_error) {
+		return nrf_modem_trace_get_error;
+	}
+
+	*frags = get_frags;
+	*n_frags = get_n_frags;
+
+	return 0;
+}
+
+int nrf_modem_trace_processed_stub(size_t len, int cmock_num_calls)
+{
+	processed_len += len;
+	processed_num_calls = cmock_num_calls + 1;
+	k_sem_give(&processed_sem);
+
+	return 0;
+}
+
+int trace_backend_write_stub(const void *data, size_t len, int cmock_num_calls)
+{
+	if (trace_backend_write_blocked) {
+		k_sem_take(&write_gate_sem, K_FOREVER);
+	}
+
+	if (trace_backend_write_error) {
+		return trace_backend_write_error;
+	}
+
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(written) - written_len, len);
+
+	/* The data points into the queue, which is reused once the write returns */
+	memcpy(&written[written_len], data, len);
+	written_len += len;
+	k_sem_give(&written_sem);
+
+	return (int)len;
+}
+
+int trace_backend_deinit_stub(int cmock_num_calls)
+{
+	k_sem_give(&backend_deinit_sem);
+
+	return 0;
+}
+
+static void trace_start(void)
+{
+	/* The backend is given the queue's processed callback, not the modem library's */
+	__cmock_trace_backend_init_ExpectAnyArgsAndReturn(0);
+	__cmock_nrf_modem_trace_get_Stub(nrf_modem_trace_get_stub);
+	__cmock_nrf_modem_trace_processed_Stub(nrf_modem_trace_processed_stub);
+	__cmock_trace_backend_write_Stub(trace_backend_write_stub);
+	__cmock_trace_backend_deinit_Stub(trace_backend_deinit_stub);
+
+	nrf_modem_lib_trace_init();
+}
+
+static void trace_frags_give(struct nrf_modem_trace_data *frags, size_t n_frags)
+{
+	get_frags = frags;
+	get_n_frags = n_frags;
+	k_sem_give(&get_sem);
+}
+
+static void trace_stop(int err)
+{
+	nrf_modem_trace_get_error = err;
+	k_sem_give(&get_sem);
+}
+
+static void trace_write_unblock(void)
+{
+	trace_backend_write_blocked = false;
+	k_sem_give(&write_gate_sem);
+}
+
+static void wait_processed(size_t len)
+{
+	while (processed_len < len) {
+		TEST_ASSERT_EQUAL(0, k_sem_take(&processed_sem, WAIT_TIMEOUT));
+	}
+
+	TEST_ASSERT_EQUAL_size_t(len, processed_len);
+}
+
+static void wait_written(size_t len)
+{
+	while (written_len < len) {
+		TEST_ASSERT_EQUAL(0, k_sem_take(&written_sem, WAIT_TIMEOUT));
+	}
+
+	TEST_ASSERT_EQUAL_size_t(len, written_len);
+	TEST_ASSERT_EQUAL_MEMORY(trace_data, written, len);
+}
+
+static void wait_trace_deinit(void)
+{
+	TEST_ASSERT_EQUAL(0, k_sem_take(&backend_deinit_sem, WAIT_TIMEOUT));
+}
+
+void test_trace_queue_frag_processed_before_write(void)
+{
+	struct nrf_modem_trace_data frag = {
+		.data = trace_data,
+		.len = TRACE_FRAG_SIZE,
+	};
+
+	trace_backend_write_blocked = true;
+
+	trace_start();
+	trace_frags_give(&frag, 1);
+
+	/* The modem gets the fragment back while the backend is still busy */
+	wait_processed(TRACE_FRAG_SIZE);
+	TEST_ASSERT_EQUAL_size_t(0, written_len);
+
+	trace_write_unblock();
+	wait_written(TRACE_FRAG_SIZE);
+
+	trace_stop(-ESHUTDOWN);
+	wait_trace_deinit();
+}
+
+void test_trace_queue_full_waits_for_backend(void)
+{
+	struct nrf_modem_trace_data frag = {
+		.data = trace_data,
+		.len = TRACE_DATA_SIZE,
+	};
+
+	trace_start();
+	trace_frags_give(&frag, 1);
+
+	/* The fragment does not fit the queue, so it is queued and released in parts */
+	wait_processed(TRACE_DATA_SIZE);
+	TEST_ASSERT_GREATER_THAN(1, processed_num_calls);
+
+	wait_written(TRACE_DATA_SIZE);
+
+	trace_stop(-ESHUTDOWN);
+	wait_trace_deinit();
+}
+
+void test_trace_queue_drained_on_deinit(void)
+{
+	struct nrf_modem_trace_data frags[] = {
+		{ .data = &trace_data[0], .len = TRACE_FRAG_SIZE },
+		{ .data = &trace_data[TRACE_FRAG_SIZE], .len = TRACE_FRAG_SIZE },
+	};
+
+	trace_backend_write_blocked = true;
+
+	trace_start();
+	trace_frags_give(frags, ARRAY_SIZE(frags));
+	wait_processed(2 * TRACE_FRAG_SIZE);
+
+	/* No more traces, the backend must not be deinitialized before the queue is empty */
+	trace_stop(-ENODATA);
+	TEST_ASSERT_EQUAL(-EAGAIN, k_sem_take(&backend_deinit_sem, K_MSEC(100)));
+	TEST_ASSERT_EQUAL_size_t(0, written_len);
+
+	trace_write_unblock();
+
+	wait_trace_deinit();
+	wait_written(2 * TRACE_FRAG_SIZE);
+}
+
+void test_trace_queue_enospc(void)
+{
+	int ret;
+	struct nrf_modem_trace_data frags[] = {
+		{ .data = &trace_data[0], .len = TRACE_FRAG_SIZE },
+		{ .data = &trace_data[TRACE_FRAG_SIZE], .len = TRACE_FRAG_SIZE },
+	};
+
+	trace_backend_write_error = -ENOSPC;
+
+	trace_start();
+	trace_frags_give(&frags[0], 1);
+
+	/* The queue thread hands the full backend over to the application */
+	ret = nrf_modem_lib_trace_processing_done_wait(K_FOREVER);
+	TEST_ASSERT_EQUAL(-ENOSPC, ret);
+	TEST_ASSERT_EQUAL(NRF_MODEM_LIB_TRACE_EVT_FULL, callback_evt);
+
+	/* Traces keep being released to the modem while the backend is full */
+	trace_frags_give(&frags[1], 1);
+	wait_processed(2 * TRACE_FRAG_SIZE);
+	TEST_ASSERT_EQUAL_size_t(0, written_len);
+
+	/* Clear space, make sure the queued traces are written in order */
+	trace_backend_write_error = 0;
+
+	__cmock_trace_backend_clear_ExpectAndReturn(0);
+	ret = nrf_modem_lib_trace_clear();
+	TEST_ASSERT_EQUAL(0, ret);
+
+	wait_written(2 * TRACE_FRAG_SIZE);
+
+	trace_stop(-ESHUTDOWN);
+	wait_trace_deinit();
+}
+
+void test_trace_queue_write_efault(void)
+{
+	struct nrf_modem_trace_data frag = {
+		.data = trace_data,
+		.len = TRACE_FRAG_SIZE,
+	};
+
+	trace_backend_write_error = -EFAULT;
+
+	trace_start();
+	trace_frags_give(&frag, 1);
+	wait_processed(TRACE_FRAG_SIZE);
+
+	/* The write error is picked up with the next fragment, and tracing is stopped */
+	k_sleep(K_MSEC(10));
+	trace_frags_give(&frag, 1);
+
+	wait_trace_deinit();
+	TEST_ASSERT_EQUAL_size_t(0, written_len);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
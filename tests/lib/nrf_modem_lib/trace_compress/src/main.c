@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "trace_compress.h"
+
+#define BLOCK_SIZE 2048
+
+static uint8_t src[BLOCK_SIZE];
+static uint8_t out[TRACE_COMPRESS_BOUND(BLOCK_SIZE)];
+static uint8_t decoded[BLOCK_SIZE];
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+static size_t length_get(const uint8_t **ip, size_t len)
+{
+	uint8_t b;
+
+	if (len == 15) {
+		do {
+			b = *(*ip)++;
+			len += b;
+		} while (b == 255);
+	}
+
+	return len;
+}
+
+/* Reference LZ4 block decoder */
+static size_t lz4_block_decode(const uint8_t *ip, size_t len, uint8_t *dst, size_t dst_size)
+{
+	const uint8_t *end = ip + len;
+	uint8_t *op = dst;
+	uint8_t token;
+	size_t n;
+	size_t offset;
+
+	while (ip < end) {
+		token = *ip++;
+
+		n = length_get(&ip, token >> 4);
+		TEST_ASSERT_LESS_OR_EQUAL(dst_size, (op - dst) + n);
+		memcpy(op, ip, n);
+		op += n;
+		ip += n;
+
+		if (ip == end) {
+			break;
+		}
+
+		offset = sys_get_le16(ip);
+		ip += 2;
+		TEST_ASSERT_NOT_EQUAL(0, offset);
+		TEST_ASSERT_LESS_OR_EQUAL(op - dst, offset);
+
+		n = length_get(&ip, token & 0x0F) + 4;
+		TEST_ASSERT_LESS_OR_EQUAL(dst_size, (op - dst) + n);
+		while (n--) {
+			*op = op[-offset];
+			op++;
+		}
+	}
+
+	return op - dst;
+}
+
+static void round_trip(size_t len)
+{
+	size_t out_len;
+	size_t block_len;
+	size_t decoded_len;
+	uint32_t block_size;
+	const uint8_t *block;
+
+	out_len = trace_compress(src, len, out);
+	TEST_ASSERT_LESS_OR_EQUAL(TRACE_COMPRESS_BOUND(len), out_len);
+
+	/* LZ4 frame header: magic, independent blocks of at most 64 KB, header checksum */
+	TEST_ASSERT_EQUAL_HEX32(0x184D2204, sys_get_le32(out));
+	TEST_ASSERT_EQUAL_HEX8(0x60, out[4]);
+	TEST_ASSERT_EQUAL_HEX8(0x40, out[5]);
+	TEST_ASSERT_EQUAL_HEX8(0x82, out[6]);
+
+	block_size = sys_get_le32(&out[7]);
+	block_len = block_size & ~BIT(31);
+	block = &out[11];
+	TEST_ASSERT_EQUAL(out_len, TRACE_COMPRESS_FRAME_OVERHEAD + block_len);
+
+	/* End mark */
+	TEST_ASSERT_EQUAL_HEX32(0, sys_get_le32(&block[block_len]));
+
+	if (block_size & BIT(31)) {
+		TEST_ASSERT_EQUAL(len, block_len);
+		TEST_ASSERT_EQUAL_MEMORY(src, block, len);
+		return;
+	}
+
+	TEST_ASSERT_LESS_THAN(len, block_len);
+
+	decoded_len = lz4_block_decode(block, block_len, decoded, sizeof(decoded));
+	TEST_ASSERT_EQUAL(len, decoded_len);
+	TEST_ASSERT_EQUAL_MEMORY(src, decoded, len);
+}
+
+void test_trace_compress_empty(void)
+{
+	round_trip(0);
+}
+
+void test_trace_compress_short(void)
+{
+	memset(src, 0xAA, sizeof(src));
+
+	/* Too short to hold a match */
+	for (size_t len = 1; len <= 16; len++) {
+		round_trip(len);
+	}
+}
+
+void test_trace_compress_repetitive(void)
+{
+	size_t out_len;
+
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = i % 64 < 8 ? sys_rand32_get() : i % 64;
+	}
+
+	round_trip(sizeof(src));
+
+	/* Expect a good compression ratio on repetitive data */
+	out_len = trace_compress(src, sizeof(src), out);
+	TEST_ASSERT_LESS_THAN(sizeof(src) / 2, out_len);
+}
+
+void test_trace_compress_long_runs(void)
+{
+	/* Literal and match lengths that need extra length bytes */
+	sys_rand_get(src, 300);
+	memset(&src[300], 0x55, sizeof(src) - 300);
+
+	round_trip(sizeof(src));
+}
+
+void test_trace_compress_random(void)
+{
+	size_t out_len;
+
+	sys_rand_get(src, sizeof(src));
+
+	/* Incompressible data is stored as is */
+	out_len = trace_compress(src, sizeof(src), out);
+	TEST_ASSERT_EQUAL(TRACE_COMPRESS_FRAME_OVERHEAD + sizeof(src), out_len);
+
+	round_trip(sizeof(src));
+}
+
+void test_trace_compress_mixed(void)
+{
+	for (int i = 0; i < 100; i++) {
+		size_t len = sys_rand32_get() % sizeof(src);
+
+		for (size_t j = 0; j < len; j++) {
+			src[j] = (i & 1) ? sys_rand32_get() % 4 : j % (i + 1);
+		}
+
+		round_trip(len);
+	}
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
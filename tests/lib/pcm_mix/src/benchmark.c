@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <pcm_mix.h>
+
+/* One 10 ms stereo frame at 48 kHz */
+#define FRAME_SAMPLES_MONO 480
+#define FRAME_SAMPLES_STEREO (FRAME_SAMPLES_MONO * 2)
+#define BENCHMARK_ITERATIONS 1000
+
+static int32_t pcm_a[FRAME_SAMPLES_STEREO];
+static int32_t pcm_b[FRAME_SAMPLES_STEREO];
+
+static void benchmark_run(const char *name, size_t size_a, size_t size_b,
+			  enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth)
+{
+	timing_t start;
+	timing_t end;
+	uint64_t ns;
+	int ret;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		ret = pcm_mix_bit_depth(pcm_a, size_a, pcm_b, size_b, mix_mode, pcm_bit_depth);
+		zassert_equal(ret, 0, "pcm_mix_bit_depth returned %d", ret);
+	}
+
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCHMARK_ITERATIONS;
+
+	TC_PRINT("%s, %d-bit: %llu ns per frame\n", name, pcm_bit_depth, ns);
+}
+
+ZTEST(suite_pcm_mix_benchmark, test_benchmark)
+{
+	static const uint8_t bit_depths[] = {16, 24, 32};
+
+	for (size_t i = 0; i < ARRAY_SIZE(pcm_b); i++) {
+		pcm_b[i] = (int32_t)(i * 2654435761U);
+	}
+
+	timing_init();
+	timing_start();
+
+	ARRAY_FOR_EACH(bit_depths, i) {
+		size_t bytes_per_sample = bit_depths[i] / 8;
+
+		benchmark_run("Stereo into stereo", FRAME_SAMPLES_STEREO * bytes_per_sample,
+			      FRAME_SAMPLES_STEREO * bytes_per_sample, B_STEREO_INTO_A_STEREO,
+			      bit_depths[i]);
+		benchmark_run("Mono into stereo LR", FRAME_SAMPLES_STEREO * bytes_per_sample,
+			      FRAME_SAMPLES_MONO * bytes_per_sample, B_MONO_INTO_A_STEREO_LR,
+			      bit_depths[i]);
+		benchmark_run("Mono into stereo L", FRAME_SAMPLES_STEREO * bytes_per_sample,
+			      FRAME_SAMPLES_MONO * bytes_per_sample, B_MONO_INTO_A_STEREO_L,
+			      bit_depths[i]);
+	}
+
+	timing_stop();
+}
+
+ZTEST_SUITE(suite_pcm_mix_benchmark, NULL, NULL, NULL, NULL, NULL);
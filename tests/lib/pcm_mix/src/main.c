@@ -127,4 +127,93 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_mono_into_stereo_too_large)
+{
+	int ret;
+	int16_t sample_a[] = { 10, 10, 10, 10 };
+	int16_t sample_b[] = { -5, 5, 5 };
+	int16_t sample_r[] = { 10, 10, 10, 10 };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_L);
+	ZEQ(ret, -EPERM);
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_R);
+	ZEQ(ret, -EPERM);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_mono_into_stereo_saturate)
+{
+	int ret;
+	int16_t sample_a[] = { INT16_MAX, INT16_MIN, INT16_MIN, INT16_MAX, INT16_MAX, 0 };
+	int16_t sample_b[] = { 100, -100, 100 };
+	int16_t sample_r[] = { INT16_MAX, INT16_MIN + 100, INT16_MIN, INT16_MAX - 100,
+			       INT16_MAX, 100 };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_LR);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_odd_number_of_samples)
+{
+	int ret;
+	int16_t sample_a[] = { 1, 2, 3, 4, 5 };
+	int16_t sample_b[] = { 1, 1, 1, 1, INT16_MAX };
+	int16_t sample_r[] = { 2, 3, 4, 5, INT16_MAX };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), B_MONO_INTO_A_MONO);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_24_bit)
+{
+	int ret;
+	/* 0x7FFFFF, -0x800000, 0x000010, -0x000010 packed little-endian */
+	uint8_t sample_a[] = { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80,
+			       0x10, 0x00, 0x00, 0xF0, 0xFF, 0xFF };
+	/* 1, -1 */
+	uint8_t sample_b[] = { 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF };
+	/* 0x7FFFFF, -0x800000 + 1, 0x000010 - 1, -0x000010 - 1 */
+	uint8_t sample_r[] = { 0xFF, 0xFF, 0x7F, 0x01, 0x00, 0x80,
+			       0x0F, 0x00, 0x00, 0xEF, 0xFF, 0xFF };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+				B_MONO_INTO_A_STEREO_LR, 24);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_32_bit)
+{
+	int ret;
+	int32_t sample_a[] = { INT32_MAX, INT32_MIN, 10, -10 };
+	int32_t sample_b[] = { 1, -1, 10, -10 };
+	int32_t sample_r[] = { INT32_MAX, INT32_MIN, 20, -20 };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+				B_MONO_INTO_A_MONO, 32);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_invalid_bit_depth)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1, 2 };
+
+	ret = pcm_mix_bit_depth(sample_a, sizeof(sample_a), sample_a, sizeof(sample_a),
+				B_MONO_INTO_A_MONO, 8);
+	ZEQ(ret, -EINVAL);
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
@@ -8,6 +8,8 @@
 #include <zephyr/tc_util.h>
 #include <sample_rate_converter.h>
 #include <stdlib.h>
+#include <math.h>
+#include <string.h>
 
 struct sample_rate_converter_ctx conv_ctx;
 
@@ -333,8 +335,8 @@ ZTEST(suite_sample_rate_converter, test_init_valid_interpolate_16khz_16bit)
 /* Number of samples must be a define so the large array becomes a fixed size array that can be
  * initialized to all 0's
  */
-#define BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES 300
-ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_internal_buf_16bit)
+#define OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES 300
+ZTEST(suite_sample_rate_converter, test_valid_output_larger_than_block_size_16bit)
 {
 	int ret;
 
@@ -342,9 +344,9 @@ ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_int
 	uint32_t output_sample_rate = 48000;
 	uint32_t conversion_ratio = output_sample_rate / input_sample_rate;
 
-	uint16_t input_samples[BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES] = {0};
+	uint16_t input_samples[OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES] = {0};
 	size_t expected_output_samples =
-		BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES * conversion_ratio;
+		OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES * conversion_ratio;
 	uint16_t output_samples[expected_output_samples];
 
 	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_TEST;
@@ -352,13 +354,14 @@ ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_int
 
 	ret = sample_rate_converter_process(
 		&conv_ctx, filter, input_samples,
-		BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES * sizeof(uint16_t),
+		OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES * sizeof(uint16_t),
 		input_sample_rate, output_samples, expected_output_samples * sizeof(uint16_t),
 		&output_written, output_sample_rate);
 
-	zassert_equal(ret, -EINVAL,
-		      "Sample rate conversion did not fail when the number of produced output "
-		      "samples is larger than the internal output buf");
+	/* Only the input block and the output buffer limit the conversion */
+	zassert_equal(ret, 0, "Sample rate conversion process failed");
+	zassert_equal(output_written, expected_output_samples * sizeof(uint16_t),
+		      "Output size was not as expected (%d)", output_written);
 }
 
 ZTEST(suite_sample_rate_converter, test_valid_process_input_one_sample_interpolate)
@@ -759,8 +762,8 @@ ZTEST(suite_sample_rate_converter, test_init_valid_interpolate_16khz_32bit)
 /* Number of samples must be a define so the large array becomes a fixed size array that can be
  * initialized to all 0's
  */
-#define BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES 300
-ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_internal_buf_32bit)
+#define OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES 300
+ZTEST(suite_sample_rate_converter, test_valid_output_larger_than_block_size_32bit)
 {
 	int ret;
 
@@ -768,9 +771,9 @@ ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_int
 	uint32_t output_sample_rate = 48000;
 	uint32_t conversion_ratio = output_sample_rate / input_sample_rate;
 
-	uint32_t input_samples[BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES] = {0};
+	uint32_t input_samples[OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES] = {0};
 	size_t expected_output_samples =
-		BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES * conversion_ratio;
+		OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES * conversion_ratio;
 	uint32_t output_samples[expected_output_samples];
 
 	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_TEST;
@@ -778,13 +781,14 @@ ZTEST(suite_sample_rate_converter, test_invalid_bytes_produced_too_large_for_int
 
 	ret = sample_rate_converter_process(
 		&conv_ctx, filter, input_samples,
-		BYTES_PRODUCED_TOO_LARGE_FOR_INTERNAL_BUF_NUM_SAMPLES * sizeof(uint32_t),
+		OUTPUT_LARGER_THAN_BLOCK_SIZE_NUM_SAMPLES * sizeof(uint32_t),
 		input_sample_rate, output_samples, expected_output_samples * sizeof(uint32_t),
 		&output_written, output_sample_rate);
 
-	zassert_equal(ret, -EINVAL,
-		      "Sample rate conversion did not fail when the number of produced output "
-		      "samples is larger than the internal output buf");
+	/* Only the input block and the output buffer limit the conversion */
+	zassert_equal(ret, 0, "Sample rate conversion process failed");
+	zassert_equal(output_written, expected_output_samples * sizeof(uint32_t),
+		      "Output size was not as expected (%d)", output_written);
 }
 #endif /* CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32 */
 
@@ -1152,4 +1156,211 @@ ZTEST(suite_sample_rate_converter, test_invalid_process_output_buf_too_small)
 		      "Sample rate conversion process did not fail when output buffer is to small");
 }
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+#define POLYPHASE_BLOCKS_NUM 10
+
+/* The same signals are used for both bit depths, scaled to the sample size */
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef int16_t sample_t;
+#define SAMPLE_SCALE 1
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef int32_t sample_t;
+#define SAMPLE_SCALE (1 << 16)
+#endif
+
+#define TONE_AMPLITUDE (10000.0f * SAMPLE_SCALE)
+#define PI_F 3.14159265358979f
+
+static sample_t tone_output[POLYPHASE_BLOCKS_NUM * 480];
+
+/* Fill a block with a sine tone, continuing from the phase of the previous block */
+static void tone_fill(sample_t *buf, size_t samples, float freq, uint32_t sample_rate, float *phase)
+{
+	for (size_t i = 0; i < samples; i++) {
+		buf[i] = (sample_t)lrintf(TONE_AMPLITUDE * sinf(*phase));
+		*phase += 2.0f * PI_F * freq / sample_rate;
+		if (*phase > 2.0f * PI_F) {
+			*phase -= 2.0f * PI_F;
+		}
+	}
+}
+
+/* Amplitude of the frequency component freq in the samples, with the Goertzel algorithm */
+static float tone_amplitude(sample_t const *samples, size_t num, float freq, uint32_t sample_rate)
+{
+	float coeff = 2.0f * cosf(2.0f * PI_F * freq / sample_rate);
+	float s0;
+	float s1 = 0.0f;
+	float s2 = 0.0f;
+
+	for (size_t i = 0; i < num; i++) {
+		s0 = samples[i] + coeff * s1 - s2;
+		s2 = s1;
+		s1 = s0;
+	}
+
+	return 2.0f * sqrtf(s1 * s1 + s2 * s2 - coeff * s1 * s2) / num;
+}
+
+/* Convert POLYPHASE_BLOCKS_NUM 10 ms blocks of a tone, and return the number of output samples
+ * after the first block, where the filter is filled with the initial silence.
+ */
+static size_t tone_convert(float freq, uint32_t input_sample_rate, uint32_t output_sample_rate)
+{
+	int ret;
+	sample_t input_samples[480];
+	size_t input_num = input_sample_rate / 100;
+	size_t output_written;
+	size_t output_num = 0;
+	size_t skip_num = 0;
+	float phase = 0.0f;
+
+	for (int block = 0; block < POLYPHASE_BLOCKS_NUM; block++) {
+		tone_fill(input_samples, input_num, freq, input_sample_rate, &phase);
+
+		ret = sample_rate_converter_process(
+			&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+			input_num * sizeof(sample_t), input_sample_rate, &tone_output[output_num],
+			sizeof(tone_output) - output_num * sizeof(sample_t), &output_written,
+			output_sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		output_num += output_written / sizeof(sample_t);
+		if (block == 0) {
+			skip_num = output_num;
+		}
+	}
+
+	memmove(tone_output, &tone_output[skip_num], (output_num - skip_num) * sizeof(sample_t));
+
+	return output_num - skip_num;
+}
+
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_tone_frequency)
+{
+	size_t num;
+	float amplitude;
+
+	num = tone_convert(1000.0f, 44100, 48000);
+
+	/* The tone keeps its frequency and amplitude at the new sample rate */
+	amplitude = tone_amplitude(tone_output, num, 1000.0f, 48000);
+	zassert_within(amplitude, TONE_AMPLITUDE, TONE_AMPLITUDE / 50,
+		       "1 kHz amplitude not as expected (%d)", (int)amplitude);
+
+	/* Without frequency error there is no energy next to the tone */
+	amplitude = tone_amplitude(tone_output, num, 1200.0f, 48000);
+	zassert_true(amplitude < TONE_AMPLITUDE / 100, "1.2 kHz amplitude too large (%d)",
+		     (int)amplitude);
+
+	num = tone_convert(10000.0f, 48000, 44100);
+
+	amplitude = tone_amplitude(tone_output, num, 10000.0f, 44100);
+	zassert_within(amplitude, TONE_AMPLITUDE, TONE_AMPLITUDE / 50,
+		       "10 kHz amplitude not as expected (%d)", (int)amplitude);
+}
+
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_tone_aliasing)
+{
+	size_t num;
+	float amplitude;
+
+	/* 23 kHz is above the 22.05 kHz Nyquist frequency of the output, and aliases to
+	 * 21.1 kHz unless the filter removes it.
+	 */
+	num = tone_convert(23000.0f, 48000, 44100);
+
+	amplitude = tone_amplitude(tone_output, num, 44100.0f - 23000.0f, 44100);
+	zassert_true(amplitude < (TONE_AMPLITUDE * 15) / 100,
+		     "Alias not attenuated by more than 16 dB (%d)", (int)amplitude);
+}
+
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_44khz_to_48khz)
+{
+	int ret;
+
+	uint32_t input_sample_rate = 44100;
+	uint32_t output_sample_rate = 48000;
+	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	/* 10 ms blocks */
+	sample_t input_samples[441];
+	sample_t output_samples[480];
+	size_t output_written;
+
+	for (int i = 0; i < ARRAY_SIZE(input_samples); i++) {
+		input_samples[i] = 10000 * SAMPLE_SCALE;
+	}
+
+	for (int block = 0; block < POLYPHASE_BLOCKS_NUM; block++) {
+		ret = sample_rate_converter_process(
+			&conv_ctx, filter, input_samples, sizeof(input_samples), input_sample_rate,
+			output_samples, sizeof(output_samples), &output_written,
+			output_sample_rate);
+
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+		zassert_equal(conv_ctx.conversion_ratio, 0, "Conversion ratio not as expected");
+		zassert_equal(conv_ctx.filter_type, filter, "Filter set incorrectly");
+		zassert_equal(output_written, sizeof(output_samples),
+			      "Output size was not as expected (%d)", output_written);
+
+		/* Skip the first block, where the filter is filled with the initial silence */
+		if (block == 0) {
+			continue;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(output_samples); i++) {
+			zassert_within(output_samples[i], input_samples[0], 2 * SAMPLE_SCALE,
+				       "Output sample %d not within expected range (%d)", i,
+				       output_samples[i]);
+		}
+	}
+}
+
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_48khz_to_44khz)
+{
+	int ret;
+
+	uint32_t input_sample_rate = 48000;
+	uint32_t output_sample_rate = 44100;
+	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	sample_t input_samples[480] = {0};
+	sample_t output_samples[441];
+	size_t output_written;
+	size_t output_written_total = 0;
+
+	for (int block = 0; block < POLYPHASE_BLOCKS_NUM; block++) {
+		ret = sample_rate_converter_process(
+			&conv_ctx, filter, input_samples, sizeof(input_samples), input_sample_rate,
+			output_samples, sizeof(output_samples), &output_written,
+			output_sample_rate);
+
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+		output_written_total += output_written;
+	}
+
+	/* The number of output samples per block varies, but no samples are lost over time */
+	zassert_equal(output_written_total, POLYPHASE_BLOCKS_NUM * sizeof(output_samples),
+		      "Total output size was not as expected (%d)", output_written_total);
+}
+
+ZTEST(suite_sample_rate_converter, test_invalid_polyphase_output_buf_too_small)
+{
+	int ret;
+
+	sample_t input_samples[441] = {0};
+	/* 480 output samples are expected */
+	sample_t output_samples[479];
+	size_t output_written;
+
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 44100, output_samples,
+					    sizeof(output_samples), &output_written, 48000);
+
+	zassert_equal(ret, -EINVAL,
+		      "Sample rate conversion process did not fail when output buffer is to small");
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
 ZTEST_SUITE(suite_sample_rate_converter, NULL, NULL, test_setup, NULL, NULL);
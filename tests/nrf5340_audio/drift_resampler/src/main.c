@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "drift_resampler.h"
+
+#define CHANNELS    2
+#define BLK_FRAMES  480
+#define SAMPLE_RATE 48000
+/* Output frames are delayed by this many frames relative to the input */
+#define DELAY_FRAMES 2
+
+/* Closed-loop simulation, 30 s of 10 ms blocks with a drift measurement every 100 ms */
+#define LOOP_BLKS	    3000
+#define LOOP_MEAS_PERIOD    10
+#define LOOP_MEAS_NOISE_PPM 20
+
+static struct drift_resampler rs;
+static int16_t input[BLK_FRAMES * CHANNELS];
+static int16_t output[DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_FRAMES) * CHANNELS];
+
+ZTEST(suite_drift_resampler, test_init_invalid_channels)
+{
+	int ret;
+
+	ret = drift_resampler_init(&rs, 0);
+	zassert_equal(ret, -EINVAL, "Zero channels should be rejected");
+
+	ret = drift_resampler_init(&rs, DRIFT_RESAMPLER_CHANNELS_MAX + 1);
+	zassert_equal(ret, -EINVAL, "Too many channels should be rejected");
+
+	ret = drift_resampler_init(&rs, CHANNELS);
+	zassert_equal(ret, 0, "Init failed: %d", ret);
+}
+
+ZTEST(suite_drift_resampler, test_unity_ratio_passthrough)
+{
+	size_t frames_out;
+	int ret;
+
+	ret = drift_resampler_init(&rs, CHANNELS);
+	zassert_equal(ret, 0, "Init failed: %d", ret);
+
+	for (int blk = 0; blk < 4; blk++) {
+		for (int i = 0; i < BLK_FRAMES; i++) {
+			input[i * CHANNELS] = (blk * BLK_FRAMES) + i;
+			input[i * CHANNELS + 1] = -((blk * BLK_FRAMES) + i);
+		}
+
+		frames_out = drift_resampler_process(&rs, input, BLK_FRAMES, output,
+						     DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_FRAMES));
+		zassert_equal(frames_out, BLK_FRAMES, "Wrong number of frames: %zu", frames_out);
+
+		for (int i = 0; i < BLK_FRAMES; i++) {
+			int expected = MAX((blk * BLK_FRAMES) + i - DELAY_FRAMES, 0);
+
+			zassert_equal(output[i * CHANNELS], expected, "Wrong sample at %d", i);
+			zassert_equal(output[i * CHANNELS + 1], -expected, "Wrong sample at %d", i);
+		}
+	}
+}
+
+ZTEST(suite_drift_resampler, test_ratio_clamp)
+{
+	int32_t ratio_ppm;
+
+	(void)drift_resampler_init(&rs, CHANNELS);
+
+	drift_resampler_ratio_set(&rs, 5000);
+	zassert_equal(rs.ratio_ppm, DRIFT_RESAMPLER_RATIO_MAX_PPM, "Ratio not clamped");
+
+	drift_resampler_ratio_set(&rs, -5000);
+	zassert_equal(rs.ratio_ppm, -DRIFT_RESAMPLER_RATIO_MAX_PPM, "Ratio not clamped");
+
+	ratio_ppm = drift_resampler_update(&rs, 0, -100000);
+	zassert_equal(ratio_ppm, DRIFT_RESAMPLER_RATIO_MAX_PPM, "Ratio not clamped");
+}
+
+ZTEST(suite_drift_resampler, test_update_filter_and_level)
+{
+	int32_t ratio_ppm;
+
+	(void)drift_resampler_init(&rs, CHANNELS);
+
+	/* First measurement is used as is */
+	ratio_ppm = drift_resampler_update(&rs, 100, 0);
+	zassert_equal(ratio_ppm, 100, "Wrong ratio: %d", ratio_ppm);
+
+	/* Following measurements are filtered */
+	ratio_ppm = drift_resampler_update(&rs, 200, 0);
+	zassert_true(ratio_ppm > 100 && ratio_ppm < 200, "Measurement not filtered: %d",
+		     ratio_ppm);
+
+	for (int i = 0; i < 50; i++) {
+		ratio_ppm = drift_resampler_update(&rs, 200, 0);
+	}
+
+	zassert_within(ratio_ppm, 200, 3, "Filter did not converge: %d", ratio_ppm);
+
+	/* Too much buffered audio gives fewer output frames */
+	ratio_ppm = drift_resampler_update(&rs, 200, 500);
+	zassert_true(ratio_ppm < 200, "Level error not applied: %d", ratio_ppm);
+}
+
+ZTEST(suite_drift_resampler, test_output_frame_count)
+{
+	size_t frames_total = 0;
+	size_t frames_out;
+	const int num_blks = 100;
+
+	(void)drift_resampler_init(&rs, CHANNELS);
+	drift_resampler_ratio_set(&rs, 1000);
+
+	memset(input, 0, sizeof(input));
+
+	for (int blk = 0; blk < num_blks; blk++) {
+		frames_out = drift_resampler_process(&rs, input, BLK_FRAMES, output,
+						     DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_FRAMES));
+		zassert_within(frames_out, BLK_FRAMES, 1, "Wrong number of frames: %zu",
+			       frames_out);
+		frames_total += frames_out;
+	}
+
+	/* 1000 ppm more output frames than input frames */
+	zassert_within(frames_total, (num_blks * BLK_FRAMES) + (num_blks * BLK_FRAMES) / 1000, 1,
+		       "Wrong total number of frames: %zu", frames_total);
+}
+
+ZTEST(suite_drift_resampler, test_sine_accuracy)
+{
+	const double freq_hz = 1000.0;
+	const double amplitude = 16000.0;
+	const int32_t ratio_ppm = 500;
+	const double step = 1000000.0 / (1000000.0 + ratio_ppm);
+	size_t frames_total = 0;
+	size_t frames_out;
+	int max_err = 0;
+
+	(void)drift_resampler_init(&rs, CHANNELS);
+	drift_resampler_ratio_set(&rs, ratio_ppm);
+
+	for (int blk = 0; blk < 10; blk++) {
+		for (int i = 0; i < BLK_FRAMES; i++) {
+			double phase = 2.0 * M_PI * freq_hz * ((blk * BLK_FRAMES) + i) / SAMPLE_RATE;
+
+			input[i * CHANNELS] = (int16_t)lround(amplitude * sin(phase));
+			input[i * CHANNELS + 1] = (int16_t)lround(amplitude * cos(phase));
+		}
+
+		frames_out = drift_resampler_process(&rs, input, BLK_FRAMES, output,
+						     DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_FRAMES));
+
+		for (int i = 0; i < frames_out; i++) {
+			/* Skip the start, which is interpolated from silence */
+			if (frames_total + i < 4) {
+				continue;
+			}
+
+			double pos = ((frames_total + i) * step) - DELAY_FRAMES;
+			double phase = 2.0 * M_PI * freq_hz * pos / SAMPLE_RATE;
+			int err_sin = abs(output[i * CHANNELS] - (int)lround(amplitude * sin(phase)));
+			int err_cos =
+				abs(output[i * CHANNELS + 1] - (int)lround(amplitude * cos(phase)));
+
+			max_err = MAX(max_err, MAX(err_sin, err_cos));
+		}
+
+		frames_total += frames_out;
+	}
+
+	zassert_true(max_err < 8, "Interpolation error too large: %d", max_err);
+}
+
+struct closed_loop_result {
+	int32_t ratio_ppm;
+	/* Buffer level relative to the target at the end, in frames */
+	double level;
+	/* Largest buffer level deviation over the second half of the run, in frames */
+	double level_max_tail;
+};
+
+/**
+ * @brief	Run the resampler in a closed loop against a consumer with a synthetic drift.
+ *
+ * @note	The producer delivers BLK_FRAMES frames per block, and the consumer reads
+ *		BLK_FRAMES * (1 + drift_ppm / 1000000) frames in the same time. The drift
+ *		measurement has a deterministic error of up to +/- LOOP_MEAS_NOISE_PPM.
+ */
+static void closed_loop_run(int32_t drift_ppm, double level_offset, struct closed_loop_result *res)
+{
+	double level = level_offset;
+	double level_abs;
+	size_t frames_out;
+	int32_t meas_err_ppm;
+	int32_t level_err_us;
+
+	(void)drift_resampler_init(&rs, CHANNELS);
+	memset(input, 0, sizeof(input));
+	memset(res, 0, sizeof(*res));
+
+	for (int blk = 0; blk < LOOP_BLKS; blk++) {
+		frames_out = drift_resampler_process(&rs, input, BLK_FRAMES, output,
+						     DRIFT_RESAMPLER_FRAMES_OUT_MAX(BLK_FRAMES));
+
+		level += frames_out - (BLK_FRAMES * (1.0 + (drift_ppm / 1000000.0)));
+
+		if ((blk % LOOP_MEAS_PERIOD) == 0) {
+			meas_err_ppm = ((blk * 7919) % (2 * LOOP_MEAS_NOISE_PPM + 1)) -
+				       LOOP_MEAS_NOISE_PPM;
+			level_err_us = (int32_t)((level * 1000000) / SAMPLE_RATE);
+
+			res->ratio_ppm = drift_resampler_update(&rs, drift_ppm + meas_err_ppm,
+								level_err_us);
+		}
+
+		level_abs = fabs(level);
+		if ((blk >= (LOOP_BLKS / 2)) && (level_abs > res->level_max_tail)) {
+			res->level_max_tail = level_abs;
+		}
+	}
+
+	res->level = level;
+}
+
+ZTEST(suite_drift_resampler, test_closed_loop_drift_tracking)
+{
+	const int32_t drift_ppm[] = {300, -300, 900};
+	struct closed_loop_result res;
+
+	for (int i = 0; i < ARRAY_SIZE(drift_ppm); i++) {
+		closed_loop_run(drift_ppm[i], 0, &res);
+
+		/* Without compensation the buffer would be off by drift * 1.44 frames */
+		zassert_within(res.ratio_ppm, drift_ppm[i], LOOP_MEAS_NOISE_PPM,
+			       "Ratio %d ppm does not follow drift %d ppm", res.ratio_ppm,
+			       drift_ppm[i]);
+		zassert_true(res.level_max_tail < 2.0, "Buffer level drifted by %d frames",
+			     (int)res.level_max_tail);
+	}
+}
+
+ZTEST(suite_drift_resampler, test_closed_loop_level_recovery)
+{
+	/* 5 ms of audio above and below the target */
+	const double level_offset[] = {BLK_FRAMES / 2, -(BLK_FRAMES / 2)};
+	struct closed_loop_result res;
+
+	for (int i = 0; i < ARRAY_SIZE(level_offset); i++) {
+		closed_loop_run(300, level_offset[i], &res);
+
+		zassert_true(fabs(res.level) < fabs(level_offset[i]) / 10,
+			     "Buffer level did not return to the target: %d frames",
+			     (int)res.level);
+	}
+}
+
+ZTEST_SUITE(suite_drift_resampler, NULL, NULL, NULL, NULL, NULL);
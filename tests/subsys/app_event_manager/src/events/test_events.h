@@ -25,10 +25,13 @@ enum test_id {
 	TEST_BASIC,
 	TEST_DATA,
 	TEST_EVENT_ORDER,
+	TEST_EVENT_ORDER_BATCH,
 	TEST_SUBSCRIBER_ORDER,
 	TEST_OOM,
 	TEST_MULTICONTEXT,
 	TEST_NAME_STYLE_SORTING,
+	TEST_PRIORITY,
+	TEST_LISTENER_STATS,
 
 	TEST_CNT
 };
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stddef.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 #include <app_event_manager.h>
 
@@ -63,6 +65,11 @@ ZTEST(suite0, test_event_order)
 	test_start(TEST_EVENT_ORDER);
 }
 
+ZTEST(suite0, test_event_order_batch)
+{
+	test_start(TEST_EVENT_ORDER_BATCH);
+}
+
 ZTEST(suite0, test_subs_order)
 {
 	test_start(TEST_SUBSCRIBER_ORDER);
@@ -184,6 +191,181 @@ ZTEST(suite0, test_name_style_events_sorting)
 	test_start(TEST_NAME_STYLE_SORTING);
 }
 
+ZTEST(suite0, test_priority)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUE)) {
+		ztest_test_skip();
+	}
+
+	test_start(TEST_PRIORITY);
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+static void listener_stats_get(const char *name, struct event_listener_stats *stats)
+{
+	STRUCT_SECTION_FOREACH(event_listener, el) {
+		if (!strcmp(el->name, name)) {
+			app_event_manager_listener_stats_get(el, stats);
+			return;
+		}
+	}
+
+	zassert_unreachable("Listener %s not found", name);
+}
+#endif
+
+ZTEST(suite0, test_listener_stats)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LISTENER_STATS)
+	struct event_listener_stats stats;
+
+	app_event_manager_listener_stats_reset();
+
+	listener_stats_get("test_basic", &stats);
+	zassert_equal(stats.calls, 0, "Statistics not reset");
+	zassert_equal(stats.consumed, 0, "Statistics not reset");
+	zassert_equal(stats.cycles, 0, "Statistics not reset");
+
+	/* Listeners receive the test start event and submit the test end event, so
+	 * their statistics are updated before the test end event is processed.
+	 */
+	test_start(TEST_BASIC);
+
+	listener_stats_get("test_basic", &stats);
+	zassert_equal(stats.calls, 1, "Unexpected number of notifications");
+	zassert_equal(stats.consumed, 0, "Unexpected number of consumed events");
+
+	listener_stats_get("test_listener_stats", &stats);
+	zassert_equal(stats.calls, 1, "Unexpected number of notifications");
+	zassert_equal(stats.consumed, 0, "Unexpected number of consumed events");
+
+	test_start(TEST_LISTENER_STATS);
+
+	listener_stats_get("test_basic", &stats);
+	zassert_equal(stats.calls, 2, "Unexpected number of notifications");
+	zassert_equal(stats.consumed, 0, "Unexpected number of consumed events");
+
+	listener_stats_get("test_listener_stats", &stats);
+	zassert_equal(stats.calls, 2, "Unexpected number of notifications");
+	zassert_equal(stats.consumed, 1, "Unexpected number of consumed events");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB)
+#define MEM_SLAB_CNT 3
+
+static void mem_slab_stats_get(struct app_event_manager_mem_slab_stats *stats)
+{
+	for (size_t i = 0; i < MEM_SLAB_CNT; i++) {
+		zassert_ok(app_event_manager_mem_slab_stats_get(i, &stats[i]),
+			   "Cannot get memory slab statistics");
+	}
+
+	zassert_equal(app_event_manager_mem_slab_stats_get(MEM_SLAB_CNT, &stats[0]), -ENOENT,
+		      "Unexpected memory slab");
+}
+#endif
+
+ZTEST(suite0, test_mem_slab_alloc_free)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB)
+	struct app_event_manager_mem_slab_stats before[MEM_SLAB_CNT];
+	struct app_event_manager_mem_slab_stats after[MEM_SLAB_CNT];
+	void *block;
+
+	mem_slab_stats_get(before);
+
+	for (size_t i = 0; i < MEM_SLAB_CNT; i++) {
+		zassert_equal(before[i].block_size % __alignof__(max_align_t), 0,
+			      "Block size not aligned");
+		if (i > 0) {
+			zassert_true(before[i].block_size > before[i - 1].block_size,
+				     "Size classes not sorted");
+		}
+	}
+
+	for (size_t i = 0; i < MEM_SLAB_CNT; i++) {
+		/* The smallest size class that fits the allocation is used. */
+		size_t size = (i == 0) ? 1 : (before[i - 1].block_size + 1);
+
+		block = app_event_manager_alloc(size);
+		zassert_not_null(block, "Allocation failed");
+		zassert_equal((uintptr_t)block % __alignof__(max_align_t), 0,
+			      "Block not aligned");
+
+		mem_slab_stats_get(after);
+		for (size_t j = 0; j < MEM_SLAB_CNT; j++) {
+			zassert_equal(after[j].used, before[j].used + ((i == j) ? 1 : 0),
+				      "Block taken from wrong size class");
+		}
+
+		app_event_manager_free(block);
+
+		mem_slab_stats_get(after);
+		zassert_equal(after[i].used, before[i].used, "Block not freed");
+		zassert_true(after[i].max_used > before[i].used, "High watermark not updated");
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(suite0, test_mem_slab_heap_fallback)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB) && \
+	IS_ENABLED(CONFIG_APP_EVENT_MANAGER_MEM_SLAB_HEAP_FALLBACK)
+	struct app_event_manager_mem_slab_stats before[MEM_SLAB_CNT];
+	struct app_event_manager_mem_slab_stats after[MEM_SLAB_CNT];
+	void *blocks[CONFIG_APP_EVENT_MANAGER_MEM_SLAB_SMALL_COUNT];
+	size_t block_cnt;
+	void *block;
+
+	mem_slab_stats_get(before);
+
+	/* Allocation bigger than any size class is taken from the heap. */
+	block = app_event_manager_alloc(before[MEM_SLAB_CNT - 1].block_size + 1);
+	zassert_not_null(block, "Allocation failed");
+
+	mem_slab_stats_get(after);
+	for (size_t i = 0; i < MEM_SLAB_CNT; i++) {
+		zassert_equal(after[i].used, before[i].used, "Block taken from size class");
+		zassert_equal(after[i].alloc_fail_cnt, before[i].alloc_fail_cnt,
+			      "Unexpected allocation failure");
+	}
+
+	app_event_manager_free(block);
+
+	/* Allocation from an exhausted size class is taken from the heap. */
+	block_cnt = before[0].block_cnt - before[0].used;
+	zassert_true(block_cnt <= ARRAY_SIZE(blocks), "Unexpected block count");
+
+	for (size_t i = 0; i < block_cnt; i++) {
+		blocks[i] = app_event_manager_alloc(1);
+		zassert_not_null(blocks[i], "Allocation failed");
+	}
+
+	block = app_event_manager_alloc(1);
+	zassert_not_null(block, "Allocation failed");
+
+	mem_slab_stats_get(after);
+	zassert_equal(after[0].used, after[0].block_cnt, "Size class not exhausted");
+	zassert_equal(after[0].alloc_fail_cnt, before[0].alloc_fail_cnt + 1,
+		      "Allocation failure not counted");
+
+	app_event_manager_free(block);
+	for (size_t i = 0; i < block_cnt; i++) {
+		app_event_manager_free(blocks[i]);
+	}
+
+	mem_slab_stats_get(after);
+	zassert_equal(after[0].used, before[0].used, "Blocks not freed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(suite0, NULL, test_init, NULL, NULL, NULL);
 
 static bool app_event_handler(const struct app_event_header *aeh)
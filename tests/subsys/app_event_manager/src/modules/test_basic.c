@@ -59,6 +59,24 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			break;
 		}
 
+		case TEST_EVENT_ORDER_BATCH:
+		{
+			sys_slist_t batch;
+
+			app_event_manager_batch_init(&batch);
+
+			for (size_t i = 0; i < TEST_EVENT_ORDER_CNT; i++) {
+				struct order_event *event = new_order_event();
+
+				event->val = i;
+				APP_EVENT_BATCH_APPEND(&batch, event);
+			}
+
+			app_event_manager_submit_batch(&batch);
+			zassert_true(sys_slist_is_empty(&batch), "Batch not emptied");
+			break;
+		}
+
 		case TEST_SUBSCRIBER_ORDER:
 		{
 			struct order_event *event = new_order_event();
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+
+#define MODULE test_listener_stats
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *st = cast_test_start_event(aeh);
+
+		if (st->test_id != TEST_LISTENER_STATS) {
+			return false;
+		}
+
+		struct test_end_event *et = new_test_end_event();
+
+		et->test_id = st->test_id;
+		APP_EVENT_SUBMIT(et);
+
+		/* Consume the event to have it counted in the listener statistics. */
+		return true;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE_FINAL(MODULE, test_start_event);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "priority_events.h"
+
+#define MODULE test_priority
+
+#define TEST_REGULAR_EVENT_CNT 10
+
+static int regular_cnt;
+static bool high_prio_received;
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *st = cast_test_start_event(aeh);
+
+		if (st->test_id != TEST_PRIORITY) {
+			return false;
+		}
+
+		regular_cnt = 0;
+		high_prio_received = false;
+
+		for (size_t i = 0; i < TEST_REGULAR_EVENT_CNT; i++) {
+			struct regular_prio_event *event = new_regular_prio_event();
+
+			event->val = i;
+			APP_EVENT_SUBMIT(event);
+		}
+
+		/* Submitted last, but expected to be processed first. */
+		struct high_prio_event *event = new_high_prio_event();
+
+		APP_EVENT_SUBMIT(event);
+
+		return false;
+	}
+
+	if (is_high_prio_event(aeh)) {
+		zassert_equal(regular_cnt, 0,
+			      "High priority event processed after regular event");
+		high_prio_received = true;
+
+		return false;
+	}
+
+	if (is_regular_prio_event(aeh)) {
+		struct regular_prio_event *event = cast_regular_prio_event(aeh);
+
+		zassert_true(high_prio_received, "Regular event processed before high priority");
+		zassert_equal(event->val, regular_cnt, "Incorrect regular event order");
+		regular_cnt++;
+
+		if (regular_cnt == TEST_REGULAR_EVENT_CNT) {
+			struct test_end_event *te = new_test_end_event();
+
+			te->test_id = TEST_PRIORITY;
+			APP_EVENT_SUBMIT(te);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, test_start_event);
+APP_EVENT_SUBSCRIBE(MODULE, regular_prio_event);
+APP_EVENT_SUBSCRIBE(MODULE, high_prio_event);
@@ -13,6 +13,7 @@
 #include "audio_module_test_common.h"
 
 #define FAKE_FIFO_CALL_TX_RX_TEST_COUNT (3)
+#define TEST_DEST_NUM                   (2)
 
 K_THREAD_STACK_DEFINE(mod_stack, TEST_MOD_THREAD_STACK_SIZE);
 K_MEM_SLAB_DEFINE(data_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
@@ -36,6 +37,28 @@ static const struct audio_module_functions ft_pop = {.open = test_open_function,
 						     .start = test_start_function,
 						     .stop = test_stop_function,
 						     .data_process = test_data_process_function};
+
+static int test_data_copy_function(struct audio_module_handle_private *handle,
+				   struct audio_data const *const audio_data_rx,
+				   struct audio_data *audio_data_tx)
+{
+	ARG_UNUSED(handle);
+
+	/* Keep the output buffer taken from the module's data slab, only copy the payload. */
+	memcpy(audio_data_tx->data, audio_data_rx->data, audio_data_rx->data_size);
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	return 0;
+}
+
+static const struct audio_module_functions ft_copy = {.open = test_open_function,
+						      .close = test_close_function,
+						      .configuration_set = test_config_set_function,
+						      .configuration_get = test_config_get_function,
+						      .start = test_start_function,
+						      .stop = test_stop_function,
+						      .data_process = test_data_copy_function};
+
 static struct audio_module_description mod_description = {
 	.name = "Test base name", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &ft_null};
 static struct audio_module_description test_from_description, test_to_description;
@@ -1101,3 +1124,188 @@ ZTEST(suite_audio_module_functional, test_data_rx_fnct)
 		      "Data RX function failed to free item, data FIFO free called %d times",
 		      data_fifo_block_free_fake.call_count);
 }
+
+ZTEST(suite_audio_module_functional, test_data_rx_shared_fnct)
+{
+	int ret;
+	char *test_inst_name = "TEST instance 1";
+	char test_data[TEST_MOD_DATA_SIZE];
+	struct audio_data const *audio_data_out = NULL;
+	struct audio_module_message *data_msg_tx;
+	struct data_fifo fifo_tx = {0};
+	struct audio_module_handle handle;
+
+	test_context_set(&mod_context, &mod_config);
+
+	/* Fake internal empty data FIFO success */
+	data_fifo_init_fake.custom_fake = fake_data_fifo_init__succeeds;
+	data_fifo_uninit_fake.custom_fake = fake_data_fifo_uninit__succeeds;
+	data_fifo_empty_fake.custom_fake = fake_data_fifo_empty__succeeds;
+	data_fifo_pointer_first_vacant_get_fake.custom_fake =
+		fake_data_fifo_pointer_first_vacant_get__succeeds;
+	data_fifo_block_lock_fake.custom_fake = fake_data_fifo_block_lock__succeeds;
+	data_fifo_pointer_last_filled_get_fake.custom_fake =
+		fake_data_fifo_pointer_last_filled_get__succeeds;
+	data_fifo_block_free_fake.custom_fake = fake_data_fifo_block_free__succeeds;
+	data_fifo_state_fake.custom_fake = fake_data_fifo_state__succeeds;
+
+	fake_data_fifo_init__succeeds(&fifo_tx);
+
+	memcpy(&handle.name, test_inst_name, sizeof(*test_inst_name));
+	handle.description = &mod_description;
+	handle.thread.msg_rx = NULL;
+	handle.thread.msg_tx = &fifo_tx;
+	handle.thread.data_slab = &data_slab;
+	handle.thread.data_size = TEST_MOD_DATA_SIZE;
+	handle.state = AUDIO_MODULE_STATE_RUNNING;
+	handle.context = (struct audio_module_context *)&mod_context;
+
+	/* fill data */
+	for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+		test_data[i] = TEST_MOD_DATA_SIZE - i;
+	}
+
+	ret = data_fifo_pointer_first_vacant_get(handle.thread.msg_tx, (void **)&data_msg_tx,
+						 K_NO_WAIT);
+	zassert_equal(ret, 0, "FIFO get function did not return successfully: ret %d", ret);
+
+	data_msg_tx->audio_data.data = test_data;
+	data_msg_tx->audio_data.data_size = TEST_MOD_DATA_SIZE;
+	data_msg_tx->tx_handle = NULL;
+	data_msg_tx->response_cb = NULL;
+
+	ret = data_fifo_block_lock(handle.thread.msg_tx, (void **)&data_msg_tx,
+				   sizeof(struct audio_module_message));
+	zassert_equal(ret, 0, "FIFO lock function did not return successfully: ret %d", ret);
+
+	ret = audio_module_data_rx_shared(&handle, &audio_data_out, K_NO_WAIT);
+	zassert_equal(ret, 0, "Data RX shared function did not return successfully: ret %d", ret);
+	zassert_equal_ptr(audio_data_out->data, test_data,
+			  "Failed Data RX shared function, data was copied");
+	zassert_equal(audio_data_out->data_size, TEST_MOD_DATA_SIZE,
+		      "Failed Data RX shared function, data sizes differs");
+	zassert_equal(data_fifo_block_free_fake.call_count, 0,
+		      "Data RX shared function freed item before release");
+
+	ret = audio_module_data_rx_release(&handle, audio_data_out);
+	zassert_equal(ret, 0, "Data RX release function did not return successfully: ret %d",
+		      ret);
+	zassert_equal(data_fifo_block_free_fake.call_count, 1,
+		      "Data RX release function failed to free item, data FIFO free called %d times",
+		      data_fifo_block_free_fake.call_count);
+}
+
+ZTEST(suite_audio_module_functional, test_data_ref_release_multi_dest_fnct)
+{
+	int ret;
+	char *test_inst_name = "TEST instance 1";
+	size_t size;
+	uint32_t slab_used;
+	char test_data[TEST_MOD_DATA_SIZE];
+	struct audio_data audio_data;
+	struct audio_data const *audio_data_out = NULL;
+	struct audio_module_message *msg_rx[TEST_DEST_NUM];
+	struct data_fifo fifo_tx = {0};
+	struct data_fifo fifo_rx = {0};
+	struct data_fifo fifo_to[TEST_DEST_NUM] = {0};
+	struct audio_module_description from_description = {
+		.name = "Test from name", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &ft_copy};
+	struct audio_module_description to_description = {
+		.name = "Test to name", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &ft_null};
+	struct audio_module_parameters parameters = mod_parameters;
+	struct audio_module_handle handle_from;
+	struct audio_module_handle handles_to[TEST_DEST_NUM];
+
+	test_context_set(&mod_context, &mod_config);
+
+	/* Fake internal empty data FIFO success */
+	data_fifo_init_fake.custom_fake = fake_data_fifo_init__succeeds;
+	data_fifo_uninit_fake.custom_fake = fake_data_fifo_uninit__succeeds;
+	data_fifo_empty_fake.custom_fake = fake_data_fifo_empty__succeeds;
+	data_fifo_pointer_first_vacant_get_fake.custom_fake =
+		fake_data_fifo_pointer_first_vacant_get__succeeds;
+	data_fifo_block_lock_fake.custom_fake = fake_data_fifo_block_lock__succeeds;
+	data_fifo_pointer_last_filled_get_fake.custom_fake =
+		fake_data_fifo_pointer_last_filled_get__succeeds;
+	data_fifo_block_free_fake.custom_fake = fake_data_fifo_block_free__succeeds;
+	data_fifo_state_fake.custom_fake = fake_data_fifo_state__succeeds;
+
+	parameters.description = &from_description;
+	parameters.thread.msg_rx = &fifo_rx;
+	parameters.thread.msg_tx = &fifo_tx;
+	parameters.thread.data_slab = &data_slab;
+	parameters.thread.data_size = TEST_MOD_DATA_SIZE;
+
+	memset(&handle_from, 0, sizeof(struct audio_module_handle));
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&mod_config,
+				test_inst_name, (struct audio_module_context *)&mod_context,
+				&handle_from);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	for (int i = 0; i < TEST_DEST_NUM; i++) {
+		test_initialize_handle(&handles_to[i], &to_description, NULL, NULL);
+		fake_data_fifo_init__succeeds(&fifo_to[i]);
+		handles_to[i].thread.msg_rx = &fifo_to[i];
+
+		ret = audio_module_connect(&handle_from, &handles_to[i], false);
+		zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+		handles_to[i].state = AUDIO_MODULE_STATE_RUNNING;
+	}
+
+	ret = audio_module_connect(&handle_from, NULL, true);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	ret = audio_module_start(&handle_from);
+	zassert_equal(ret, 0, "Start function did not return successfully: ret %d", ret);
+
+	for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+		test_data[i] = TEST_MOD_DATA_SIZE - i;
+	}
+
+	slab_used = k_mem_slab_num_used_get(&data_slab);
+
+	audio_data.data = test_data;
+	audio_data.data_size = TEST_MOD_DATA_SIZE;
+
+	ret = audio_module_data_tx(&handle_from, &audio_data, NULL);
+	zassert_equal(ret, 0, "Data TX function did not return successfully: ret %d", ret);
+
+	/* Every destination gets the same read-only buffer from the data slab. */
+	for (int i = 0; i < TEST_DEST_NUM; i++) {
+		ret = data_fifo_pointer_last_filled_get(&fifo_to[i], (void **)&msg_rx[i], &size,
+							K_MSEC(100));
+		zassert_equal(ret, 0, "Failed to get data for destination %d: ret %d", i, ret);
+		zassert_mem_equal(msg_rx[i]->audio_data.data, test_data, TEST_MOD_DATA_SIZE,
+				  "Data for destination %d differs", i);
+		zassert_equal_ptr(msg_rx[i]->audio_data.data, msg_rx[0]->audio_data.data,
+				  "Data for destination %d was copied", i);
+	}
+
+	ret = audio_module_data_rx_shared(&handle_from, &audio_data_out, K_MSEC(100));
+	zassert_equal(ret, 0, "Data RX shared function did not return successfully: ret %d", ret);
+	zassert_equal_ptr(audio_data_out->data, msg_rx[0]->audio_data.data,
+			  "Data on the TX FIFO was copied");
+
+	zassert_equal(k_mem_slab_num_used_get(&data_slab), slab_used + 1,
+		      "Data buffer not held while receivers have references");
+
+	/* Releasing all but the last reference must keep the buffer. */
+	for (int i = 0; i < TEST_DEST_NUM; i++) {
+		msg_rx[i]->response_cb((struct audio_module_handle_private *)msg_rx[i]->tx_handle,
+				       &msg_rx[i]->audio_data);
+
+		zassert_equal(k_mem_slab_num_used_get(&data_slab), slab_used + 1,
+			      "Data buffer freed after release by destination %d", i);
+	}
+
+	/* Releasing the last reference must free the buffer exactly once. */
+	ret = audio_module_data_rx_release(&handle_from, audio_data_out);
+	zassert_equal(ret, 0, "Data RX release function did not return successfully: ret %d",
+		      ret);
+	zassert_equal(k_mem_slab_num_used_get(&data_slab), slab_used,
+		      "Data buffer not freed after the last release");
+
+	k_thread_abort(handle_from.thread_id);
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/timing/timing.h>
+#include <bluetooth/cs_de.h>
+#include <bluetooth/services/ras.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(struct bt_le_cs_iq_sample, bt_le_cs_parse_pct, const uint8_t *);
+FAKE_VALUE_FUNC(int, bt_le_cs_get_antenna_path, uint8_t, uint8_t, uint8_t);
+FAKE_VOID_FUNC(bt_ras_rreq_rd_subevent_data_parse, struct net_buf_simple *,
+	       struct net_buf_simple *, enum bt_conn_le_cs_role, bt_ras_rreq_ranging_header_cb_t,
+	       bt_ras_rreq_subevent_header_cb_t, bt_ras_rreq_step_data_cb_t, void *);
+
+#define SPEED_OF_LIGHT_M_PER_S (299792458.0f)
+#define PI		       3.14159265358979f
+#define FIRST_CHANNEL	       2
+#define TONE_AMPLITUDE	       1000
+#define BENCHMARK_ITERATIONS   20
+
+/* The iFFT method is biased by up to one bin, which is about 0.3 m with 512 samples. */
+#define IFFT_TOLERANCE_M	0.5f
+#define PHASE_SLOPE_TOLERANCE_M 0.05f
+
+/* The step data is synthetic. It is generated from an ideal free-space channel with a single
+ * antenna path, not captured from a controller.
+ */
+
+/* One mode 2 step with a single antenna path */
+struct synthetic_step {
+	uint8_t channel;
+	uint8_t local[sizeof(struct bt_hci_le_cs_step_data_mode_2) +
+		      sizeof(struct bt_hci_le_cs_step_data_tone_info)];
+	uint8_t peer[sizeof(struct bt_hci_le_cs_step_data_mode_2) +
+		     sizeof(struct bt_hci_le_cs_step_data_tone_info)];
+};
+
+static struct synthetic_step synthetic_steps[CS_DE_NUM_CHANNELS];
+static size_t synthetic_steps_count;
+
+static struct bt_le_cs_iq_sample parse_pct(const uint8_t *pct)
+{
+	uint32_t pct_u32 = sys_get_le24(pct);
+	struct bt_le_cs_iq_sample iq;
+
+	/* Sign extend the 12-bit I and Q values */
+	iq.i = (int16_t)((pct_u32 & 0xFFF) << 4) >> 4;
+	iq.q = (int16_t)(((pct_u32 >> 12) & 0xFFF) << 4) >> 4;
+
+	return iq;
+}
+
+static int antenna_path_get(uint8_t n_ap, uint8_t antenna_permutation_index, uint8_t tone_index)
+{
+	return tone_index;
+}
+
+static void tone_set(uint8_t *step_data, int16_t i, int16_t q)
+{
+	struct bt_hci_le_cs_step_data_mode_2 *mode_2 =
+		(struct bt_hci_le_cs_step_data_mode_2 *)step_data;
+
+	mode_2->antenna_permutation_index = 0;
+	sys_put_le24((i & 0xFFF) | ((q & 0xFFF) << 12), mode_2->tone_info[0].phase_correction_term);
+	mode_2->tone_info[0].quality_indicator = BT_HCI_LE_CS_TONE_QUALITY_HIGH;
+}
+
+static bool channel_is_used(uint8_t channel, uint8_t num_skipped)
+{
+	/* Channels 23 to 25 are reserved for advertising */
+	return (channel < 23 || channel > 25) && channel >= (FIRST_CHANNEL + num_skipped);
+}
+
+/* Generate the steps of a procedure where the tones have travelled distance_m in both
+ * directions.
+ */
+static void steps_generate(float distance_m, uint8_t num_skipped)
+{
+	synthetic_steps_count = 0;
+
+	for (uint8_t n = 0; n < CS_DE_NUM_CHANNELS; n++) {
+		uint8_t channel = FIRST_CHANNEL + n;
+		float phase = -4.0f * PI * (n * 1e6f) * distance_m / SPEED_OF_LIGHT_M_PER_S;
+		struct synthetic_step *step = &synthetic_steps[synthetic_steps_count];
+
+		if (!channel_is_used(channel, num_skipped)) {
+			continue;
+		}
+
+		step->channel = channel;
+		tone_set(step->local, lroundf(TONE_AMPLITUDE * cosf(phase)),
+			 lroundf(TONE_AMPLITUDE * sinf(phase)));
+		tone_set(step->peer, TONE_AMPLITUDE, 0);
+
+		synthetic_steps_count++;
+	}
+}
+
+static void step_get(size_t index, struct bt_le_cs_subevent_step *local_step,
+		     struct bt_le_cs_subevent_step *peer_step)
+{
+	local_step->mode = BT_CONN_LE_CS_MAIN_MODE_2;
+	local_step->channel = synthetic_steps[index].channel;
+	local_step->data_len = sizeof(synthetic_steps[index].local);
+	local_step->data = synthetic_steps[index].local;
+
+	*peer_step = *local_step;
+	peer_step->data = synthetic_steps[index].peer;
+}
+
+static void steps_stream(cs_de_stream_t *p_stream, cs_de_report_t *p_report)
+{
+	struct bt_le_cs_subevent_step local_step;
+	struct bt_le_cs_subevent_step peer_step;
+
+	cs_de_stream_begin(p_stream, BT_CONN_LE_CS_ROLE_INITIATOR, 1, p_report);
+
+	for (size_t i = 0; i < synthetic_steps_count; i++) {
+		step_get(i, &local_step, &peer_step);
+		cs_de_stream_step_add(p_stream, &local_step, &peer_step);
+	}
+
+	cs_de_stream_end(p_stream);
+}
+
+static void subevent_data_parse(struct net_buf_simple *peer_ranging_data_buf,
+				struct net_buf_simple *local_step_data_buf,
+				enum bt_conn_le_cs_role cs_role,
+				bt_ras_rreq_ranging_header_cb_t ranging_header_cb,
+				bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
+				bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data)
+{
+	struct ras_ranging_header ranging_header = {.antenna_paths_mask = BIT(0)};
+	struct bt_le_cs_subevent_step local_step;
+	struct bt_le_cs_subevent_step peer_step;
+
+	if (!ranging_header_cb(&ranging_header, user_data)) {
+		return;
+	}
+
+	for (size_t i = 0; i < synthetic_steps_count; i++) {
+		step_get(i, &local_step, &peer_step);
+
+		if (!step_data_cb(&local_step, &peer_step, user_data)) {
+			return;
+		}
+	}
+}
+
+static void distance_check(cs_de_report_t *p_report, cs_de_quality_t quality, float distance_m)
+{
+	zassert_equal(quality, CS_DE_QUALITY_OK, "Unexpected quality");
+	zassert_within(p_report->distance_estimates[0].phase_slope, distance_m,
+		       PHASE_SLOPE_TOLERANCE_M, "Phase slope distance %f, expected %f",
+		       (double)p_report->distance_estimates[0].phase_slope, (double)distance_m);
+	zassert_within(p_report->distance_estimates[0].ifft, distance_m, IFFT_TOLERANCE_M,
+		       "iFFT distance %f, expected %f",
+		       (double)p_report->distance_estimates[0].ifft, (double)distance_m);
+	zassert_equal(p_report->distance_estimates[0].best, p_report->distance_estimates[0].ifft,
+		      "Best estimate should be the iFFT estimate");
+}
+
+static void cs_de_before(void *fixture)
+{
+	RESET_FAKE(bt_le_cs_parse_pct);
+	RESET_FAKE(bt_le_cs_get_antenna_path);
+	RESET_FAKE(bt_ras_rreq_rd_subevent_data_parse);
+
+	bt_le_cs_parse_pct_fake.custom_fake = parse_pct;
+	bt_le_cs_get_antenna_path_fake.custom_fake = antenna_path_get;
+	bt_ras_rreq_rd_subevent_data_parse_fake.custom_fake = subevent_data_parse;
+}
+
+ZTEST(cs_de, test_stream_distance)
+{
+	static cs_de_stream_t stream;
+	static cs_de_report_t report;
+	const float distances_m[] = {1.0f, 5.0f, 20.0f};
+
+	ARRAY_FOR_EACH(distances_m, i) {
+		steps_generate(distances_m[i], 0);
+		steps_stream(&stream, &report);
+
+		zassert_equal(report.n_ap, 1, "Unexpected number of antenna paths");
+		zassert_equal(report.tone_quality[0], CS_DE_TONE_QUALITY_OK,
+			      "Unexpected tone quality");
+
+		distance_check(&report, cs_de_stream_calc(&stream), distances_m[i]);
+	}
+}
+
+ZTEST(cs_de, test_populate_report_matches_stream)
+{
+	static cs_de_stream_t stream;
+	static cs_de_report_t streamed_report;
+	static cs_de_report_t report;
+	uint8_t buf_data[1];
+	struct net_buf_simple local_steps;
+	struct net_buf_simple peer_steps;
+
+	net_buf_simple_init_with_data(&local_steps, buf_data, sizeof(buf_data));
+	net_buf_simple_init_with_data(&peer_steps, buf_data, sizeof(buf_data));
+
+	steps_generate(3.0f, 0);
+	steps_stream(&stream, &streamed_report);
+
+	cs_de_populate_report(&local_steps, &peer_steps, BT_CONN_LE_CS_ROLE_INITIATOR, &report);
+
+	zassert_equal(bt_ras_rreq_rd_subevent_data_parse_fake.call_count, 1,
+		      "Ranging data not parsed");
+	zassert_equal(report.n_ap, 1, "Antenna paths not taken from the ranging header");
+	zassert_mem_equal(&report.iq_tones[0], &streamed_report.iq_tones[0],
+			  sizeof(report.iq_tones[0]), "Reports differ");
+	zassert_equal(report.tone_quality[0], streamed_report.tone_quality[0],
+		      "Reports differ");
+
+	distance_check(&report, cs_de_calc(&report), 3.0f);
+	zassert_equal(cs_de_stream_calc(&stream), CS_DE_QUALITY_OK, "Unexpected quality");
+	zassert_mem_equal(&report.distance_estimates[0], &streamed_report.distance_estimates[0],
+			  sizeof(report.distance_estimates[0]), "Distance estimates differ");
+}
+
+ZTEST(cs_de, test_stream_missing_tones)
+{
+	static cs_de_stream_t stream;
+	static cs_de_report_t report;
+
+	/* More missing tones than accepted */
+	steps_generate(5.0f, 10);
+	steps_stream(&stream, &report);
+
+	zassert_equal(report.tone_quality[0], CS_DE_TONE_QUALITY_BAD, "Tone quality should be bad");
+	zassert_equal(cs_de_calc(&report), CS_DE_QUALITY_DO_NOT_USE,
+		      "Report without usable tones or RTT should not be used");
+}
+
+ZTEST(cs_de, test_streams_independent)
+{
+	static cs_de_stream_t streams[2];
+	static cs_de_report_t reports[2];
+	const float distances_m[] = {2.0f, 8.0f};
+	struct bt_le_cs_subevent_step local_step;
+	struct bt_le_cs_subevent_step peer_step;
+
+	ARRAY_FOR_EACH(streams, i) {
+		cs_de_stream_begin(&streams[i], BT_CONN_LE_CS_ROLE_INITIATOR, 1, &reports[i]);
+	}
+
+	/* Interleave the procedures of two peers, one step at a time */
+	for (size_t step = 0;; step++) {
+		bool added = false;
+
+		ARRAY_FOR_EACH(streams, i) {
+			steps_generate(distances_m[i], 0);
+
+			if (step < synthetic_steps_count) {
+				step_get(step, &local_step, &peer_step);
+				cs_de_stream_step_add(&streams[i], &local_step, &peer_step);
+				added = true;
+			}
+		}
+
+		if (!added) {
+			break;
+		}
+	}
+
+	ARRAY_FOR_EACH(streams, i) {
+		cs_de_stream_end(&streams[i]);
+		distance_check(&reports[i], cs_de_stream_calc(&streams[i]), distances_m[i]);
+	}
+}
+
+ZTEST(cs_de, test_benchmark)
+{
+	static cs_de_stream_t stream;
+	static cs_de_report_t report;
+	timing_t start;
+	timing_t end;
+	uint64_t stream_ns;
+	uint64_t calc_ns;
+
+	steps_generate(5.0f, 0);
+
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		steps_stream(&stream, &report);
+	}
+
+	end = timing_counter_get();
+	stream_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCHMARK_ITERATIONS;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		zassert_equal(cs_de_stream_calc(&stream), CS_DE_QUALITY_OK, "Unexpected quality");
+	}
+
+	end = timing_counter_get();
+	calc_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCHMARK_ITERATIONS;
+
+	timing_stop();
+
+	TC_PRINT("%zu steps: stream %llu ns, calc %llu ns per procedure\n", synthetic_steps_count,
+		 stream_ns, calc_ns);
+}
+
+ZTEST_SUITE(cs_de, NULL, NULL, cs_de_before, NULL, NULL);
@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <bluetooth/gatt_dm.h>
+#include "gatt_discover_mock.h"
+
+#define DISCOVERY_TIMEOUT K_MSEC(2000)
+#define SAVE_TIMEOUT K_MSEC(100)
+
+#define DB_HASH_LEN 16
+#define RECORD_MAX_LEN 256
+
+/* Settings keys of the cached HID service of the peers */
+#define PEER_A_HIDS_KEY "bt/dm/00010203040506/1812"
+#define PEER_B_HIDS_KEY "bt/dm/01a1a2a3a4a5c6/1812"
+
+static const bt_addr_le_t peer_a = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 },
+};
+
+static const bt_addr_le_t peer_b = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = { 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xc6 },
+};
+
+static const uint8_t db_hash_1[DB_HASH_LEN] = {
+	0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+};
+
+static const uint8_t db_hash_2[DB_HASH_LEN] = {
+	0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+};
+
+/* Database of the peer */
+static const struct bt_gatt_attr db_a[] = {
+	BT_GATT_DISCOVER_MOCK_SERV(1, BT_UUID_HIDS, 4),
+	BT_GATT_DISCOVER_MOCK_CHRC(2, BT_UUID_HIDS_REPORT, BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(3, BT_UUID_HIDS_REPORT),
+	BT_GATT_DISCOVER_MOCK_DESC(4, BT_UUID_GATT_CCC),
+
+	BT_GATT_DISCOVER_MOCK_SERV(5, BT_UUID_HRS, 7),
+	BT_GATT_DISCOVER_MOCK_CHRC(6, BT_UUID_HRS_MEASUREMENT, BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(7, BT_UUID_HRS_MEASUREMENT),
+
+	BT_GATT_DISCOVER_MOCK_SERV(8, BT_UUID_HRS, 0xffff),
+	BT_GATT_DISCOVER_MOCK_CHRC(9, BT_UUID_HRS_MEASUREMENT, BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(10, BT_UUID_HRS_MEASUREMENT),
+};
+
+/* Database of the peer after an update that moved the HID service */
+static const struct bt_gatt_attr db_b[] = {
+	BT_GATT_DISCOVER_MOCK_SERV(1, BT_UUID_DIS, 3),
+	BT_GATT_DISCOVER_MOCK_CHRC(2, BT_UUID_DIS_MODEL_NUMBER, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(3, BT_UUID_DIS_MODEL_NUMBER),
+
+	BT_GATT_DISCOVER_MOCK_SERV(4, BT_UUID_HIDS, 8),
+	BT_GATT_DISCOVER_MOCK_CHRC(5, BT_UUID_HIDS_REPORT_MAP, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(6, BT_UUID_HIDS_REPORT_MAP),
+	BT_GATT_DISCOVER_MOCK_CHRC(7, BT_UUID_HIDS_REPORT, BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(8, BT_UUID_HIDS_REPORT),
+};
+
+/** Mocks ******************************************/
+
+static char dummy_conn;
+static const bt_addr_le_t *peer;
+static bool peer_bonded;
+
+/* Database hash of the peer, NULL if the peer does not have the characteristic. */
+static const uint8_t *peer_db_hash;
+static uint32_t db_hash_read_cnt;
+
+static struct bt_conn_auth_info_cb *auth_info_cb;
+static struct bt_gatt_read_params *read_params;
+
+int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
+{
+	memset(info, 0, sizeof(*info));
+	info->type = BT_CONN_TYPE_LE;
+	info->le.dst = peer;
+
+	return 0;
+}
+
+bool bt_addr_le_is_bonded(uint8_t id, const bt_addr_le_t *addr)
+{
+	return peer_bonded && !bt_addr_le_cmp(addr, peer);
+}
+
+int bt_conn_auth_info_cb_register(struct bt_conn_auth_info_cb *cb)
+{
+	auth_info_cb = cb;
+
+	return 0;
+}
+
+static void db_hash_read_work_handler(struct k_work *work)
+{
+	if (peer_db_hash) {
+		(void)read_params->func((struct bt_conn *)&dummy_conn, 0, read_params,
+					peer_db_hash, DB_HASH_LEN);
+	} else {
+		(void)read_params->func((struct bt_conn *)&dummy_conn,
+					BT_ATT_ERR_ATTRIBUTE_NOT_FOUND, read_params, NULL, 0);
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(db_hash_read_work, db_hash_read_work_handler);
+
+int bt_gatt_read(struct bt_conn *conn, struct bt_gatt_read_params *params)
+{
+	zassert_equal(params->handle_count, 0);
+	zassert_equal(bt_uuid_cmp(params->by_uuid.uuid, BT_UUID_GATT_DB_HASH), 0);
+
+	db_hash_read_cnt++;
+	read_params = params;
+	k_work_schedule(&db_hash_read_work, K_MSEC(5));
+
+	return 0;
+}
+
+/* Settings storage in RAM */
+static struct settings_record {
+	char name[32];
+	uint8_t val[RECORD_MAX_LEN];
+	size_t len;
+} records[4];
+
+K_SEM_DEFINE(record_saved, 0, 1);
+
+static struct settings_record *record_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		if ((records[i].len > 0) && !strcmp(records[i].name, name)) {
+			return &records[i];
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t record_read(void *cb_arg, void *data, size_t len)
+{
+	struct settings_record *record = cb_arg;
+
+	len = MIN(len, record->len);
+	memcpy(data, record->val, len);
+
+	return len;
+}
+
+static int storage_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		if (records[i].len == 0) {
+			continue;
+		}
+
+		err = settings_call_set_handler(records[i].name, records[i].len, record_read,
+						&records[i], arg);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int storage_save(struct settings_store *cs, const char *name, const char *value,
+			size_t val_len)
+{
+	struct settings_record *record = record_find(name);
+
+	zassert_true(val_len <= RECORD_MAX_LEN, "Too long record: %zu", val_len);
+	zassert_true(strlen(name) < sizeof(record->name), "Too long key: %s", name);
+
+	if (val_len == 0) {
+		if (record) {
+			record->len = 0;
+		}
+
+		return 0;
+	}
+
+	if (!record) {
+		for (size_t i = 0; !record && (i < ARRAY_SIZE(records)); i++) {
+			if (records[i].len == 0) {
+				record = &records[i];
+			}
+		}
+
+		zassert_not_null(record, "Settings storage full");
+		strcpy(record->name, name);
+	}
+
+	memcpy(record->val, value, val_len);
+	record->len = val_len;
+	k_sem_give(&record_saved);
+
+	return 0;
+}
+
+static struct settings_store_itf storage_itf = {
+	.csi_load = storage_load,
+	.csi_save = storage_save,
+};
+
+static struct settings_store storage = {
+	.cs_itf = &storage_itf,
+};
+
+int settings_backend_init(void)
+{
+	settings_dst_register(&storage);
+	settings_src_register(&storage);
+
+	return 0;
+}
+
+/** End of mocks ***********************************/
+
+K_SEM_DEFINE(discovery_finished, 0, 1);
+
+static void discovery_completed(struct bt_gatt_dm *dm, void *context)
+{
+	*(struct bt_gatt_dm **)context = dm;
+	k_sem_give(&discovery_finished);
+}
+
+static void discovery_service_not_found(struct bt_conn *conn, void *context)
+{
+	*(struct bt_gatt_dm **)context = NULL;
+	k_sem_give(&discovery_finished);
+}
+
+static void discovery_error_found(struct bt_conn *conn, int err, void *context)
+{
+	zassert_unreachable("Discovery error: %d", err);
+}
+
+static const struct bt_gatt_dm_cb discovery_cb = {
+	.completed = discovery_completed,
+	.service_not_found = discovery_service_not_found,
+	.error_found = discovery_error_found,
+};
+
+static struct bt_gatt_dm *discover(const struct bt_uuid *uuid)
+{
+	struct bt_gatt_dm *dm = NULL;
+
+	zassert_ok(bt_gatt_dm_start((struct bt_conn *)&dummy_conn, uuid, &discovery_cb, &dm));
+	zassert_ok(k_sem_take(&discovery_finished, DISCOVERY_TIMEOUT));
+	zassert_not_null(dm, "Service not found");
+
+	return dm;
+}
+
+static void service_check(struct bt_gatt_dm *dm, uint16_t handle, uint16_t end_handle,
+			  size_t attr_cnt)
+{
+	const struct bt_gatt_dm_attr *attr = bt_gatt_dm_service_get(dm);
+
+	zassert_equal(attr->handle, handle, "Unexpected service handle: %u", attr->handle);
+	zassert_equal(bt_gatt_dm_attr_service_val(attr)->end_handle, end_handle);
+	zassert_equal(bt_gatt_dm_attr_cnt(dm), attr_cnt, "Unexpected number of attributes: %zu",
+		      bt_gatt_dm_attr_cnt(dm));
+}
+
+/* Discovers the HID service of database A and stores it. */
+static void hids_record_create(void)
+{
+	struct bt_gatt_dm *dm;
+
+	bt_gatt_discover_mock_setup(db_a, ARRAY_SIZE(db_a));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 1, 4, 4);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	zassert_ok(k_sem_take(&record_saved, SAVE_TIMEOUT));
+}
+
+static void *setup(void)
+{
+	zassert_ok(settings_subsys_init());
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	memset(records, 0, sizeof(records));
+	k_sem_reset(&record_saved);
+	k_sem_reset(&discovery_finished);
+
+	peer = &peer_a;
+	peer_bonded = true;
+	peer_db_hash = db_hash_1;
+	db_hash_read_cnt = 0;
+
+	bt_gatt_discover_mock_setup(db_a, ARRAY_SIZE(db_a));
+}
+
+ZTEST(bt_gatt_dm_cache, test_hash_hit)
+{
+	const struct bt_gatt_dm_attr *chrc;
+	const struct bt_gatt_dm_attr *desc;
+	struct bt_gatt_dm *dm;
+
+	hids_record_create();
+	zassert_equal(db_hash_read_cnt, 1);
+	zassert_not_null(record_find(PEER_A_HIDS_KEY));
+
+	/* Over the air, the HID service would now be found at handle 4. */
+	bt_gatt_discover_mock_setup(db_b, ARRAY_SIZE(db_b));
+
+	dm = discover(BT_UUID_HIDS);
+	zassert_equal(db_hash_read_cnt, 2);
+	service_check(dm, 1, 4, 4);
+
+	chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_REPORT);
+	zassert_not_null(chrc);
+	zassert_equal(chrc->handle, 2);
+	zassert_equal(bt_gatt_dm_attr_chrc_val(chrc)->properties,
+		      BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY);
+
+	desc = bt_gatt_dm_desc_by_uuid(dm, chrc, BT_UUID_GATT_CCC);
+	zassert_not_null(desc);
+	zassert_equal(desc->handle, 4);
+
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	/* Nothing to store after a cache hit. */
+	zassert_equal(k_sem_take(&record_saved, SAVE_TIMEOUT), -EAGAIN);
+}
+
+ZTEST(bt_gatt_dm_cache, test_hash_hit_continue)
+{
+	struct bt_gatt_dm *dm;
+
+	dm = discover(BT_UUID_HRS);
+	service_check(dm, 5, 7, 3);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+	zassert_ok(k_sem_take(&record_saved, SAVE_TIMEOUT));
+
+	dm = discover(BT_UUID_HRS);
+	service_check(dm, 5, 7, 3);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	/* The next instance is discovered over the air, as after an uncached discovery. */
+	zassert_ok(bt_gatt_dm_continue(dm, &dm));
+	zassert_ok(k_sem_take(&discovery_finished, DISCOVERY_TIMEOUT));
+	zassert_not_null(dm, "Service not found");
+	service_check(dm, 8, 0xffff, 3);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+}
+
+ZTEST(bt_gatt_dm_cache, test_hash_miss)
+{
+	struct bt_gatt_dm *dm;
+
+	hids_record_create();
+
+	/* Changed database, discovered again and stored with the new hash. */
+	peer_db_hash = db_hash_2;
+	bt_gatt_discover_mock_setup(db_b, ARRAY_SIZE(db_b));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 4, 8, 5);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+	zassert_ok(k_sem_take(&record_saved, SAVE_TIMEOUT));
+
+	/* The record was replaced. */
+	bt_gatt_discover_mock_setup(db_a, ARRAY_SIZE(db_a));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 4, 8, 5);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+}
+
+ZTEST(bt_gatt_dm_cache, test_no_db_hash)
+{
+	struct bt_gatt_dm *dm;
+
+	peer_db_hash = NULL;
+
+	dm = discover(BT_UUID_HIDS);
+	zassert_equal(db_hash_read_cnt, 1);
+	service_check(dm, 1, 4, 4);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	zassert_equal(k_sem_take(&record_saved, SAVE_TIMEOUT), -EAGAIN);
+	zassert_is_null(record_find(PEER_A_HIDS_KEY));
+}
+
+ZTEST(bt_gatt_dm_cache, test_not_cached)
+{
+	struct bt_gatt_dm *dm;
+
+	/* Peer without bond */
+	peer_bonded = false;
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 1, 4, 4);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	/* Discovery of all services */
+	peer_bonded = true;
+
+	dm = discover(NULL);
+	service_check(dm, 1, 4, 4);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	zassert_equal(db_hash_read_cnt, 0);
+	zassert_equal(k_sem_take(&record_saved, SAVE_TIMEOUT), -EAGAIN);
+}
+
+static void corrupt_record_check(const uint8_t *data, size_t len)
+{
+	struct bt_gatt_dm *dm;
+
+	zassert_ok(settings_save_one(PEER_A_HIDS_KEY, data, len));
+	k_sem_reset(&record_saved);
+
+	/* The record is ignored and replaced. */
+	bt_gatt_discover_mock_setup(db_b, ARRAY_SIZE(db_b));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 4, 8, 5);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+	zassert_ok(k_sem_take(&record_saved, SAVE_TIMEOUT));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 4, 8, 5);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+}
+
+ZTEST(bt_gatt_dm_cache, test_corrupt_record)
+{
+	static uint8_t data[RECORD_MAX_LEN];
+	struct settings_record *record;
+	size_t len;
+
+	hids_record_create();
+
+	record = record_find(PEER_A_HIDS_KEY);
+	zassert_not_null(record);
+	len = record->len;
+	memcpy(data, record->val, len);
+
+	/* Truncated in the middle of the last attribute */
+	corrupt_record_check(data, len - 1);
+
+	/* Unknown record version */
+	data[0]++;
+	corrupt_record_check(data, len);
+}
+
+ZTEST(bt_gatt_dm_cache, test_bond_deleted)
+{
+	struct bt_gatt_dm *dm;
+
+	hids_record_create();
+
+	peer = &peer_b;
+	hids_record_create();
+
+	zassert_not_null(auth_info_cb);
+	zassert_not_null(auth_info_cb->bond_deleted);
+	auth_info_cb->bond_deleted(BT_ID_DEFAULT, &peer_a);
+
+	zassert_is_null(record_find(PEER_A_HIDS_KEY));
+	zassert_not_null(record_find(PEER_B_HIDS_KEY));
+
+	/* Discovered over the air again */
+	peer = &peer_a;
+	bt_gatt_discover_mock_setup(db_b, ARRAY_SIZE(db_b));
+
+	dm = discover(BT_UUID_HIDS);
+	service_check(dm, 4, 8, 5);
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	zassert_ok(bt_gatt_dm_cache_delete(&peer_b));
+	zassert_is_null(record_find(PEER_B_HIDS_KEY));
+}
+
+ZTEST_SUITE(bt_gatt_dm_cache, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+/* Included to reach the report objects and the GATT callbacks. */
+#include "hogp.c"
+
+#define OUT_REP_HANDLE 0x0020
+#define IN_REP_HANDLE 0x0030
+#define WRITE_MAX 8
+
+/** Mocks ******************************************/
+
+struct bt_conn {
+	int dummy;
+};
+
+static struct bt_conn conn;
+static int write_err;
+
+/* Write commands queued in the stack, with their sent callback. */
+static struct {
+	uint16_t handle;
+	const void *data;
+	uint16_t length;
+	bt_gatt_complete_func_t func;
+	void *user_data;
+} writes[WRITE_MAX];
+static size_t write_cnt;
+
+static struct bt_gatt_read_params *read_params;
+
+int bt_gatt_write_without_response_cb(struct bt_conn *c, uint16_t handle, const void *data,
+				      uint16_t length, bool sign, bt_gatt_complete_func_t func,
+				      void *user_data)
+{
+	zassert_equal_ptr(c, &conn);
+
+	if (write_err) {
+		return write_err;
+	}
+
+	zassert_true(write_cnt < WRITE_MAX);
+
+	writes[write_cnt].handle = handle;
+	writes[write_cnt].data = data;
+	writes[write_cnt].length = length;
+	writes[write_cnt].func = func;
+	writes[write_cnt].user_data = user_data;
+	write_cnt++;
+
+	return 0;
+}
+
+int bt_gatt_read(struct bt_conn *c, struct bt_gatt_read_params *params)
+{
+	read_params = params;
+
+	return 0;
+}
+
+int bt_gatt_write(struct bt_conn *c, struct bt_gatt_write_params *params)
+{
+	return 0;
+}
+
+int bt_gatt_subscribe(struct bt_conn *c, struct bt_gatt_subscribe_params *params)
+{
+	return 0;
+}
+
+int bt_gatt_unsubscribe(struct bt_conn *c, struct bt_gatt_subscribe_params *params)
+{
+	return 0;
+}
+
+struct bt_gatt_service_val *bt_gatt_dm_attr_service_val(const struct bt_gatt_dm_attr *attr)
+{
+	return NULL;
+}
+
+struct bt_gatt_chrc *bt_gatt_dm_attr_chrc_val(const struct bt_gatt_dm_attr *attr)
+{
+	return NULL;
+}
+
+struct bt_conn *bt_gatt_dm_conn_get(struct bt_gatt_dm *dm)
+{
+	return NULL;
+}
+
+const struct bt_gatt_dm_attr *bt_gatt_dm_service_get(const struct bt_gatt_dm *dm)
+{
+	return NULL;
+}
+
+const struct bt_gatt_dm_attr *bt_gatt_dm_char_next(const struct bt_gatt_dm *dm,
+						   const struct bt_gatt_dm_attr *prev)
+{
+	return NULL;
+}
+
+const struct bt_gatt_dm_attr *bt_gatt_dm_char_by_uuid(const struct bt_gatt_dm *dm,
+						      const struct bt_uuid *uuid)
+{
+	return NULL;
+}
+
+const struct bt_gatt_dm_attr *bt_gatt_dm_desc_by_uuid(const struct bt_gatt_dm *dm,
+						      const struct bt_gatt_dm_attr *attr_chrc,
+						      const struct bt_uuid *uuid)
+{
+	return NULL;
+}
+
+/** Helpers ****************************************/
+
+static struct bt_hogp hogp;
+static struct bt_hogp_rep_info out_rep;
+static struct bt_hogp_rep_info in_rep;
+
+static const uint8_t out_data[] = { 0x01, 0x02 };
+static const uint8_t in_data[] = { 0x10, 0x20, 0x30 };
+
+static size_t write_cb_cnt;
+static uint8_t write_cb_err;
+static size_t read_cb_cnt;
+static uint8_t read_cb_err;
+
+static void write_cb(struct bt_hogp *h, struct bt_hogp_rep_info *rep, uint8_t err)
+{
+	zassert_equal_ptr(h, &hogp);
+	zassert_equal_ptr(rep, &out_rep);
+
+	write_cb_err = err;
+	write_cb_cnt++;
+}
+
+static uint8_t read_cb(struct bt_hogp *h, struct bt_hogp_rep_info *rep, uint8_t err,
+		       const uint8_t *data)
+{
+	zassert_equal_ptr(h, &hogp);
+	zassert_equal_ptr(rep, &in_rep);
+
+	read_cb_err = err;
+	read_cb_cnt++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void write_sent(size_t idx)
+{
+	zassert_true(idx < write_cnt);
+
+	if (writes[idx].func) {
+		writes[idx].func(&conn, writes[idx].user_data);
+	}
+}
+
+/* Lets time pass first, so that a timestamp taken before the call is out of range. */
+static uint32_t cycle_get(void)
+{
+	k_sleep(K_MSEC(1));
+
+	return k_cycle_get_32();
+}
+
+static void timestamp_check(uint32_t start, uint32_t end)
+{
+	uint32_t timestamp = bt_hogp_rep_timestamp(&in_rep);
+
+	zassert_true((timestamp - start) <= (end - start), "Timestamp out of range");
+}
+
+static void before(void *fixture)
+{
+	memset(&hogp, 0, sizeof(hogp));
+	hogp.conn = &conn;
+
+	memset(&out_rep, 0, sizeof(out_rep));
+	out_rep.hogp = &hogp;
+	out_rep.handlers.val = OUT_REP_HANDLE;
+	out_rep.ref.type = BT_HIDS_REPORT_TYPE_OUTPUT;
+
+	memset(&in_rep, 0, sizeof(in_rep));
+	in_rep.hogp = &hogp;
+	in_rep.handlers.val = IN_REP_HANDLE;
+	in_rep.ref.type = BT_HIDS_REPORT_TYPE_INPUT;
+
+	write_err = 0;
+	write_cnt = 0;
+	read_params = NULL;
+
+	write_cb_cnt = 0;
+	write_cb_err = UINT8_MAX;
+	read_cb_cnt = 0;
+	read_cb_err = UINT8_MAX;
+}
+
+/** Tests ******************************************/
+
+ZTEST(bt_hogp, test_write_wo_rsp_no_callback)
+{
+	int err;
+
+	/* Without a callback, any number of writes can be pending. */
+	for (size_t i = 0; i < 3; i++) {
+		err = bt_hogp_rep_write_wo_rsp(&hogp, &out_rep, out_data, sizeof(out_data),
+					       NULL);
+		zassert_ok(err);
+	}
+
+	zassert_equal(write_cnt, 3);
+
+	for (size_t i = 0; i < write_cnt; i++) {
+		zassert_equal(writes[i].handle, OUT_REP_HANDLE);
+		zassert_equal_ptr(writes[i].data, out_data);
+		zassert_equal(writes[i].length, sizeof(out_data));
+		zassert_is_null(writes[i].func);
+	}
+
+	zassert_is_null(out_rep.write_cb);
+}
+
+ZTEST(bt_hogp, test_write_wo_rsp_no_callback_while_pending)
+{
+	int err;
+
+	err = bt_hogp_rep_write_wo_rsp(&hogp, &out_rep, out_data, sizeof(out_data), write_cb);
+	zassert_ok(err);
+
+	/* Only one write with a callback can be pending. */
+	err = bt_hogp_rep_write_wo_rsp(&hogp, &out_rep, out_data, sizeof(out_data), write_cb);
+	zassert_equal(err, -EBUSY);
+
+	err = bt_hogp_rep_write_wo_rsp(&hogp, &out_rep, out_data, sizeof(out_data), NULL);
+	zassert_ok(err);
+	zassert_equal(write_cnt, 2);
+
+	/* The write without a callback does not complete the pending one. */
+	write_sent(1);
+	zassert_equal(write_cb_cnt, 0);
+
+	write_sent(0);
+	zassert_equal(write_cb_cnt, 1);
+	zassert_equal(write_cb_err, 0);
+	zassert_is_null(out_rep.write_cb);
+}
+
+ZTEST(bt_hogp, test_write_wo_rsp_no_callback_errors)
+{
+	int err;
+
+	err = bt_hogp_rep_write_wo_rsp(NULL, &out_rep, out_data, sizeof(out_data), NULL);
+	zassert_equal(err, -EINVAL);
+
+	err = bt_hogp_rep_write_wo_rsp(&hogp, NULL, out_data, sizeof(out_data), NULL);
+	zassert_equal(err, -EINVAL);
+
+	err = bt_hogp_rep_write_wo_rsp(&hogp, &in_rep, in_data, sizeof(in_data), NULL);
+	zassert_equal(err, -ENOTSUP);
+
+	/* Errors of the stack are returned as they are. */
+	write_err = -ENOTCONN;
+	err = bt_hogp_rep_write_wo_rsp(&hogp, &out_rep, out_data, sizeof(out_data), NULL);
+	zassert_equal(err, -ENOTCONN);
+
+	zassert_equal(write_cnt, 0);
+	zassert_is_null(out_rep.write_cb);
+}
+
+ZTEST(bt_hogp, test_timestamp_read)
+{
+	uint32_t start;
+	int err;
+
+	err = bt_hogp_rep_read(&hogp, &in_rep, read_cb);
+	zassert_ok(err);
+	zassert_not_null(read_params);
+
+	/* A failed read leaves the timestamp unchanged. */
+	(void)cycle_get();
+	read_params->func(&conn, BT_ATT_ERR_READ_NOT_PERMITTED, read_params, NULL, 0);
+	zassert_equal(read_cb_cnt, 1);
+	zassert_equal(read_cb_err, BT_ATT_ERR_READ_NOT_PERMITTED);
+	zassert_equal(bt_hogp_rep_timestamp(&in_rep), 0);
+
+	err = bt_hogp_rep_read(&hogp, &in_rep, read_cb);
+	zassert_ok(err);
+
+	start = cycle_get();
+	read_params->func(&conn, 0, read_params, in_data, sizeof(in_data));
+	timestamp_check(start, k_cycle_get_32());
+
+	zassert_equal(read_cb_cnt, 2);
+	zassert_equal(read_cb_err, 0);
+	zassert_equal(bt_hogp_rep_size(&in_rep), sizeof(in_data));
+}
+
+ZTEST(bt_hogp, test_timestamp_notify)
+{
+	uint32_t start;
+	uint32_t end;
+
+	in_rep.notify_cb = read_cb;
+
+	start = cycle_get();
+	rep_notify_process(&conn, &in_rep.notify_params, in_data, sizeof(in_data));
+	end = k_cycle_get_32();
+	timestamp_check(start, end);
+
+	/* The subscription removal is not a report value. */
+	(void)cycle_get();
+	rep_notify_process(&conn, &in_rep.notify_params, NULL, 0);
+	timestamp_check(start, end);
+
+	zassert_equal(read_cb_cnt, 2);
+	zassert_equal(bt_hogp_rep_size(&in_rep), sizeof(in_data));
+}
+
+ZTEST_SUITE(bt_hogp, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+/* Included to reach the stream state and the disconnected callback. */
+#include "nus.c"
+
+#define PDU_LEN (CONFIG_BT_L2CAP_TX_MTU - 3)
+#define DATA_LEN 100
+#define NOTIFY_MAX 16
+
+/* Long enough for the system workqueue to go through the queued work. */
+#define WORK_WAIT K_MSEC(1)
+
+/** Mocks ******************************************/
+
+struct bt_conn {
+	int refs;
+};
+
+static struct bt_conn conn;
+static bool subscribed;
+static int notify_err;
+
+/* Notifications queued in the stack, in order, with their sent callback. */
+static struct {
+	bt_gatt_complete_func_t func;
+	void *user_data;
+} in_flight[NOTIFY_MAX];
+static size_t in_flight_cnt;
+static size_t in_flight_max;
+
+static uint8_t notified[2 * DATA_LEN];
+static size_t notified_len;
+static uint16_t notify_lens[NOTIFY_MAX];
+static size_t notify_cnt;
+static size_t notify_calls;
+
+static size_t stream_space;
+static size_t stream_space_calls;
+
+uint8_t bt_conn_index(const struct bt_conn *c)
+{
+	return 0;
+}
+
+struct bt_conn *bt_conn_ref(struct bt_conn *c)
+{
+	c->refs++;
+	return c;
+}
+
+void bt_conn_unref(struct bt_conn *c)
+{
+	zassert_true(c->refs > 0, "Unbalanced connection reference");
+	c->refs--;
+}
+
+uint16_t bt_gatt_get_mtu(struct bt_conn *c)
+{
+	return CONFIG_BT_L2CAP_TX_MTU;
+}
+
+bool bt_gatt_is_subscribed(struct bt_conn *c, const struct bt_gatt_attr *attr, uint16_t ccc_type)
+{
+	return subscribed;
+}
+
+int bt_gatt_notify_cb(struct bt_conn *c, struct bt_gatt_notify_params *params)
+{
+	notify_calls++;
+
+	if (notify_err) {
+		return notify_err;
+	}
+
+	zassert_true(in_flight_cnt < NOTIFY_MAX);
+	zassert_true(notify_cnt < NOTIFY_MAX);
+	zassert_true(notified_len + params->len <= sizeof(notified));
+
+	/* The stack copies the data, the stream reuses its PDU buffer. */
+	memcpy(&notified[notified_len], params->data, params->len);
+	notified_len += params->len;
+	notify_lens[notify_cnt++] = params->len;
+
+	in_flight[in_flight_cnt].func = params->func;
+	in_flight[in_flight_cnt].user_data = params->user_data;
+	in_flight_cnt++;
+	in_flight_max = MAX(in_flight_max, in_flight_cnt);
+
+	return 0;
+}
+
+ssize_t bt_gatt_attr_read_service(struct bt_conn *c, const struct bt_gatt_attr *attr, void *buf,
+				  uint16_t len, uint16_t offset)
+{
+	return 0;
+}
+
+ssize_t bt_gatt_attr_read_chrc(struct bt_conn *c, const struct bt_gatt_attr *attr, void *buf,
+			       uint16_t len, uint16_t offset)
+{
+	return 0;
+}
+
+ssize_t bt_gatt_attr_read_ccc(struct bt_conn *c, const struct bt_gatt_attr *attr, void *buf,
+			      uint16_t len, uint16_t offset)
+{
+	return 0;
+}
+
+ssize_t bt_gatt_attr_write_ccc(struct bt_conn *c, const struct bt_gatt_attr *attr,
+			       const void *buf, uint16_t len, uint16_t offset, uint8_t flags)
+{
+	return len;
+}
+
+/** Helpers ****************************************/
+
+static uint8_t data[DATA_LEN];
+
+static void stream_space_cb(struct bt_conn *c, size_t space)
+{
+	zassert_equal_ptr(c, &conn);
+
+	stream_space = space;
+	stream_space_calls++;
+}
+
+static struct bt_nus_cb nus_callbacks = {
+	.stream_space = stream_space_cb,
+};
+
+/* Completes the oldest notification queued in the stack. */
+static void notification_sent(void)
+{
+	bt_gatt_complete_func_t func = in_flight[0].func;
+	void *user_data = in_flight[0].user_data;
+
+	zassert_true(in_flight_cnt > 0, "No notification in flight");
+
+	in_flight_cnt--;
+	memmove(&in_flight[0], &in_flight[1], in_flight_cnt * sizeof(in_flight[0]));
+
+	func(&conn, user_data);
+	k_sleep(WORK_WAIT);
+}
+
+static void notifications_sent(void)
+{
+	while (in_flight_cnt > 0) {
+		notification_sent();
+	}
+}
+
+static void notified_check(size_t len)
+{
+	zassert_equal(notified_len, len);
+	zassert_mem_equal(notified, data, len);
+}
+
+static void before(void *fixture)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	memset(&conn, 0, sizeof(conn));
+	subscribed = true;
+	notify_err = 0;
+
+	in_flight_cnt = 0;
+	in_flight_max = 0;
+	notified_len = 0;
+	notify_cnt = 0;
+	notify_calls = 0;
+
+	stream_space = 0;
+	stream_space_calls = 0;
+
+	bt_nus_init(&nus_callbacks);
+}
+
+static void after(void *fixture)
+{
+	stream_disconnected(&conn, 0);
+
+	zassert_equal(conn.refs, 0, "Connection reference leaked");
+}
+
+/** Tests ******************************************/
+
+ZTEST(bt_nus_stream, test_partial_write)
+{
+	int ret;
+
+	/* Only the part that fits the buffer is written. */
+	ret = bt_nus_stream_write(&conn, data, DATA_LEN);
+	zassert_equal(ret, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(conn.refs, 1);
+
+	k_sleep(WORK_WAIT);
+
+	/* The space freed by the queued notifications is reported. */
+	zassert_equal(notify_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+	zassert_equal(stream_space_calls, 1);
+	zassert_equal(stream_space, CONFIG_BT_NUS_TX_STREAM_CREDITS * PDU_LEN);
+	zassert_equal(bt_nus_stream_space_get(&conn), stream_space);
+
+	ret = bt_nus_stream_write(&conn, &data[CONFIG_BT_NUS_TX_STREAM_BUF_SIZE],
+				  DATA_LEN - CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(ret, DATA_LEN - CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	notifications_sent();
+
+	notified_check(DATA_LEN);
+	zassert_equal(bt_nus_stream_space_get(&conn), CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(stream_space, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+}
+
+ZTEST(bt_nus_stream, test_write_full)
+{
+	int ret;
+
+	/* Nothing can be sent, so the buffer stays full. */
+	notify_err = -ENOMEM;
+
+	ret = bt_nus_stream_write(&conn, data, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(ret, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	k_sleep(WORK_WAIT);
+
+	ret = bt_nus_stream_write(&conn, data, 1);
+	zassert_equal(ret, 0);
+	zassert_equal(bt_nus_stream_space_get(&conn), 0);
+
+	notify_err = 0;
+	k_sleep(K_MSEC(20));
+	notifications_sent();
+
+	notified_check(CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+}
+
+ZTEST(bt_nus_stream, test_not_subscribed)
+{
+	int ret;
+
+	subscribed = false;
+
+	ret = bt_nus_stream_write(&conn, data, DATA_LEN);
+	zassert_equal(ret, -EINVAL);
+
+	ret = bt_nus_stream_write(NULL, data, DATA_LEN);
+	zassert_equal(ret, -EINVAL);
+
+	k_sleep(WORK_WAIT);
+
+	zassert_equal(notify_calls, 0);
+	zassert_equal(conn.refs, 0);
+	zassert_equal(bt_nus_stream_space_get(&conn), CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+}
+
+ZTEST(bt_nus_stream, test_credits)
+{
+	int ret;
+
+	ret = bt_nus_stream_write(&conn, data, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(ret, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	k_sleep(WORK_WAIT);
+
+	/* No more notifications than credits are queued, each filled up to the MTU. */
+	zassert_equal(notify_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+	zassert_equal(in_flight_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+
+	/* Each sent notification gives back a credit for the next one. */
+	notification_sent();
+	zassert_equal(notify_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS + 1);
+	zassert_equal(in_flight_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+
+	notifications_sent();
+
+	zassert_equal(in_flight_max, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+	zassert_equal(notify_cnt, 4);
+	zassert_equal(notify_lens[0], PDU_LEN);
+	zassert_equal(notify_lens[1], PDU_LEN);
+	zassert_equal(notify_lens[2], PDU_LEN);
+	zassert_equal(notify_lens[3], CONFIG_BT_NUS_TX_STREAM_BUF_SIZE - 3 * PDU_LEN);
+	notified_check(CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	/* All credits are back. */
+	zassert_equal(atomic_get(&streams[0].credits), CONFIG_BT_NUS_TX_STREAM_CREDITS);
+}
+
+ZTEST(bt_nus_stream, test_no_buffers_retry)
+{
+	int ret;
+
+	notify_err = -ENOMEM;
+
+	ret = bt_nus_stream_write(&conn, data, PDU_LEN);
+	zassert_equal(ret, PDU_LEN);
+
+	k_sleep(WORK_WAIT);
+
+	zassert_equal(notify_calls, 1);
+	zassert_equal(notified_len, 0);
+	zassert_equal(atomic_get(&streams[0].credits), CONFIG_BT_NUS_TX_STREAM_CREDITS);
+
+	/* No notification is in flight, so the stream retries on its own. */
+	notify_err = 0;
+	k_sleep(K_MSEC(20));
+
+	notified_check(PDU_LEN);
+	notifications_sent();
+}
+
+ZTEST(bt_nus_stream, test_no_buffers_retry_on_sent)
+{
+	int ret;
+
+	ret = bt_nus_stream_write(&conn, data, PDU_LEN);
+	zassert_equal(ret, PDU_LEN);
+
+	k_sleep(WORK_WAIT);
+	zassert_equal(in_flight_cnt, 1);
+
+	notify_err = -ENOMEM;
+
+	ret = bt_nus_stream_write(&conn, &data[PDU_LEN], PDU_LEN);
+	zassert_equal(ret, PDU_LEN);
+
+	k_sleep(WORK_WAIT);
+	zassert_equal(notify_calls, 2);
+
+	/* A notification is in flight, the retry waits for it to be sent. */
+	notify_err = 0;
+	k_sleep(K_MSEC(20));
+	zassert_equal(notify_calls, 2);
+
+	notifications_sent();
+
+	notified_check(2 * PDU_LEN);
+}
+
+ZTEST(bt_nus_stream, test_disconnected)
+{
+	int ret;
+
+	ret = bt_nus_stream_write(&conn, data, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+	zassert_equal(ret, CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	k_sleep(WORK_WAIT);
+	zassert_equal(in_flight_cnt, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+
+	stream_disconnected(&conn, 0);
+
+	zassert_equal(conn.refs, 0);
+	zassert_equal(bt_nus_stream_space_get(&conn), CONFIG_BT_NUS_TX_STREAM_BUF_SIZE);
+
+	/* Notifications sent after the disconnection do not restart the stream. */
+	notifications_sent();
+	zassert_equal(notify_calls, CONFIG_BT_NUS_TX_STREAM_CREDITS);
+
+	/* A new connection starts with an empty buffer and all credits. */
+	ret = bt_nus_stream_write(&conn, data, PDU_LEN);
+	zassert_equal(ret, PDU_LEN);
+	zassert_equal(conn.refs, 1);
+
+	k_sleep(WORK_WAIT);
+	zassert_equal(notify_calls, CONFIG_BT_NUS_TX_STREAM_CREDITS + 1);
+	zassert_mem_equal(&notified[CONFIG_BT_NUS_TX_STREAM_CREDITS * PDU_LEN], data, PDU_LEN);
+
+	notifications_sent();
+}
+
+ZTEST_SUITE(bt_nus_stream, NULL, NULL, before, after, NULL);
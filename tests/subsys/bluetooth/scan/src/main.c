@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <bluetooth/scan.h>
+
+#define TAG_COUNT CONFIG_BT_SCAN_ADDRESS_CNT
+#define REPLAY_ROUNDS 200
+
+/* Every TAG_REPORT_INTERVAL report of the replay comes from a known tag. */
+#define TAG_REPORT_INTERVAL 4
+
+/** Mocks ******************************************/
+
+/* Mock bt_le_scan_cb_register to capture the callback from scan.c so that
+ * advertising reports can be fed to the module.
+ */
+static struct bt_le_scan_cb *scancb;
+int bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scancb = cb;
+	return 0;
+}
+
+int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+void bt_data_parse(struct net_buf_simple *ad,
+		   bool (*func)(struct bt_data *data, void *user_data),
+		   void *user_data)
+{
+	while (ad->len > 1) {
+		struct bt_data data;
+		uint8_t len;
+
+		len = net_buf_simple_pull_u8(ad);
+		if ((len == 0) || (len > ad->len)) {
+			return;
+		}
+
+		data.type = net_buf_simple_pull_u8(ad);
+		data.data_len = len - 1;
+		data.data = ad->data;
+
+		if (!func(&data, user_data)) {
+			return;
+		}
+
+		net_buf_simple_pull(ad, len - 1);
+	}
+}
+
+/** End of mocks ***********************************/
+
+struct adv_report {
+	uint8_t len;
+	uint8_t data[31];
+};
+
+/* Advertising data of devices commonly found in a dense office environment. */
+static const struct adv_report adv_reports[] = {
+	/* iBeacon */
+	{ 30, { 0x02, 0x01, 0x06, 0x1a, 0xff, 0x4c, 0x00, 0x02, 0x15, 0xe2, 0xc5, 0x6d,
+		0xb5, 0xdf, 0xfb, 0x48, 0xd2, 0xb0, 0x60, 0xd0, 0xf5, 0xa7, 0x10, 0x96,
+		0xe0, 0x00, 0x01, 0x00, 0x02, 0xc5 } },
+	/* Apple continuity, nearby info */
+	{ 17, { 0x02, 0x01, 0x1a, 0x0d, 0xff, 0x4c, 0x00, 0x10, 0x08, 0x1b, 0x1e, 0x4a,
+		0x3b, 0x5c, 0x7d, 0x2e, 0x1f } },
+	/* Eddystone-UID */
+	{ 30, { 0x02, 0x01, 0x06, 0x03, 0x03, 0xaa, 0xfe, 0x16, 0x16, 0xaa, 0xfe, 0x00,
+		0xe7, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+		0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x00 } },
+	/* Google Fast Pair */
+	{ 14, { 0x02, 0x01, 0x06, 0x03, 0x03, 0x2c, 0xfe, 0x06, 0x16, 0x2c, 0xfe, 0x00,
+		0x01, 0x02 } },
+	/* Microsoft Swift Pair */
+	{ 13, { 0x02, 0x01, 0x06, 0x09, 0xff, 0x06, 0x00, 0x03, 0x00, 0x80, 0x4b, 0x42,
+		0x44 } },
+	/* HID keyboard */
+	{ 21, { 0x02, 0x01, 0x05, 0x03, 0x19, 0xc1, 0x03, 0x03, 0x03, 0x12, 0x18, 0x09,
+		0x09, 0x4b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64 } },
+	/* Heart rate sensor */
+	{ 15, { 0x02, 0x01, 0x06, 0x05, 0x03, 0x0d, 0x18, 0x0f, 0x18, 0x05, 0x09, 0x48,
+		0x52, 0x4d, 0x31 } },
+	/* Nordic UART Service peripheral */
+	{ 21, { 0x02, 0x01, 0x06, 0x11, 0x07, 0x9e, 0xca, 0xdc, 0x24, 0x0e, 0xe5, 0xa9,
+		0xe0, 0x93, 0xf3, 0xa3, 0xb5, 0x01, 0x00, 0x40, 0x6e } },
+	/* Asset tag with manufacturer data */
+	{ 14, { 0x02, 0x01, 0x04, 0x0a, 0xff, 0x59, 0x00, 0x01, 0x64, 0x1b, 0x00, 0x00,
+		0x12, 0x34 } },
+	/* Environmental sensor with service data */
+	{ 19, { 0x02, 0x01, 0x06, 0x0f, 0x16, 0x95, 0xfe, 0x50, 0x20, 0xaa, 0x01, 0x3c,
+		0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x0a } },
+};
+
+static uint32_t filter_match_cnt;
+static uint32_t filter_no_match_cnt;
+static struct bt_scan_filter_match last_match;
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	filter_match_cnt++;
+	last_match = *filter_match;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	filter_no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static bt_addr_le_t tags[TAG_COUNT];
+
+static void addr_make(bt_addr_le_t *addr, uint32_t id, uint8_t msb)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	sys_put_le32(id * 2654435761U, addr->a.val);
+	addr->a.val[4] = id >> 16;
+	addr->a.val[5] = msb;
+}
+
+static void report_recv(const bt_addr_le_t *addr, const struct adv_report *report)
+{
+	struct bt_le_scan_recv_info info = {
+		.addr = addr,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE,
+	};
+	struct net_buf_simple ad;
+
+	net_buf_simple_init_with_data(&ad, (void *)report->data, report->len);
+	scancb->recv(&info, &ad);
+}
+
+static void tags_add(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		addr_make(&tags[i], i, 0xc0);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &tags[i]));
+	}
+}
+
+static void *setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	bt_scan_filter_remove_all();
+	bt_scan_filter_disable();
+	filter_match_cnt = 0;
+	filter_no_match_cnt = 0;
+	memset(&last_match, 0, sizeof(last_match));
+}
+
+ZTEST(bt_scan, test_addr_filter_table)
+{
+	struct bt_filter_status status;
+	bt_addr_le_t unknown;
+
+	tags_add();
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+
+	zassert_ok(bt_scan_filter_status_get(&status));
+	zassert_equal(status.addr.cnt, TAG_COUNT);
+
+	/* Full table. */
+	addr_make(&unknown, TAG_COUNT, 0xc0);
+	zassert_equal(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &unknown), -ENOMEM);
+
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		report_recv(&tags[i], &adv_reports[i % ARRAY_SIZE(adv_reports)]);
+		zassert_true(last_match.addr.match);
+		zassert_ok(bt_addr_le_cmp(last_match.addr.addr, &tags[i]));
+	}
+
+	zassert_equal(filter_match_cnt, TAG_COUNT);
+
+	report_recv(&unknown, &adv_reports[0]);
+	zassert_equal(filter_no_match_cnt, 1);
+}
+
+ZTEST(bt_scan, test_addr_filter_remove)
+{
+	struct bt_filter_status status;
+
+	tags_add();
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i += 2) {
+		zassert_ok(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_ADDR, &tags[i]));
+	}
+
+	zassert_equal(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_ADDR, &tags[0]), -ENOENT);
+
+	zassert_ok(bt_scan_filter_status_get(&status));
+	zassert_equal(status.addr.cnt, TAG_COUNT / 2);
+
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		report_recv(&tags[i], &adv_reports[0]);
+	}
+
+	zassert_equal(filter_match_cnt, TAG_COUNT / 2);
+	zassert_equal(filter_no_match_cnt, TAG_COUNT / 2);
+
+	/* Removed slots can be reused. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &tags[0]));
+	report_recv(&tags[0], &adv_reports[0]);
+	zassert_equal(filter_match_cnt, (TAG_COUNT / 2) + 1);
+}
+
+ZTEST(bt_scan, test_uuid_filter)
+{
+	struct bt_uuid_128 nus = BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(0x6e400001, 0xb5a3, 0xf393, 0xe0a9, 0xe50e24dcca9e));
+	struct bt_uuid_32 hrs_32 = BT_UUID_INIT_32(0x180d);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &nus.uuid));
+
+	/* Same UUID in a different size is a duplicate. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs_32.uuid));
+
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false));
+
+	report_recv(&tags[0], &adv_reports[6]);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_equal(last_match.uuid.count, 1);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], BT_UUID_HRS), 0);
+
+	report_recv(&tags[0], &adv_reports[7]);
+	zassert_equal(filter_match_cnt, 2);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], &nus.uuid), 0);
+
+	zassert_ok(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_UUID, &hrs_32.uuid));
+	zassert_equal(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS), -ENOENT);
+
+	report_recv(&tags[0], &adv_reports[6]);
+	zassert_equal(filter_no_match_cnt, 1);
+
+	report_recv(&tags[0], &adv_reports[7]);
+	zassert_equal(filter_match_cnt, 3);
+}
+
+ZTEST(bt_scan, test_uuid_filter_all_mode)
+{
+	/* 16-bit and 128-bit UUID lists in the same report. */
+	static const struct adv_report report = {
+		25, { 0x03, 0x03, 0x12, 0x18, 0x11, 0x07, 0x9e, 0xca, 0xdc, 0x24, 0x0e, 0xe5,
+		      0xa9, 0xe0, 0x93, 0xf3, 0xa3, 0xb5, 0x01, 0x00, 0x40, 0x6e, 0x02, 0x01,
+		      0x06 }
+	};
+	struct bt_uuid_128 nus = BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(0x6e400001, 0xb5a3, 0xf393, 0xe0a9, 0xe50e24dcca9e));
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &nus.uuid));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, true));
+
+	report_recv(&tags[0], &report);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_equal(last_match.uuid.count, 2);
+
+	/* Only the HID service. */
+	report_recv(&tags[0], &adv_reports[5]);
+	zassert_equal(filter_no_match_cnt, 1);
+}
+
+/* HID service advertised in two UUID fields, without a name. */
+static const struct adv_report hids_twice_report = {
+	11, { 0x02, 0x01, 0x05, 0x03, 0x03, 0x12, 0x18, 0x03, 0x02, 0x12, 0x18 }
+};
+
+ZTEST(bt_scan, test_uuid_filter_all_mode_split_fields)
+{
+	/* HID and heart rate services in two separate 16-bit UUID fields. */
+	static const struct adv_report report = {
+		11, { 0x02, 0x01, 0x06, 0x03, 0x03, 0x12, 0x18, 0x03, 0x02, 0x0d, 0x18 }
+	};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HRS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, true));
+
+	/* UUID matches are collected over all UUID fields of the report. */
+	report_recv(&tags[0], &report);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_true(last_match.uuid.match);
+	zassert_equal(last_match.uuid.count, 2);
+
+	/* The same UUID advertised twice is found once. */
+	report_recv(&tags[0], &hids_twice_report);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_equal(filter_no_match_cnt, 1);
+}
+
+ZTEST(bt_scan, test_all_mode_ad_filters)
+{
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Keyboard"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER, true));
+
+	report_recv(&tags[0], &adv_reports[5]);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_true(last_match.name.match);
+	zassert_true(last_match.uuid.match);
+	zassert_equal(last_match.uuid.count, 1);
+
+	/* The UUID filter counts once, however many fields match it. */
+	report_recv(&tags[0], &hids_twice_report);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_equal(filter_no_match_cnt, 1);
+
+	report_recv(&tags[0], &adv_reports[6]);
+	zassert_equal(filter_no_match_cnt, 2);
+}
+
+ZTEST(bt_scan, test_all_mode_addr_mismatch)
+{
+	bt_addr_le_t keyboard;
+	bt_addr_le_t other;
+
+	addr_make(&keyboard, 1, 0xc0);
+	addr_make(&other, 2, 0xc0);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &keyboard));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, true));
+
+	report_recv(&keyboard, &adv_reports[5]);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_true(last_match.addr.match);
+	zassert_true(last_match.uuid.match);
+
+	/* Matching data from another address is not a match. */
+	report_recv(&other, &adv_reports[5]);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_equal(filter_no_match_cnt, 1);
+
+	report_recv(&keyboard, &adv_reports[6]);
+	zassert_equal(filter_no_match_cnt, 2);
+}
+
+ZTEST(bt_scan, test_any_mode_all_matches_reported)
+{
+	uint16_t appearance = 0x03c1;
+	uint8_t company[] = { 0x59, 0x00 };
+	struct bt_scan_manufacturer_data manufacturer_data = {
+		.data = company,
+		.data_len = sizeof(company),
+	};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Keyboard"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_APPEARANCE, &appearance));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA,
+				      &manufacturer_data));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER |
+					 BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+
+	/* All filters matched in the single pass are reported. */
+	report_recv(&tags[0], &adv_reports[5]);
+	zassert_equal(filter_match_cnt, 1);
+	zassert_true(last_match.name.match);
+	zassert_true(last_match.appearance.match);
+	zassert_true(last_match.uuid.match);
+	zassert_false(last_match.manufacturer_data.match);
+
+	report_recv(&tags[0], &adv_reports[8]);
+	zassert_equal(filter_match_cnt, 2);
+	zassert_true(last_match.manufacturer_data.match);
+	zassert_false(last_match.name.match);
+	zassert_false(last_match.uuid.match);
+
+	report_recv(&tags[0], &adv_reports[0]);
+	zassert_equal(filter_no_match_cnt, 1);
+}
+
+ZTEST(bt_scan, test_filter_remove_not_supported)
+{
+	zassert_equal(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_NAME, "Keyboard"), -ENOTSUP);
+	zassert_equal(bt_scan_filter_remove(BT_SCAN_FILTER_TYPE_ADDR, NULL), -EINVAL);
+}
+
+ZTEST_SUITE(bt_scan, NULL, setup, before, NULL, NULL);
+
+/* Replay the advertising reports with addresses from a large population of
+ * devices, of which every TAG_REPORT_INTERVAL report comes from a known tag.
+ */
+ZTEST(bt_scan_benchmark, test_replay)
+{
+	uint32_t reports = 0;
+	uint32_t expected = 0;
+	uint32_t start;
+	uint32_t cycles;
+
+	tags_add();
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, BT_UUID_HIDS));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, false));
+
+	start = k_cycle_get_32();
+
+	for (uint32_t round = 0; round < REPLAY_ROUNDS; round++) {
+		for (size_t i = 0; i < ARRAY_SIZE(adv_reports); i++) {
+			bt_addr_le_t addr;
+
+			if ((reports % TAG_REPORT_INTERVAL) == 0) {
+				addr = tags[(reports / TAG_REPORT_INTERVAL) % TAG_COUNT];
+				expected++;
+			} else {
+				addr_make(&addr, reports, 0x40);
+				if (i == 5) {
+					/* HID keyboard matches the UUID filter. */
+					expected++;
+				}
+			}
+
+			report_recv(&addr, &adv_reports[i]);
+			reports++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(filter_match_cnt, expected);
+	zassert_equal(filter_match_cnt + filter_no_match_cnt, reports);
+
+	TC_PRINT("Filter index %s, %u address filters: %u reports, %u cycles per report\n",
+		 IS_ENABLED(CONFIG_BT_SCAN_FILTER_INDEX) ? "on" : "off", TAG_COUNT,
+		 reports, cycles / reports);
+}
+
+ZTEST_SUITE(bt_scan_benchmark, NULL, setup, before, NULL, NULL);
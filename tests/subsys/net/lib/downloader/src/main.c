@@ -8,6 +8,7 @@
 
 #include <net/downloader.h>
 #include <net/downloader_transport_coap.h>
+#include <net/downloader_transport_http.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/coap.h>
 
@@ -146,6 +147,11 @@
 "Vary: Accept-Encoding\r\n" \
 "X-Cache: HIT\r\n\r\n"
 
+#define HTTPS_HDR_PIPELINED(range) \
+"HTTP/1.1 206 Partial Content\r\n" \
+"Content-Length: 32\r\n" \
+"Content-Range: bytes " range "/96\r\n\r\n"
+
 #define HTTP_HDR_REDIRECT "HTTP/1.1 308 Permanent Redirect\r\n" \
 "Date: Wed, 29 Jan 2025 11:16:09 GMT\r\n" \
 "Content-Type: text/html\r\n" \
@@ -160,6 +166,7 @@
 
 static int dl_callback(const struct downloader_evt *event);
 static int dl_callback_abort(const struct downloader_evt *event);
+static int dl_callback_pipelined(const struct downloader_evt *event);
 
 static struct downloader dl;
 
@@ -176,6 +183,12 @@ struct downloader_cfg dl_cfg_small_buffer = {
 	.buf_size = 32,
 };
 
+struct downloader_cfg dl_cfg_cb_pipelined = {
+	.callback = dl_callback_pipelined,
+	.buf = dl_buf,
+	.buf_size = sizeof(dl_buf),
+};
+
 struct downloader_cfg dl_cfg_cb_abort = {
 	.callback = dl_callback_abort,
 	.buf = dl_buf,
@@ -852,6 +865,35 @@ static ssize_t z_impl_zsock_recvfrom_https_partial_content(
 	return 0;
 }
 
+/* All three pipelined responses are received at once, each range filled with its number */
+static ssize_t z_impl_zsock_recvfrom_https_pipelined(
+	int sock, void *buf, size_t max_len, int flags, struct sockaddr *src_addr,
+	socklen_t *addrlen)
+{
+	static const char *const headers[] = {
+		HTTPS_HDR_PIPELINED("0-31"),
+		HTTPS_HDR_PIPELINED("32-63"),
+		HTTPS_HDR_PIPELINED("64-95"),
+	};
+	char *p = buf;
+
+	TEST_ASSERT_EQUAL(FD, sock);
+	TEST_ASSERT(sizeof(dl_buf) >= max_len);
+
+	if (z_impl_zsock_recvfrom_fake.call_count > 1) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(headers); i++) {
+		memcpy(p, headers[i], strlen(headers[i]));
+		p += strlen(headers[i]);
+		memset(p, i + 1, 32);
+		p += 32;
+	}
+
+	return p - (char *)buf;
+}
+
 static ssize_t z_impl_zsock_recvfrom_https_partial_content_partial_2nd_header(
 	int sock, void *buf, size_t max_len, int flags, struct sockaddr *src_addr,
 	socklen_t *addrlen)
@@ -1218,6 +1260,24 @@ static int dl_callback(const struct downloader_evt *event)
 	return 0;
 }
 
+static size_t pipelined_progress;
+
+static int dl_callback_pipelined(const struct downloader_evt *event)
+{
+	if (event->id == DOWNLOADER_EVT_FRAGMENT) {
+		const uint8_t *data = event->fragment.buf;
+
+		/* Ranges must be delivered in order */
+		for (size_t i = 0; i < event->fragment.len; i++) {
+			TEST_ASSERT_EQUAL((pipelined_progress + i) / 32 + 1, data[i]);
+		}
+
+		pipelined_progress += event->fragment.len;
+	}
+
+	return dl_callback(event);
+}
+
 static int dl_callback_abort(const struct downloader_evt *event)
 {
 	TEST_ASSERT(event != NULL);
@@ -1346,6 +1406,36 @@ void test_downloader_get_http(void)
 	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
 }
 
+void test_downloader_get_http_data_refused(void)
+{
+	int err;
+	struct downloader_evt evt;
+
+	err = downloader_init(&dl, &dl_cfg_cb_abort);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ipv6_fail_ipv4_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv4;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_http_ipv4_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv4_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_http_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_http_header_then_data;
+
+	err = downloader_get(&dl, &dl_host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_FRAGMENT, K_SECONDS(3));
+	evt = dl_wait_for_event(DOWNLOADER_EVT_STOPPED, K_SECONDS(3));
+
+	/* The refused fragment is not part of the progress, resuming requests it again */
+	TEST_ASSERT_EQUAL(0, dl.progress);
+	TEST_ASSERT_FALSE(dl.complete);
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
 void test_downloader_get_http_partial_header(void)
 {
 	int err;
@@ -1449,6 +1539,43 @@ void test_downloader_get_https_partial_content_partial_2nd_header(void)
 	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
 }
 
+void test_downloader_get_https_pipelined(void)
+{
+	int err;
+	struct downloader_transport_http_cfg http_cfg = {
+		.pipeline_depth = 3,
+	};
+
+	pipelined_progress = 0;
+
+	err = downloader_init(&dl, &dl_cfg_cb_pipelined);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_https_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_https_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_https_pipelined;
+
+	err = downloader_transport_http_set_config(&dl, &http_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = downloader_get(&dl, &dl_host_conf_w_sec_tags_range_override_32, HTTPS_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	/* All ranges requested up front, and parsed from one receive */
+	TEST_ASSERT_EQUAL(3, z_impl_zsock_sendto_fake.call_count);
+	TEST_ASSERT_EQUAL(1, z_impl_zsock_recvfrom_fake.call_count);
+	TEST_ASSERT_EQUAL(96, pipelined_progress);
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
 void test_downloader_https_unlimited_redirect(void)
 {
 	int err;
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/fff.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/logging/log.h>
+#include <net/downloader.h>
+
+#include "dl_checkpoint.h"
+
+LOG_MODULE_REGISTER(downloader, CONFIG_DOWNLOADER_LOG_LEVEL);
+
+#define CHECKPOINT_KEY "dl/test"
+#define URL "https://server.com/path/to/file.end"
+#define URL2 "https://server.com/path/to/file2.end"
+#define ETAG "\"3147526947\""
+#define ETAG2 "\"3147526948\""
+#define ETAG_TOO_LONG "\"31475269473147526947\""
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, settings_save_one, const char *, const void *, size_t);
+FAKE_VALUE_FUNC(int, settings_delete, const char *);
+FAKE_VALUE_FUNC(int, settings_load_subtree_direct, const char *, settings_load_direct_cb,
+		void *);
+
+static struct downloader dl;
+static uint8_t chunk[256];
+
+/* Settings storage of a single entry */
+static uint8_t stored[sizeof(struct downloader_checkpoint) + 1];
+static size_t stored_len;
+
+static int settings_save_one_store(const char *name, const void *value, size_t val_len)
+{
+	TEST_ASSERT_EQUAL_STRING(CHECKPOINT_KEY, name);
+	TEST_ASSERT(val_len <= sizeof(stored));
+
+	memcpy(stored, value, val_len);
+	stored_len = val_len;
+
+	return 0;
+}
+
+static int settings_delete_store(const char *name)
+{
+	TEST_ASSERT_EQUAL_STRING(CHECKPOINT_KEY, name);
+
+	stored_len = 0;
+
+	return 0;
+}
+
+static ssize_t stored_read(void *cb_arg, void *data, size_t len)
+{
+	len = MIN(len, stored_len);
+	memcpy(data, stored, len);
+
+	return len;
+}
+
+static int settings_load_subtree_direct_store(const char *subtree, settings_load_direct_cb cb,
+					      void *param)
+{
+	TEST_ASSERT_EQUAL_STRING(CHECKPOINT_KEY, subtree);
+
+	if (stored_len == 0) {
+		return 0;
+	}
+
+	return cb(NULL, stored_len, stored_read, NULL, param);
+}
+
+/* Download len bytes, as the transports do before the data event */
+static void download(size_t len)
+{
+	dl.progress += len;
+	dl_checkpoint_update(&dl, chunk, len);
+}
+
+static const struct downloader_checkpoint *stored_checkpoint(void)
+{
+	TEST_ASSERT_EQUAL(sizeof(struct downloader_checkpoint), stored_len);
+
+	return (const struct downloader_checkpoint *)stored;
+}
+
+void setUp(void)
+{
+	RESET_FAKE(settings_save_one);
+	RESET_FAKE(settings_delete);
+	RESET_FAKE(settings_load_subtree_direct);
+
+	settings_save_one_fake.custom_fake = settings_save_one_store;
+	settings_delete_fake.custom_fake = settings_delete_store;
+	settings_load_subtree_direct_fake.custom_fake = settings_load_subtree_direct_store;
+
+	memset(&dl, 0, sizeof(dl));
+	dl.cfg.checkpoint_key = CHECKPOINT_KEY;
+	dl.file_size = 4 * CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL;
+
+	for (size_t i = 0; i < sizeof(chunk); i++) {
+		chunk[i] = i;
+	}
+
+	stored_len = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_checkpoint_no_key(void)
+{
+	dl.cfg.checkpoint_key = NULL;
+
+	dl_checkpoint_start(&dl, URL, 0);
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+
+	download(2 * CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL);
+	dl_checkpoint_flush(&dl);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+
+	TEST_ASSERT_EQUAL(0, settings_save_one_fake.call_count);
+	TEST_ASSERT_EQUAL(0, settings_delete_fake.call_count);
+}
+
+void test_checkpoint_start_deletes_old(void)
+{
+	stored_len = sizeof(struct downloader_checkpoint);
+
+	dl_checkpoint_start(&dl, URL, 0);
+
+	TEST_ASSERT_TRUE(dl.checkpoint_active);
+	TEST_ASSERT_EQUAL(1, settings_delete_fake.call_count);
+	TEST_ASSERT_EQUAL(0, stored_len);
+	TEST_ASSERT_EQUAL(crc32_ieee((const uint8_t *)URL, strlen(URL)), dl.checkpoint.url_crc);
+}
+
+void test_checkpoint_saved_at_interval(void)
+{
+	size_t chunks = CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL / sizeof(chunk);
+	uint32_t crc = 0;
+
+	dl_checkpoint_start(&dl, URL, 0);
+
+	for (size_t i = 0; i < chunks - 1; i++) {
+		download(sizeof(chunk));
+		crc = crc32_ieee_update(crc, chunk, sizeof(chunk));
+	}
+	TEST_ASSERT_EQUAL(0, settings_save_one_fake.call_count);
+
+	download(sizeof(chunk));
+	crc = crc32_ieee_update(crc, chunk, sizeof(chunk));
+	TEST_ASSERT_EQUAL(1, settings_save_one_fake.call_count);
+
+	TEST_ASSERT_EQUAL(CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL, stored_checkpoint()->progress);
+	TEST_ASSERT_EQUAL(dl.file_size, stored_checkpoint()->file_size);
+	TEST_ASSERT_EQUAL(crc, stored_checkpoint()->crc);
+}
+
+void test_checkpoint_flush(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+	TEST_ASSERT_EQUAL(1, settings_save_one_fake.call_count);
+	TEST_ASSERT_EQUAL(sizeof(chunk), stored_checkpoint()->progress);
+
+	/* Nothing new to save */
+	dl_checkpoint_flush(&dl);
+	TEST_ASSERT_EQUAL(1, settings_save_one_fake.call_count);
+}
+
+void test_checkpoint_not_saved_when_complete(void)
+{
+	dl.file_size = CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL;
+	dl_checkpoint_start(&dl, URL, 0);
+
+	download(CONFIG_DOWNLOADER_CHECKPOINT_INTERVAL);
+	TEST_ASSERT_EQUAL(0, settings_save_one_fake.call_count);
+
+	dl.complete = true;
+	dl_checkpoint_flush(&dl);
+	TEST_ASSERT_EQUAL(0, settings_save_one_fake.call_count);
+
+	dl_checkpoint_complete(&dl);
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+	TEST_ASSERT_EQUAL(0, stored_len);
+}
+
+void test_checkpoint_resume(void)
+{
+	struct downloader_checkpoint saved;
+
+	dl_checkpoint_start(&dl, URL, 0);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+	memcpy(&saved, stored_checkpoint(), sizeof(saved));
+
+	/* Reset */
+	memset(&dl, 0, sizeof(dl));
+	dl.cfg.checkpoint_key = CHECKPOINT_KEY;
+	dl.progress = saved.progress;
+
+	dl_checkpoint_start(&dl, URL, saved.progress);
+	TEST_ASSERT_TRUE(dl.checkpoint_active);
+	TEST_ASSERT_EQUAL(saved.crc, dl.checkpoint.crc);
+	TEST_ASSERT_EQUAL_STRING(ETAG, dl.checkpoint.etag);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+
+	/* The running CRC continues from the saved one */
+	download(sizeof(chunk));
+	TEST_ASSERT_EQUAL(crc32_ieee_update(saved.crc, chunk, sizeof(chunk)), dl.checkpoint.crc);
+}
+
+void test_checkpoint_resume_mismatch(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+
+	/* Other URL */
+	dl_checkpoint_start(&dl, URL2, sizeof(chunk));
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+
+	/* Other offset */
+	dl_checkpoint_start(&dl, URL, 2 * sizeof(chunk));
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+
+	/* No checkpoint */
+	stored_len = 0;
+	dl_checkpoint_start(&dl, URL, sizeof(chunk));
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+}
+
+void test_checkpoint_resume_wrong_size(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+
+	/* Saved by a build with another entity tag size */
+	stored_len++;
+
+	dl_checkpoint_start(&dl, URL, sizeof(chunk));
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+}
+
+void test_checkpoint_etag_changed(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+
+	dl_checkpoint_start(&dl, URL, sizeof(chunk));
+	TEST_ASSERT_TRUE(dl.checkpoint_active);
+
+	TEST_ASSERT_EQUAL(-ESTALE, dl_checkpoint_etag_check(&dl, ETAG2, strlen(ETAG2)));
+	TEST_ASSERT_FALSE(dl.checkpoint_active);
+	TEST_ASSERT_EQUAL(0, stored_len);
+
+	/* Nothing is saved when the download is stopped */
+	dl.progress += sizeof(chunk);
+	dl_checkpoint_flush(&dl);
+	TEST_ASSERT_EQUAL(0, stored_len);
+}
+
+void test_checkpoint_etag_prefix(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+
+	TEST_ASSERT_EQUAL(-ESTALE, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG) - 1));
+}
+
+void test_checkpoint_etag_too_long(void)
+{
+	dl_checkpoint_start(&dl, URL, 0);
+
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG_TOO_LONG,
+						      strlen(ETAG_TOO_LONG)));
+	TEST_ASSERT_EQUAL_STRING("", dl.checkpoint.etag);
+
+	/* Not verified */
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+	TEST_ASSERT_TRUE(dl.checkpoint_active);
+}
+
+void test_checkpoint_get_einval(void)
+{
+	struct downloader_checkpoint checkpoint;
+
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_get(NULL, URL, &checkpoint));
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_get(&dl, NULL, &checkpoint));
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_get(&dl, URL, NULL));
+
+	dl.cfg.checkpoint_key = NULL;
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_get(&dl, URL, &checkpoint));
+}
+
+void test_checkpoint_get(void)
+{
+	struct downloader_checkpoint checkpoint;
+
+	TEST_ASSERT_EQUAL(-ENOENT, downloader_checkpoint_get(&dl, URL, &checkpoint));
+
+	dl_checkpoint_start(&dl, URL, 0);
+	TEST_ASSERT_EQUAL(0, dl_checkpoint_etag_check(&dl, ETAG, strlen(ETAG)));
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+
+	TEST_ASSERT_EQUAL(-ENOENT, downloader_checkpoint_get(&dl, URL2, &checkpoint));
+
+	TEST_ASSERT_EQUAL(0, downloader_checkpoint_get(&dl, URL, &checkpoint));
+	TEST_ASSERT_EQUAL(sizeof(chunk), checkpoint.progress);
+	TEST_ASSERT_EQUAL(dl.file_size, checkpoint.file_size);
+	TEST_ASSERT_EQUAL(crc32_ieee(chunk, sizeof(chunk)), checkpoint.crc);
+	TEST_ASSERT_EQUAL_STRING(ETAG, checkpoint.etag);
+}
+
+void test_checkpoint_get_load_error(void)
+{
+	struct downloader_checkpoint checkpoint;
+
+	settings_load_subtree_direct_fake.custom_fake = NULL;
+	settings_load_subtree_direct_fake.return_val = -EIO;
+
+	TEST_ASSERT_EQUAL(-EIO, downloader_checkpoint_get(&dl, URL, &checkpoint));
+}
+
+void test_checkpoint_clear(void)
+{
+	struct downloader_checkpoint checkpoint;
+
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_clear(NULL));
+
+	dl_checkpoint_start(&dl, URL, 0);
+	download(sizeof(chunk));
+	dl_checkpoint_flush(&dl);
+
+	TEST_ASSERT_EQUAL(0, downloader_checkpoint_clear(&dl));
+	TEST_ASSERT_EQUAL(-ENOENT, downloader_checkpoint_get(&dl, URL, &checkpoint));
+
+	dl.cfg.checkpoint_key = NULL;
+	TEST_ASSERT_EQUAL(-EINVAL, downloader_checkpoint_clear(&dl));
+}
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
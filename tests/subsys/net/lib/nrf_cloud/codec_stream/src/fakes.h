@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <nrf_cloud_transport.h>
+#include <nrf_cloud_fsm.h>
+#include <net/nrf_cloud_log.h>
+#include <zephyr/fff.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* The transport, the state machine and the cloud logger are not part of the codec */
+FAKE_VOID_FUNC(nct_dc_endpoint_get, struct nct_dc_endpoints *const);
+FAKE_VALUE_FUNC(int, nct_dc_send, const struct nct_dc_data *);
+FAKE_VOID_FUNC(nct_set_topic_prefix, const char *);
+FAKE_VALUE_FUNC(enum nfsm_state, nfsm_get_current_state);
+FAKE_VOID_FUNC(nrf_cloud_log_control_set, int);
+FAKE_VALUE_FUNC(int, nrf_cloud_log_control_get);
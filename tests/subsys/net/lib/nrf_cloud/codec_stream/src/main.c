@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <cJSON.h>
+
+#include "fakes.h"
+
+/* Included to reach the cJSON paths the streaming codec falls back to. */
+#include "nrf_cloud_codec_internal.c"
+
+#define BENCH_ITERATIONS 1000
+#define TS_MS 1767225600123LL
+
+static const char location_rest[] =
+	"{\"lat\":63.42173,\"lon\":10.43742,\"uncertainty\":1204,\"fulfilledWith\":\"MCELL\"}";
+static const char location_mqtt[] =
+	"{\"appId\":\"LOCATION\",\"messageType\":\"DATA\",\"data\":{\"lat\":63.42173,"
+	"\"lon\":10.43742,\"uncertainty\":1204,\"fulfilledWith\":\"SCELL\"}}";
+static const char location_wifi[] =
+	"{\"fulfilledWith\":\"WIFI\", \"uncertainty\":25.5, \"lon\":-1.5e-1, \"lat\":52}";
+
+/* Responses the streaming decoder leaves to cJSON */
+static const char location_anchor[] =
+	"{\"lat\":63.42173,\"lon\":10.43742,\"uncertainty\":10,\"fulfilledWith\":\"ANCHOR\","
+	"\"anchors\":[{\"macAddress\":\"00:11:22:33:44:55\",\"name\":\"office\"}]}";
+static const char location_error[] =
+	"{\"appId\":\"LOCATION\",\"messageType\":\"DATA\",\"err\":40410}";
+static const char location_other[] =
+	"{\"appId\":\"AGNSS\",\"messageType\":\"DATA\",\"data\":{\"lat\":1,\"lon\":2}}";
+static const char location_not_json[] = "location";
+
+static size_t heap_cur;
+static size_t heap_peak;
+
+/* Memory hooks of the library and of cJSON that record the peak heap usage */
+static void *counting_malloc(size_t size)
+{
+	size_t *p = k_malloc(size + sizeof(size_t));
+
+	if (!p) {
+		return NULL;
+	}
+
+	*p = size;
+	heap_cur += size;
+	heap_peak = MAX(heap_peak, heap_cur);
+
+	return p + 1;
+}
+
+static void *counting_calloc(size_t count, size_t size)
+{
+	void *p = counting_malloc(count * size);
+
+	if (p) {
+		memset(p, 0, count * size);
+	}
+
+	return p;
+}
+
+static void counting_free(void *ptr)
+{
+	size_t *p;
+
+	if (!ptr) {
+		return;
+	}
+
+	p = (size_t *)ptr - 1;
+	heap_cur -= *p;
+	k_free(p);
+}
+
+static void heap_reset(void)
+{
+	heap_cur = 0;
+	heap_peak = 0;
+}
+
+static void sensor_check(const struct nrf_cloud_sensor_data *sensor)
+{
+	char buf[CONFIG_NRF_CLOUD_CODEC_STREAM_BUF_SIZE];
+	struct nrf_cloud_data ref;
+	struct nrf_cloud_data out;
+
+	zassert_ok(nrf_cloud_sensor_data_encode(sensor, &ref));
+
+	heap_reset();
+	zassert_ok(nrf_cloud_sensor_data_stream_encode(sensor, buf, sizeof(buf), &out));
+	zassert_equal(heap_peak, 0);
+	zassert_equal_ptr(out.ptr, buf);
+	zassert_equal(out.len, ref.len);
+	zassert_str_equal(out.ptr, ref.ptr);
+
+	nrf_cloud_free((void *)ref.ptr);
+}
+
+static void control_check(const struct nrf_cloud_ctrl_data *ctrl, bool accept)
+{
+	struct nrf_cloud_data ref;
+	struct nrf_cloud_data out;
+
+	zassert_ok(shadow_control_response_cjson_encode(ctrl, accept, &ref));
+
+	/* The streamed response is used, and is the same as the cJSON one */
+	zassert_ok(shadow_control_response_stream_encode(ctrl, accept, &out));
+	nrf_cloud_free((void *)out.ptr);
+
+	zassert_ok(nrf_cloud_shadow_control_response_encode(ctrl, accept, &out));
+	zassert_equal(out.len, ref.len);
+	zassert_str_equal(out.ptr, ref.ptr);
+
+	nrf_cloud_free((void *)out.ptr);
+	nrf_cloud_free((void *)ref.ptr);
+}
+
+static void location_check(const char *buf, int stream_ret)
+{
+	struct nrf_cloud_location_result ref = {0};
+	struct nrf_cloud_location_result res = {0};
+	int ref_ret = location_response_cjson_decode(buf, &ref);
+	int ret;
+
+	zassert_equal(location_response_stream_decode(buf, &res), stream_ret);
+
+	memset(&res, 0, sizeof(res));
+	heap_reset();
+	ret = nrf_cloud_location_response_decode(buf, &res);
+	if (stream_ret == 0) {
+		zassert_equal(heap_peak, 0);
+	}
+
+	zassert_equal(ret, ref_ret);
+	zassert_equal(res.type, ref.type);
+	zassert_equal(res.lat, ref.lat);
+	zassert_equal(res.lon, ref.lon);
+	zassert_equal(res.unc, ref.unc);
+	zassert_equal(res.err, ref.err);
+}
+
+static void *setup(void)
+{
+	struct nrf_cloud_os_mem_hooks hooks = {
+		.malloc_fn = counting_malloc,
+		.calloc_fn = counting_calloc,
+		.free_fn = counting_free,
+	};
+
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_codec_stream, NULL, setup, NULL, NULL, NULL);
+
+ZTEST(nrf_cloud_codec_stream, test_sensor_matches_cjson)
+{
+	struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data.ptr = "24.5",
+		.data.len = sizeof("24.5") - 1,
+		.ts_ms = TS_MS,
+	};
+
+	sensor_check(&sensor);
+
+	sensor.ts_ms = NRF_CLOUD_NO_TIMESTAMP;
+	sensor_check(&sensor);
+
+	/* Characters that must be escaped */
+	sensor.type = NRF_CLOUD_LOG;
+	sensor.data.ptr = "\"quoted\"\\path\n\ttab\x01";
+	sensor.data.len = strlen(sensor.data.ptr);
+	sensor_check(&sensor);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_sensor_no_space)
+{
+	char buf[32];
+	struct nrf_cloud_data out = {0};
+	struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_AIR_PRESS,
+		.data.ptr = "101.325",
+		.data.len = sizeof("101.325") - 1,
+		.ts_ms = TS_MS,
+	};
+
+	zassert_equal(nrf_cloud_sensor_data_stream_encode(&sensor, buf, sizeof(buf), &out),
+		      -ENOMEM);
+	zassert_is_null(out.ptr);
+	zassert_equal(out.len, 0);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_control_matches_cjson)
+{
+	struct nrf_cloud_ctrl_data ctrl = {
+		.alerts_enabled = true,
+		.log_level = LOG_LEVEL_INF,
+	};
+
+	control_check(&ctrl, true);
+	control_check(&ctrl, false);
+
+	ctrl.alerts_enabled = false;
+	ctrl.log_level = LOG_LEVEL_NONE;
+	control_check(&ctrl, true);
+	control_check(&ctrl, false);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_location_matches_cjson)
+{
+	location_check(location_rest, 0);
+	location_check(location_mqtt, 0);
+	location_check(location_wifi, 0);
+
+	location_check(location_anchor, -ENOTSUP);
+	location_check(location_error, -ENOTSUP);
+	location_check(location_other, -ENOTSUP);
+	location_check(location_not_json, -ENOTSUP);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_writer_escape)
+{
+	char buf[64];
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, NULL, "a\"b\\c\n\x01");
+	nrf_cloud_json_bool_add(&w, NULL, false);
+	nrf_cloud_json_num_add(&w, NULL, NAN);
+	nrf_cloud_json_arr_end(&w);
+
+	zassert_true(nrf_cloud_json_writer_finish(&w) > 0);
+	zassert_str_equal(buf, "[\"a\\\"b\\\\c\\n\\u0001\",false,null]");
+}
+
+ZTEST(nrf_cloud_codec_stream, test_writer_errors)
+{
+	char buf[16];
+	struct nrf_cloud_json_writer w;
+
+	/* Does not fit, and the buffer is not overrun */
+	nrf_cloud_json_writer_init(&w, buf, 8);
+	buf[8] = 'x';
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, "key", "value");
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -ENOMEM);
+	zassert_equal(buf[8], 'x');
+
+	/* Unbalanced containers */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_reader)
+{
+	struct nrf_cloud_json_span root, obj, val;
+	double num;
+
+	nrf_cloud_json_span_init(&root, location_mqtt);
+	zassert_ok(nrf_cloud_json_member_get(&root, "appId", &val));
+	zassert_true(nrf_cloud_json_str_eq(&val, "LOCATION"));
+	zassert_false(nrf_cloud_json_str_eq(&val, "LOC"));
+	zassert_ok(nrf_cloud_json_member_get(&root, "data", &obj));
+	zassert_ok(nrf_cloud_json_member_get(&obj, "uncertainty", &val));
+	zassert_ok(nrf_cloud_json_num_get(&val, &num));
+	zassert_equal(num, 1204);
+	/* Members of nested objects are not members of the root */
+	zassert_equal(nrf_cloud_json_member_get(&root, "lat", &val), -ENOENT);
+
+	/* Nested containers and strings with delimiters are skipped */
+	nrf_cloud_json_span_init(&root, "{ \"a\" : [1, {\"b\": \"}],\\\"\"}] , \"c\" : -2.5e1 }");
+	zassert_ok(nrf_cloud_json_member_get(&root, "c", &val));
+	zassert_ok(nrf_cloud_json_num_get(&val, &num));
+	zassert_equal(num, -25.0);
+
+	nrf_cloud_json_span_init(&root, "{\"a\":1");
+	zassert_equal(nrf_cloud_json_member_get(&root, "b", &val), -EBADMSG);
+	nrf_cloud_json_span_init(&root, "[1]");
+	zassert_equal(nrf_cloud_json_member_get(&root, "a", &val), -EBADMSG);
+	nrf_cloud_json_span_init(&root, "{\"a\":\"1\"}");
+	zassert_ok(nrf_cloud_json_member_get(&root, "a", &val));
+	zassert_equal(nrf_cloud_json_num_get(&val, &num), -EBADMSG);
+}
+
+
+static uint64_t bench_start(void)
+{
+	heap_reset();
+	return k_cycle_get_64();
+}
+
+static void bench_report(const char *name, uint64_t start)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(k_cycle_get_64() - start);
+
+	TC_PRINT("%-30s %8llu ns/op, peak heap %4u bytes\n", name, ns / BENCH_ITERATIONS,
+		 (unsigned int)heap_peak);
+}
+
+ZTEST(nrf_cloud_codec_stream, test_benchmark)
+{
+	char buf[CONFIG_NRF_CLOUD_CODEC_STREAM_BUF_SIZE];
+	struct nrf_cloud_data out;
+	struct nrf_cloud_location_result res = {0};
+	struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data.ptr = "24.5",
+		.data.len = sizeof("24.5") - 1,
+		.ts_ms = TS_MS,
+	};
+	struct nrf_cloud_ctrl_data ctrl = {
+		.alerts_enabled = true,
+		.log_level = LOG_LEVEL_INF,
+	};
+	uint64_t start;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER);
+
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		nrf_cloud_sensor_data_encode(&sensor, &out);
+		nrf_cloud_free((void *)out.ptr);
+	}
+	bench_report("sensor encode, cJSON", start);
+
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		nrf_cloud_sensor_data_stream_encode(&sensor, buf, sizeof(buf), &out);
+	}
+	bench_report("sensor encode, stream", start);
+	zassert_equal(heap_peak, 0);
+
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		shadow_control_response_cjson_encode(&ctrl, false, &out);
+		nrf_cloud_free((void *)out.ptr);
+	}
+	bench_report("shadow control encode, cJSON", start);
+
+	/* Only the copy of the response that the caller frees is allocated */
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		nrf_cloud_shadow_control_response_encode(&ctrl, false, &out);
+		nrf_cloud_free((void *)out.ptr);
+	}
+	bench_report("shadow control encode, stream", start);
+	zassert_equal(heap_peak, out.len + 1);
+
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		location_response_cjson_decode(location_mqtt, &res);
+	}
+	bench_report("location decode, cJSON", start);
+
+	start = bench_start();
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		nrf_cloud_location_response_decode(location_mqtt, &res);
+	}
+	bench_report("location decode, stream", start);
+	zassert_equal(heap_peak, 0);
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <time.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <date_time.h>
+
+/* Included to reach the prediction index and the state of the library. */
+#include "nrf_cloud_pgps.c"
+
+#define TEST_PERIOD_SEC (PREDICTION_PERIOD * SEC_PER_MIN)
+/* Predictions are not stored in time order, as after a replacement of expired ones */
+#define TEST_BLOCK_SHIFT 3
+
+static uint8_t storage[NUM_BLOCKS * BLOCK_SIZE] __aligned(4);
+static struct nrf_cloud_pgps_header header;
+static int set_count;
+static int64_t first_start_sec;
+static int64_t start_sec;
+static uint16_t bad_day;
+static uint32_t bad_time;
+
+/** Helpers ****************************************/
+
+static struct nrf_cloud_pgps_prediction *block_prediction(int block)
+{
+	return (struct nrf_cloud_pgps_prediction *)&storage[block * BLOCK_SIZE];
+}
+
+static int prediction_block(int pnum)
+{
+	return (pnum + TEST_BLOCK_SHIFT) % set_count;
+}
+
+static void prediction_write(int pnum, int block)
+{
+	struct nrf_cloud_pgps_prediction *p = block_prediction(block);
+	int64_t gps_sec = start_sec + (int64_t)pnum * TEST_PERIOD_SEC;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
+
+	memset(p, 0, sizeof(*p));
+	p->time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK;
+	p->time_count = 1;
+	p->time.date_day = gps_day;
+	p->time.time_full_s = gps_time_of_day;
+	p->schema_version = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+	p->ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES;
+	p->ephemeris_count = NRF_CLOUD_PGPS_NUM_SV;
+	p->sentinel = (uint32_t)gps_sec;
+}
+
+static void predictions_write(int count)
+{
+	memset(storage, 0xFF, sizeof(storage));
+	set_count = count;
+
+	for (int pnum = 0; pnum < count; pnum++) {
+		prediction_write(pnum, prediction_block(pnum));
+	}
+}
+
+static void header_set(int count)
+{
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	npgps_gps_sec_to_day_time(start_sec, &gps_day, &gps_time_of_day);
+
+	header.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION;
+	header.array_type = NRF_CLOUD_PGPS_PREDICTION_HEADER;
+	header.num_items = 1;
+	header.prediction_count = count;
+	header.prediction_size = sizeof(struct nrf_cloud_pgps_prediction);
+	header.prediction_period_min = PREDICTION_PERIOD;
+	header.gps_day = gps_day;
+	header.gps_time_of_day = gps_time_of_day;
+}
+
+/* Does what nrf_cloud_pgps_init() does with a valid saved header. */
+static int boot(void)
+{
+	memset(&index, 0, sizeof(index));
+	state = PGPS_INITIALIZING;
+	loading_in_progress = false;
+
+	storage_addr = (uint32_t)storage;
+	storage_size = sizeof(storage);
+	(void)ngps_block_pool_init(storage_addr, NUM_PREDICTIONS);
+
+	zassert_true(validate_pgps_header(&header));
+	cache_pgps_header(&header);
+
+	return load_stored_predictions(&bad_day, &bad_time);
+}
+
+static void index_check(int count)
+{
+	const struct npgps_saved_index *saved = npgps_get_saved_index();
+
+	zassert_equal(saved->count, count);
+	zassert_equal(saved->start_sec, start_sec);
+
+	for (int pnum = 0; pnum < count; pnum++) {
+		zassert_equal_ptr(index.predictions[pnum],
+				  block_prediction(prediction_block(pnum)));
+		zassert_equal(saved->block[pnum], prediction_block(pnum));
+	}
+}
+
+static int blocks_validated(void)
+{
+	int num = 0;
+
+	for (int block = 0; block < NUM_BLOCKS; block++) {
+		num += block_validated[block] ? 1 : 0;
+	}
+
+	return num;
+}
+
+/* The prediction nrf_cloud_pgps_find_prediction() selects for the current time. */
+static int current_pnum(void)
+{
+	int64_t gps_sec;
+
+	zassert_ok(npgps_get_shifted_time(&gps_sec, NULL, NULL, PREDICTION_MIDPOINT_SHIFT_SEC));
+
+	return (int)((gps_sec - start_sec) / TEST_PERIOD_SEC);
+}
+
+static void *setup(void)
+{
+	/* Monday, 2026-01-05 12:00:00 UTC */
+	struct tm now = {
+		.tm_year = 126,
+		.tm_mon = 0,
+		.tm_mday = 5,
+		.tm_hour = 12,
+	};
+	int64_t gps_sec;
+
+	zassert_ok(date_time_set(&now));
+	zassert_ok(npgps_get_time(&gps_sec, NULL, NULL));
+
+	/* The current time is within the first predictions of the set */
+	first_start_sec = gps_sec - (gps_sec % TEST_PERIOD_SEC);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	start_sec = first_start_sec;
+	header_set(NUM_PREDICTIONS);
+	predictions_write(NUM_PREDICTIONS);
+	(void)npgps_save_index(NULL);
+}
+
+static void after(void *fixture)
+{
+	k_timer_stop(&prediction_timer);
+}
+
+/** Tests ******************************************/
+
+ZTEST(nrf_cloud_pgps, test_load_from_index)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+	int pnum = current_pnum();
+	int block = prediction_block(pnum);
+
+	/* Without an index, the storage is scanned and the index is saved. */
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	zassert_equal(blocks_validated(), NUM_PREDICTIONS);
+	index_check(NUM_PREDICTIONS);
+
+	/* With it, the predictions are located without being validated. */
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	zassert_equal(blocks_validated(), 0);
+	index_check(NUM_PREDICTIONS);
+
+	/* A prediction is validated the first time it is used, and only then. */
+	state = PGPS_READY;
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), pnum);
+	zassert_equal_ptr(prediction, block_prediction(block));
+	zassert_true(block_validated[block]);
+	zassert_equal(blocks_validated(), 1);
+
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), pnum);
+	zassert_equal(blocks_validated(), 1);
+	zassert_equal(state, PGPS_READY);
+}
+
+ZTEST(nrf_cloud_pgps, test_load_index_mismatch)
+{
+	int pnum = NUM_PREDICTIONS - 1;
+
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	index_check(NUM_PREDICTIONS);
+
+	/* The last prediction is overwritten by the first one of a later set. */
+	start_sec += NUM_PREDICTIONS * TEST_PERIOD_SEC;
+	prediction_write(0, prediction_block(pnum));
+	start_sec = first_start_sec;
+
+	/* Its sentinel does not match the index, so the storage is scanned. */
+	zassert_equal(load_indexed_predictions(&bad_day, &bad_time), -EBADMSG);
+
+	zassert_equal(boot(), pnum);
+	zassert_equal(blocks_validated(), pnum);
+	zassert_is_null(index.predictions[pnum]);
+	zassert_equal(npgps_get_saved_index()->block[pnum], NO_INDEX_BLOCK);
+}
+
+ZTEST(nrf_cloud_pgps, test_load_index_other_set)
+{
+	zassert_equal(boot(), NUM_PREDICTIONS);
+
+	/* A new set starts one period later; the index is for the previous one. */
+	start_sec += TEST_PERIOD_SEC;
+	header_set(NUM_PREDICTIONS);
+	predictions_write(NUM_PREDICTIONS);
+	cache_pgps_header(&header);
+	zassert_equal(load_indexed_predictions(&bad_day, &bad_time), -ENOENT);
+
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	zassert_equal(blocks_validated(), NUM_PREDICTIONS);
+	index_check(NUM_PREDICTIONS);
+}
+
+ZTEST(nrf_cloud_pgps, test_load_size_mismatch)
+{
+	int count = NUM_PREDICTIONS - 2;
+
+	zassert_equal(boot(), NUM_PREDICTIONS);
+
+	/* A smaller set does not match the index of the full one. */
+	header_set(count);
+	predictions_write(count);
+	cache_pgps_header(&header);
+	zassert_equal(load_indexed_predictions(&bad_day, &bad_time), -ENOENT);
+
+	zassert_equal(boot(), count);
+	zassert_equal(blocks_validated(), count);
+	index_check(count);
+
+	/* The index of the smaller set is then used. */
+	zassert_equal(boot(), count);
+	zassert_equal(blocks_validated(), 0);
+	index_check(count);
+}
+
+ZTEST(nrf_cloud_pgps, test_header_mismatch)
+{
+	header.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION + 1;
+	zassert_false(validate_pgps_header(&header));
+
+	header_set(NUM_PREDICTIONS);
+	header.num_items = 2;
+	zassert_false(validate_pgps_header(&header));
+
+	header_set(NUM_PREDICTIONS);
+	header.prediction_period_min = PREDICTION_PERIOD / 2;
+	zassert_false(validate_pgps_header(&header));
+
+	header_set(NUM_PREDICTIONS + 2);
+	zassert_false(validate_pgps_header(&header));
+
+	header_set(0);
+	zassert_false(validate_pgps_header(&header));
+
+	header_set(NUM_PREDICTIONS);
+	zassert_true(validate_pgps_header(&header));
+}
+
+ZTEST(nrf_cloud_pgps, test_invalid_indexed_prediction)
+{
+	struct nrf_cloud_pgps_prediction *prediction;
+	int pnum = current_pnum();
+	int block = prediction_block(pnum);
+
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	zassert_equal(boot(), NUM_PREDICTIONS);
+	zassert_equal(blocks_validated(), 0);
+
+	/* The prediction is corrupted, but not its sentinel. */
+	block_prediction(block)->ephemeris_count = 0;
+
+	state = PGPS_REQUESTING;
+	loading_in_progress = true;
+	zassert_equal(nrf_cloud_pgps_find_prediction(&prediction), -ENODATA);
+	zassert_is_null(prediction);
+	zassert_is_null(index.predictions[pnum]);
+	zassert_false(block_validated[block]);
+
+	/* The index is dropped and the prediction must be requested again. */
+	zassert_equal(npgps_get_saved_index()->count, 0);
+	zassert_equal(index.cur_pnum, 0xff);
+	zassert_equal(state, PGPS_EXPIRED);
+	zassert_false(loading_in_progress);
+	zassert_false(nrf_cloud_pgps_loading());
+
+	/* At next boot, the storage is scanned up to the bad prediction. */
+	zassert_equal(boot(), pnum);
+	zassert_equal(blocks_validated(), pnum);
+	zassert_equal(npgps_get_saved_index()->count, NUM_PREDICTIONS);
+	zassert_equal(npgps_get_saved_index()->block[pnum], NO_INDEX_BLOCK);
+}
+
+ZTEST_SUITE(nrf_cloud_pgps, NULL, setup, before, after, NULL);
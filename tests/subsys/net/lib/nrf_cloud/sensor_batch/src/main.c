@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+#include <zcbor_decode.h>
+#include <cJSON.h>
+#include <net/nrf_cloud_codec.h>
+
+#include "msg_encode.h"
+#include "coap_codec.h"
+
+#define APP_ID "TEMP"
+#define TS_BASE 1767225600000LL
+#define LARGE_COUNT 300
+
+static uint8_t buf[12288];
+
+/* Stand-in for coap_codec.c, which pulls in the location and A-GNSS codecs.
+ * Same CBOR encoding of a double value as encode_message() there.
+ */
+int coap_codec_message_encode(struct nrf_cloud_obj_coap_cbor *msg, uint8_t *out, size_t *len,
+			      enum coap_content_format fmt)
+{
+	struct message_out input = {0};
+	size_t out_len;
+
+	zassert_equal(fmt, COAP_CONTENT_FORMAT_APP_CBOR);
+	zassert_equal(msg->type, NRF_CLOUD_DATA_TYPE_DOUBLE);
+
+	input.message_out_appId.value = msg->app_id;
+	input.message_out_appId.len = strlen(msg->app_id);
+	input.message_out_data_choice = message_out_data_float_c;
+	input.message_out_data_float = msg->double_val;
+	input.message_out_ts.message_out_ts = msg->ts;
+	input.message_out_ts_present = true;
+
+	if (cbor_encode_message_out(out, *len, &input, &out_len)) {
+		*len = 0;
+		return -EINVAL;
+	}
+
+	*len = out_len;
+
+	return 0;
+}
+
+static double sample_value(size_t i)
+{
+	return 20.0 + i * 0.25;
+}
+
+static int64_t sample_ts(size_t i)
+{
+	return TS_BASE + i * 1000;
+}
+
+static size_t batch_fill(struct nrf_cloud_sensor_batch *batch, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		if (nrf_cloud_sensor_batch_add(batch, APP_ID, sample_value(i), sample_ts(i))) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Decode a CBOR batch and check that it holds the samples from batch_fill() */
+static void cbor_batch_check(const struct nrf_cloud_data *data, size_t count)
+{
+	ZCBOR_STATE_D(state, 2, data->ptr, data->len, 1, 0);
+	struct zcbor_string app_id;
+	double value;
+	uint64_t ts;
+
+	zassert_true(zcbor_list_start_decode(state));
+
+	for (size_t i = 0; i < count; i++) {
+		zassert_true(zcbor_map_start_decode(state), "sample %zu", i);
+
+		/* Keys of the device message, see msg_encode.c */
+		zassert_true(zcbor_uint32_expect(state, 1));
+		zassert_true(zcbor_tstr_decode(state, &app_id));
+		zassert_equal(app_id.len, strlen(APP_ID));
+		zassert_mem_equal(app_id.value, APP_ID, app_id.len);
+
+		zassert_true(zcbor_uint32_expect(state, 2));
+		zassert_true(zcbor_float64_decode(state, &value));
+		zassert_equal(value, sample_value(i));
+
+		zassert_true(zcbor_uint32_expect(state, 3));
+		zassert_true(zcbor_uint64_decode(state, &ts));
+		zassert_equal(ts, sample_ts(i));
+
+		zassert_true(zcbor_map_end_decode(state));
+	}
+
+	/* Fails if the array header holds another count */
+	zassert_true(zcbor_list_end_decode(state));
+	zassert_equal(state->payload, (const uint8_t *)data->ptr + data->len);
+}
+
+/* Parse a JSON batch and check that it holds the samples from batch_fill() */
+static void json_batch_check(const struct nrf_cloud_data *data, size_t count)
+{
+	cJSON *root;
+	cJSON *item;
+
+	zassert_equal(strlen(data->ptr) + 1, data->len);
+
+	root = cJSON_Parse(data->ptr);
+	zassert_not_null(root);
+	zassert_true(cJSON_IsArray(root));
+	zassert_equal(cJSON_GetArraySize(root), count);
+
+	for (size_t i = 0; i < count; i++) {
+		item = cJSON_GetArrayItem(root, i);
+
+		zassert_str_equal(cJSON_GetStringValue(cJSON_GetObjectItem(item, "appId")),
+				  APP_ID);
+		zassert_str_equal(cJSON_GetStringValue(cJSON_GetObjectItem(item, "messageType")),
+				  "DATA");
+		zassert_equal(cJSON_GetNumberValue(cJSON_GetObjectItem(item, "data")),
+			      sample_value(i));
+		zassert_equal(cJSON_GetNumberValue(cJSON_GetObjectItem(item, "ts")),
+			      (double)sample_ts(i));
+	}
+
+	cJSON_Delete(root);
+}
+
+static void *setup(void)
+{
+	cJSON_Init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_sensor_batch, NULL, setup, NULL, NULL, NULL);
+
+ZTEST(nrf_cloud_sensor_batch, test_init_einval)
+{
+	struct nrf_cloud_sensor_batch batch;
+
+	zassert_equal(nrf_cloud_sensor_batch_init(NULL, NRF_CLOUD_BATCH_FMT_JSON, buf,
+						  sizeof(buf)), -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_JSON, NULL,
+						  sizeof(buf)), -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_JSON, buf, 2),
+		      -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf, 3),
+		      -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR + 1, buf,
+						  sizeof(buf)), -EINVAL);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_add_einval)
+{
+	struct nrf_cloud_sensor_batch batch;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+
+	zassert_equal(nrf_cloud_sensor_batch_add(NULL, APP_ID, 1.0, TS_BASE), -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_add(&batch, NULL, 1.0, TS_BASE), -EINVAL);
+	zassert_equal(nrf_cloud_sensor_batch_add(&batch, APP_ID, 1.0, -1), -EINVAL);
+	zassert_equal(batch.count, 0);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_encode_empty)
+{
+	struct nrf_cloud_sensor_batch batch;
+	struct nrf_cloud_data data;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_JSON, buf,
+					       sizeof(buf)));
+	zassert_equal(nrf_cloud_sensor_batch_encode(&batch, &data), -ENODATA);
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+	zassert_equal(nrf_cloud_sensor_batch_encode(&batch, &data), -ENODATA);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_json_batch)
+{
+	struct nrf_cloud_sensor_batch batch;
+	struct nrf_cloud_data data;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_JSON, buf,
+					       sizeof(buf)));
+	zassert_equal(batch_fill(&batch, 3), 3);
+
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+	json_batch_check(&data, 3);
+
+	/* Samples can still be added after encoding */
+	zassert_equal(batch_fill(&batch, 1), 1);
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+	zassert_equal(batch.count, 4);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_cbor_batch)
+{
+	struct nrf_cloud_sensor_batch batch;
+	struct nrf_cloud_data data;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+	zassert_equal(batch_fill(&batch, 3), 3);
+
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+	zassert_equal(((const uint8_t *)data.ptr)[0], 0x83);
+	cbor_batch_check(&data, 3);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_cbor_batch_array_header)
+{
+	struct nrf_cloud_sensor_batch batch;
+	struct nrf_cloud_data data;
+	const uint8_t *hdr;
+
+	/* One byte count */
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+	zassert_equal(batch_fill(&batch, 30), 30);
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+
+	hdr = data.ptr;
+	zassert_equal(hdr[0], 0x98);
+	zassert_equal(hdr[1], 30);
+	cbor_batch_check(&data, 30);
+
+	/* Two byte count */
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+	zassert_equal(batch_fill(&batch, LARGE_COUNT), LARGE_COUNT);
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+
+	hdr = data.ptr;
+	zassert_equal(data.ptr, buf);
+	zassert_equal(hdr[0], 0x99);
+	zassert_equal((hdr[1] << 8) | hdr[2], LARGE_COUNT);
+	cbor_batch_check(&data, LARGE_COUNT);
+}
+
+static void batch_full_check(enum nrf_cloud_batch_fmt fmt, size_t size)
+{
+	struct nrf_cloud_sensor_batch batch;
+	struct nrf_cloud_data data;
+	size_t count;
+	size_t len;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, fmt, buf, size));
+
+	count = batch_fill(&batch, LARGE_COUNT);
+	zassert_true(count > 0 && count < LARGE_COUNT);
+	zassert_equal(batch.count, count);
+
+	/* A full batch is left unchanged */
+	len = batch.len;
+	zassert_equal(nrf_cloud_sensor_batch_add(&batch, APP_ID, sample_value(count),
+						 sample_ts(count)), -ENOMEM);
+	zassert_equal(batch.count, count);
+	zassert_equal(batch.len, len);
+
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+	zassert_true(data.len <= size);
+	if (fmt == NRF_CLOUD_BATCH_FMT_JSON) {
+		json_batch_check(&data, count);
+	} else {
+		cbor_batch_check(&data, count);
+	}
+
+	/* After sending, the batch is reset and takes samples again */
+	nrf_cloud_sensor_batch_reset(&batch);
+	zassert_equal(batch.count, 0);
+	zassert_equal(batch_fill(&batch, 1), 1);
+	zassert_ok(nrf_cloud_sensor_batch_encode(&batch, &data));
+	if (fmt == NRF_CLOUD_BATCH_FMT_JSON) {
+		json_batch_check(&data, 1);
+	} else {
+		cbor_batch_check(&data, 1);
+	}
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_json_batch_full)
+{
+	batch_full_check(NRF_CLOUD_BATCH_FMT_JSON, 256);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_cbor_batch_full)
+{
+	batch_full_check(NRF_CLOUD_BATCH_FMT_CBOR, 128);
+}
+
+ZTEST(nrf_cloud_sensor_batch, test_cbor_batch_count_overflow)
+{
+	struct nrf_cloud_sensor_batch batch;
+
+	zassert_ok(nrf_cloud_sensor_batch_init(&batch, NRF_CLOUD_BATCH_FMT_CBOR, buf,
+					       sizeof(buf)));
+
+	/* The array header holds at most a 16-bit count */
+	batch.count = UINT16_MAX;
+	zassert_equal(nrf_cloud_sensor_batch_add(&batch, APP_ID, 1.0, TS_BASE), -ENOMEM);
+	zassert_equal(batch.count, UINT16_MAX);
+	zassert_equal(batch.len, 3);
+}